@@ -0,0 +1,487 @@
+// ------------------------------------------------------------------------------------------------
+#include "Server.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// ------------------------------------------------------------------------------------------------
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <dlfcn.h>
+#endif
+
+// ------------------------------------------------------------------------------------------------
+using namespace SqHost;
+
+// ------------------------------------------------------------------------------------------------
+typedef unsigned int (*PluginInitFn)(PluginFuncs *, PluginCallbacks *, PluginInfo *);
+typedef std::chrono::steady_clock Clock;
+
+/* ------------------------------------------------------------------------------------------------
+ * Categories of measured callbacks.
+*/
+enum CallKind
+{
+    CK_FRAME = 0,
+    CK_PLAYER_UPDATE,
+    CK_VEHICLE_UPDATE,
+    CK_SCRIPT_DATA,
+    CK_MESSAGE,
+    CK_COMMAND,
+    CK_MAX
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Names of the measured callbacks.
+*/
+static const char * const g_CallNames[CK_MAX] = {
+    "OnServerFrame", "OnPlayerUpdate", "OnVehicleUpdate", "OnClientScriptData", "OnPlayerMessage", "OnPlayerCommand"
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Latency measured for a callback.
+*/
+struct CallStats
+{
+    uint64_t    mCalls{0}; // Number of calls.
+    uint64_t    mTotal{0}; // Time spent in calls (nanoseconds).
+    uint64_t    mMax{0}; // Longest call (nanoseconds).
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Packet generator. Emits callbacks at a rate per player (or per vehicle) per frame.
+*/
+struct Generator
+{
+    CallKind    mKind{CK_MAX}; // Callback that is emitted.
+    double      mRate{0.0}; // Calls per entity per frame.
+    double      mCredit{0.0}; // Fractional calls carried over to the next frame.
+    std::string mArg{}; // Message text, command text or payload size.
+    std::vector< uint8_t > mData{}; // Script data payload.
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Options given on the command line.
+*/
+struct Options
+{
+    const char *            mPlugin{nullptr}; // Path of the plug-in to load.
+    uint64_t                mFrames{1000}; // Number of frames to run.
+    double                  mRate{0.0}; // Frames per second. Zero runs as fast as possible.
+    int32_t                 mPlayers{0}; // Players that join before the first frame.
+    int32_t                 mVehicles{0}; // Vehicles created before the plug-in loads.
+    bool                    mQuiet{false}; // Whether plug-in log messages are discarded.
+    std::vector< Generator > mGenerators{}; // Packet generators.
+};
+
+// ------------------------------------------------------------------------------------------------
+static PluginFuncs      g_Funcs{};
+static PluginCallbacks  g_Clbk{};
+static CallStats        g_Stats[CK_MAX]{};
+
+/* ------------------------------------------------------------------------------------------------
+ * Invoke a callback, if the plug-in assigned one, and measure how long it took.
+*/
+template < typename F, typename... A > static void Measure(CallKind kind, F fn, A... args)
+{
+    if (fn == nullptr)
+    {
+        return;
+    }
+    const Clock::time_point start = Clock::now();
+    fn(args...);
+    const auto time = static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::nanoseconds >(
+        Clock::now() - start).count());
+    CallStats & s = g_Stats[kind];
+    ++s.mCalls;
+    s.mTotal += time;
+    s.mMax = std::max(s.mMax, time);
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Show how the program is used.
+*/
+static void Usage(const char * name)
+{
+    std::printf("Usage: %s <plugin> [options]\n"
+        "  -frames N          Number of frames to run (default 1000).\n"
+        "  -rate HZ           Frames per second. 0 runs unthrottled (default 0).\n"
+        "  -players N         Players that join before the first frame (max %d).\n"
+        "  -vehicles N        Vehicles that exist before the plug-in loads (max %d).\n"
+        "  -quiet             Discard log messages from the plug-in.\n"
+        "  -gen KIND:RATE[:ARG]\n"
+        "                     Emit callbacks at RATE per player (vehicle) per frame. KIND is one of:\n"
+        "                     update, vehicle, data:BYTES, message:TEXT, command:TEXT\n",
+        name, HOST_PLAYER_POOL, HOST_VEHICLE_POOL);
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Parse a generator specification.
+*/
+static bool ParseGenerator(const char * spec, Generator & gen)
+{
+    std::string str(spec);
+    const size_t a = str.find(':');
+    if (a == std::string::npos)
+    {
+        return false;
+    }
+    const size_t b = str.find(':', a + 1);
+    const std::string kind = str.substr(0, a);
+    gen.mRate = std::strtod(str.substr(a + 1, b == std::string::npos ? std::string::npos : b - a - 1).c_str(), nullptr);
+    gen.mArg = b == std::string::npos ? std::string() : str.substr(b + 1);
+    // Identify the callback
+    if (kind == "update") gen.mKind = CK_PLAYER_UPDATE;
+    else if (kind == "vehicle") gen.mKind = CK_VEHICLE_UPDATE;
+    else if (kind == "data") gen.mKind = CK_SCRIPT_DATA;
+    else if (kind == "message") gen.mKind = CK_MESSAGE;
+    else if (kind == "command") gen.mKind = CK_COMMAND;
+    else return false;
+    // Prepare a deterministic payload
+    if (gen.mKind == CK_SCRIPT_DATA)
+    {
+        gen.mData.resize(gen.mArg.empty() ? 64 : std::strtoul(gen.mArg.c_str(), nullptr, 10));
+        for (size_t i = 0; i < gen.mData.size(); ++i)
+        {
+            gen.mData[i] = static_cast< uint8_t >(i * 31u + 7u);
+        }
+    }
+    else if (gen.mArg.empty())
+    {
+        gen.mArg = gen.mKind == CK_COMMAND ? "ping" : "hello";
+    }
+    return std::isfinite(gen.mRate) && gen.mRate >= 0.0;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Parse the command line.
+*/
+static bool ParseOptions(int argc, char ** argv, Options & opt)
+{
+    if (argc < 2)
+    {
+        return false;
+    }
+    opt.mPlugin = argv[1];
+    for (int i = 2; i < argc; ++i)
+    {
+        const char * arg = argv[i];
+        const char * val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "-quiet") == 0)
+        {
+            opt.mQuiet = true;
+            continue;
+        }
+        else if (val == nullptr)
+        {
+            return false;
+        }
+        else if (std::strcmp(arg, "-frames") == 0)
+        {
+            opt.mFrames = std::strtoull(val, nullptr, 10);
+        }
+        else if (std::strcmp(arg, "-rate") == 0)
+        {
+            opt.mRate = std::max(std::strtod(val, nullptr), 0.0);
+        }
+        else if (std::strcmp(arg, "-players") == 0)
+        {
+            opt.mPlayers = std::min(std::max(std::atoi(val), 0), HOST_PLAYER_POOL);
+        }
+        else if (std::strcmp(arg, "-vehicles") == 0)
+        {
+            opt.mVehicles = std::min(std::max(std::atoi(val), 0), HOST_VEHICLE_POOL);
+        }
+        else if (std::strcmp(arg, "-gen") == 0)
+        {
+            Generator gen;
+            if (!ParseGenerator(val, gen))
+            {
+                std::fprintf(stderr, "Invalid generator: %s\n", val);
+                return false;
+            }
+            opt.mGenerators.push_back(std::move(gen));
+        }
+        else
+        {
+            return false;
+        }
+        ++i; // Skip the value
+    }
+    return true;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Load the plug-in and let it initialize. Returns false on failure.
+*/
+static bool LoadPlugin(const char * path)
+{
+#ifdef _WIN32
+    HMODULE lib = LoadLibraryA(path);
+    PluginInitFn init = lib ? reinterpret_cast< PluginInitFn >(GetProcAddress(lib, "VcmpPluginInit")) : nullptr;
+#else
+    void * lib = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (lib == nullptr)
+    {
+        std::fprintf(stderr, "%s\n", dlerror());
+        return false;
+    }
+    PluginInitFn init = reinterpret_cast< PluginInitFn >(dlsym(lib, "VcmpPluginInit"));
+#endif
+    if (init == nullptr)
+    {
+        std::fprintf(stderr, "Unable to find VcmpPluginInit in %s\n", path);
+        return false;
+    }
+    InstallFuncs(g_Funcs);
+    g_Clbk.structSize = sizeof(g_Clbk);
+    g_Server.mInfo.structSize = sizeof(g_Server.mInfo);
+    g_Server.mInfo.pluginId = 0;
+    g_Server.mInfo.apiMajorVersion = PLUGIN_API_MAJOR;
+    g_Server.mInfo.apiMinorVersion = PLUGIN_API_MINOR;
+    // The plug-in keeps the pointers, so they must stay alive for the whole run
+    if (init(&g_Funcs, &g_Clbk, &g_Server.mInfo) == 0)
+    {
+        std::fprintf(stderr, "The plug-in refused to initialize\n");
+        return false;
+    }
+    return true;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Connect and spawn a player.
+*/
+static void ConnectPlayer(int32_t id)
+{
+    PlayerState & p = g_Server.mPlayers[static_cast< size_t >(id)];
+    char name[64];
+    std::snprintf(name, sizeof(name), "Bot%d", id);
+    // The plug-in may refuse or rename the player
+    if (g_Clbk.OnIncomingConnection != nullptr &&
+        !g_Clbk.OnIncomingConnection(name, sizeof(name), g_Server.mPassword.c_str(), "127.0.0.1"))
+    {
+        return;
+    }
+    p = PlayerState{};
+    p.mConnected = true;
+    p.mName = name;
+    if (g_Clbk.OnPlayerConnect != nullptr)
+    {
+        g_Clbk.OnPlayerConnect(id);
+    }
+    // Was the player kicked while connecting?
+    if (p.mConnected && (g_Clbk.OnPlayerRequestSpawn == nullptr || g_Clbk.OnPlayerRequestSpawn(id)))
+    {
+        p.mSpawned = true;
+        if (g_Clbk.OnPlayerSpawn != nullptr)
+        {
+            g_Clbk.OnPlayerSpawn(id);
+        }
+    }
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Move a player along a deterministic path.
+*/
+static void MovePlayer(int32_t id, PlayerState & p, uint64_t frame)
+{
+    const float t = static_cast< float >(frame) * 0.05f + static_cast< float >(id);
+    p.mSpeed[0] = -std::sin(t);
+    p.mSpeed[1] = std::cos(t);
+    p.mSpeed[2] = 0.0f;
+    p.mPos[0] = std::cos(t) * (20.0f + static_cast< float >(id));
+    p.mPos[1] = std::sin(t) * (20.0f + static_cast< float >(id));
+    p.mPos[2] = 10.0f;
+    p.mHeading = t;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Number of calls a generator makes for one entity in this frame.
+*/
+static uint32_t Emit(Generator & gen)
+{
+    gen.mCredit += gen.mRate;
+    const double n = std::floor(gen.mCredit);
+    gen.mCredit -= n;
+    return static_cast< uint32_t >(n);
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Run the generators for the current frame.
+*/
+static void Generate(Options & opt, uint64_t frame)
+{
+    for (Generator & gen : opt.mGenerators)
+    {
+        if (gen.mKind == CK_VEHICLE_UPDATE)
+        {
+            for (int32_t id = 0; id < HOST_VEHICLE_POOL; ++id)
+            {
+                VehicleState & v = g_Server.mVehicles[static_cast< size_t >(id)];
+                if (!v.mExists)
+                {
+                    continue;
+                }
+                for (uint32_t n = Emit(gen); n > 0; --n)
+                {
+                    v.mPos[0] += 0.1f;
+                    Measure(CK_VEHICLE_UPDATE, g_Clbk.OnVehicleUpdate, id, vcmpVehicleUpdatePosition);
+                }
+            }
+            continue;
+        }
+        for (int32_t id = 0; id < HOST_PLAYER_POOL; ++id)
+        {
+            PlayerState & p = g_Server.mPlayers[static_cast< size_t >(id)];
+            for (uint32_t n = p.mConnected ? Emit(gen) : 0; n > 0 && p.mConnected; --n)
+            {
+                switch (gen.mKind)
+                {
+                    case CK_PLAYER_UPDATE:
+                        MovePlayer(id, p, frame);
+                        Measure(CK_PLAYER_UPDATE, g_Clbk.OnPlayerUpdate, id, vcmpPlayerUpdateNormal);
+                    break;
+                    case CK_SCRIPT_DATA:
+                        Measure(CK_SCRIPT_DATA, g_Clbk.OnClientScriptData, id,
+                                static_cast< const uint8_t * >(gen.mData.data()), gen.mData.size());
+                    break;
+                    case CK_MESSAGE:
+                        Measure(CK_MESSAGE, g_Clbk.OnPlayerMessage, id, gen.mArg.c_str());
+                    break;
+                    case CK_COMMAND:
+                        Measure(CK_COMMAND, g_Clbk.OnPlayerCommand, id, gen.mArg.c_str());
+                    break;
+                    default: break;
+                }
+            }
+        }
+    }
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Let the plug-in know about players that were kicked since the last frame.
+*/
+static void Reap(std::vector< bool > & known)
+{
+    for (int32_t id = 0; id < HOST_PLAYER_POOL; ++id)
+    {
+        const size_t i = static_cast< size_t >(id);
+        if (known[i] && !g_Server.mPlayers[i].mConnected)
+        {
+            known[i] = false;
+            // The player looks connected for the duration of the callback
+            g_Server.mPlayers[i].mConnected = true;
+            if (g_Clbk.OnPlayerDisconnect != nullptr)
+            {
+                g_Clbk.OnPlayerDisconnect(id, vcmpDisconnectReasonKick);
+            }
+            g_Server.mPlayers[i] = PlayerState{};
+        }
+    }
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Print the measurements.
+*/
+static void Report(uint64_t frames, double seconds)
+{
+    std::printf("\n%llu frames in %.3f s (%.1f frames/s)\n", static_cast< unsigned long long >(frames), seconds,
+                seconds > 0.0 ? static_cast< double >(frames) / seconds : 0.0);
+    std::printf("%-20s %12s %12s %12s %12s\n", "Callback", "Calls", "Total (ms)", "Avg (us)", "Max (us)");
+    for (int k = 0; k < CK_MAX; ++k)
+    {
+        const CallStats & s = g_Stats[k];
+        if (s.mCalls == 0)
+        {
+            continue;
+        }
+        std::printf("%-20s %12llu %12.3f %12.3f %12.3f\n", g_CallNames[k], static_cast< unsigned long long >(s.mCalls),
+                    static_cast< double >(s.mTotal) / 1e6, static_cast< double >(s.mTotal) / static_cast< double >(s.mCalls) / 1e3,
+                    static_cast< double >(s.mMax) / 1e3);
+    }
+    std::printf("Sent %llu messages, %llu script data packets (%llu bytes), logged %llu lines\n",
+                static_cast< unsigned long long >(g_Server.mStats.mMessages),
+                static_cast< unsigned long long >(g_Server.mStats.mScriptData),
+                static_cast< unsigned long long >(g_Server.mStats.mScriptBytes),
+                static_cast< unsigned long long >(g_Server.mStats.mLogs));
+}
+
+// ------------------------------------------------------------------------------------------------
+int main(int argc, char ** argv)
+{
+    Options opt;
+    if (!ParseOptions(argc, argv, opt))
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+    g_Server.mQuiet = opt.mQuiet;
+    // Vehicles that exist before the plug-in loads are imported by it
+    for (int32_t i = 0; i < opt.mVehicles; ++i)
+    {
+        SpawnVehicle(130 + (i % 106), 1, static_cast< float >(i % 32) * 5.0f, static_cast< float >(i / 32) * 5.0f, 10.0f);
+    }
+    if (!LoadPlugin(opt.mPlugin))
+    {
+        return 1;
+    }
+    if (g_Clbk.OnServerInitialise != nullptr && !g_Clbk.OnServerInitialise())
+    {
+        std::fprintf(stderr, "The plug-in failed to initialize the server\n");
+        return 1;
+    }
+    std::vector< bool > known(HOST_PLAYER_POOL, false);
+    for (int32_t id = 0; id < opt.mPlayers; ++id)
+    {
+        ConnectPlayer(id);
+        known[static_cast< size_t >(id)] = g_Server.mPlayers[static_cast< size_t >(id)].mConnected;
+    }
+    // Frame loop
+    const Clock::duration step = opt.mRate > 0.0 ?
+        std::chrono::duration_cast< Clock::duration >(std::chrono::duration< double >(1.0 / opt.mRate)) :
+        Clock::duration::zero();
+    const Clock::time_point begin = Clock::now();
+    Clock::time_point last = begin, next = begin;
+    uint64_t frame = 0;
+    for (; frame < opt.mFrames && !g_Server.mShutdown; ++frame)
+    {
+        Generate(opt, frame);
+        Reap(known);
+        const Clock::time_point now = Clock::now();
+        const float elapsed = std::chrono::duration< float >(now - last).count();
+        last = now;
+        Measure(CK_FRAME, g_Clbk.OnServerFrame, elapsed);
+        Reap(known);
+        // Throttle to the requested rate
+        if (step != Clock::duration::zero())
+        {
+            next += step;
+            std::this_thread::sleep_until(next);
+        }
+    }
+    const double seconds = std::chrono::duration< double >(Clock::now() - begin).count();
+    // Disconnect everyone and shut down
+    for (int32_t id = 0; id < HOST_PLAYER_POOL; ++id)
+    {
+        if (known[static_cast< size_t >(id)] && g_Clbk.OnPlayerDisconnect != nullptr)
+        {
+            g_Clbk.OnPlayerDisconnect(id, vcmpDisconnectReasonQuit);
+        }
+        g_Server.mPlayers[static_cast< size_t >(id)] = PlayerState{};
+    }
+    if (g_Clbk.OnServerShutdown != nullptr)
+    {
+        g_Clbk.OnServerShutdown();
+    }
+    Report(frame, seconds);
+    return 0;
+}
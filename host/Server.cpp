@@ -0,0 +1,1076 @@
+// ------------------------------------------------------------------------------------------------
+#include "Server.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <chrono>
+#include <cstdio>
+#include <cstdarg>
+#include <cstring>
+
+// ------------------------------------------------------------------------------------------------
+namespace SqHost {
+
+// ------------------------------------------------------------------------------------------------
+ServerState g_Server{};
+
+/* ------------------------------------------------------------------------------------------------
+ * Every function in the server table, in declaration order.
+*/
+#define SQHOST_FUNCS(X) \
+    X(GetServerVersion) X(GetServerSettings) X(ExportFunctions) X(GetNumberOfPlugins) \
+    X(GetPluginInfo) X(FindPlugin) X(GetPluginExports) X(SendPluginCommand) X(GetTime) \
+    X(LogMessage) X(GetLastError) X(SendClientScriptData) X(SendClientMessage) X(SendGameMessage) \
+    X(SetServerName) X(GetServerName) X(SetMaxPlayers) X(GetMaxPlayers) X(SetServerPassword) \
+    X(GetServerPassword) X(SetGameModeText) X(GetGameModeText) X(ShutdownServer) \
+    X(SetServerOption) X(GetServerOption) X(SetWorldBounds) X(GetWorldBounds) X(SetWastedSettings) \
+    X(GetWastedSettings) X(SetTimeRate) X(GetTimeRate) X(SetHour) X(GetHour) X(SetMinute) \
+    X(GetMinute) X(SetWeather) X(GetWeather) X(SetGravity) X(GetGravity) X(SetGameSpeed) \
+    X(GetGameSpeed) X(SetWaterLevel) X(GetWaterLevel) X(SetMaximumFlightAltitude) \
+    X(GetMaximumFlightAltitude) X(SetKillCommandDelay) X(GetKillCommandDelay) \
+    X(SetVehiclesForcedRespawnHeight) X(GetVehiclesForcedRespawnHeight) X(CreateExplosion) \
+    X(PlaySound) X(HideMapObject) X(ShowMapObject) X(ShowAllMapObjects) X(SetWeaponDataValue) \
+    X(GetWeaponDataValue) X(ResetWeaponDataValue) X(IsWeaponDataValueModified) X(ResetWeaponData) \
+    X(ResetAllWeaponData) X(GetKeyBindUnusedSlot) X(GetKeyBindData) X(RegisterKeyBind) \
+    X(RemoveKeyBind) X(RemoveAllKeyBinds) X(CreateCoordBlip) X(DestroyCoordBlip) \
+    X(GetCoordBlipInfo) X(AddRadioStream) X(RemoveRadioStream) X(AddPlayerClass) \
+    X(SetSpawnPlayerPosition) X(SetSpawnCameraPosition) X(SetSpawnCameraLookAt) X(IsPlayerAdmin) \
+    X(SetPlayerAdmin) X(GetPlayerIP) X(GetPlayerUID) X(GetPlayerUID2) X(KickPlayer) X(BanPlayer) \
+    X(BanIP) X(UnbanIP) X(IsIPBanned) X(GetPlayerIdFromName) X(IsPlayerConnected) \
+    X(IsPlayerStreamedForPlayer) X(GetPlayerKey) X(GetPlayerName) X(SetPlayerName) \
+    X(GetPlayerState) X(SetPlayerOption) X(GetPlayerOption) X(SetPlayerWorld) X(GetPlayerWorld) \
+    X(SetPlayerSecondaryWorld) X(GetPlayerSecondaryWorld) X(GetPlayerUniqueWorld) \
+    X(IsPlayerWorldCompatible) X(GetPlayerClass) X(SetPlayerTeam) X(GetPlayerTeam) \
+    X(SetPlayerSkin) X(GetPlayerSkin) X(SetPlayerColour) X(GetPlayerColour) X(IsPlayerSpawned) \
+    X(ForcePlayerSpawn) X(ForcePlayerSelect) X(ForceAllSelect) X(IsPlayerTyping) \
+    X(GivePlayerMoney) X(SetPlayerMoney) X(GetPlayerMoney) X(SetPlayerScore) X(GetPlayerScore) \
+    X(SetPlayerWantedLevel) X(GetPlayerWantedLevel) X(GetPlayerPing) X(GetPlayerFPS) \
+    X(SetPlayerHealth) X(GetPlayerHealth) X(SetPlayerArmour) X(GetPlayerArmour) \
+    X(SetPlayerImmunityFlags) X(GetPlayerImmunityFlags) X(SetPlayerPosition) X(GetPlayerPosition) \
+    X(SetPlayerSpeed) X(GetPlayerSpeed) X(AddPlayerSpeed) X(SetPlayerHeading) X(GetPlayerHeading) \
+    X(SetPlayerAlpha) X(GetPlayerAlpha) X(GetPlayerAimPosition) X(GetPlayerAimDirection) \
+    X(IsPlayerOnFire) X(IsPlayerCrouching) X(GetPlayerAction) X(GetPlayerGameKeys) \
+    X(PutPlayerInVehicle) X(RemovePlayerFromVehicle) X(GetPlayerInVehicleStatus) \
+    X(GetPlayerInVehicleSlot) X(GetPlayerVehicleId) X(GivePlayerWeapon) X(SetPlayerWeapon) \
+    X(GetPlayerWeapon) X(GetPlayerWeaponAmmo) X(SetPlayerWeaponSlot) X(GetPlayerWeaponSlot) \
+    X(GetPlayerWeaponAtSlot) X(GetPlayerAmmoAtSlot) X(RemovePlayerWeapon) X(RemoveAllWeapons) \
+    X(SetCameraPosition) X(RestoreCamera) X(IsCameraLocked) X(SetPlayerAnimation) \
+    X(GetPlayerStandingOnVehicle) X(GetPlayerStandingOnObject) X(IsPlayerAway) \
+    X(GetPlayerSpectateTarget) X(SetPlayerSpectateTarget) X(RedirectPlayerToServer) \
+    X(CheckEntityExists) X(CreateVehicle) X(DeleteVehicle) X(SetVehicleOption) X(GetVehicleOption) \
+    X(GetVehicleSyncSource) X(GetVehicleSyncType) X(IsVehicleStreamedForPlayer) X(SetVehicleWorld) \
+    X(GetVehicleWorld) X(GetVehicleModel) X(GetVehicleOccupant) X(RespawnVehicle) \
+    X(SetVehicleImmunityFlags) X(GetVehicleImmunityFlags) X(ExplodeVehicle) X(IsVehicleWrecked) \
+    X(SetVehiclePosition) X(GetVehiclePosition) X(SetVehicleRotation) X(SetVehicleRotationEuler) \
+    X(GetVehicleRotation) X(GetVehicleRotationEuler) X(SetVehicleSpeed) X(GetVehicleSpeed) \
+    X(SetVehicleTurnSpeed) X(GetVehicleTurnSpeed) X(SetVehicleSpawnPosition) \
+    X(GetVehicleSpawnPosition) X(SetVehicleSpawnRotation) X(SetVehicleSpawnRotationEuler) \
+    X(GetVehicleSpawnRotation) X(GetVehicleSpawnRotationEuler) X(SetVehicleIdleRespawnTimer) \
+    X(GetVehicleIdleRespawnTimer) X(SetVehicleHealth) X(GetVehicleHealth) X(SetVehicleColour) \
+    X(GetVehicleColour) X(SetVehiclePartStatus) X(GetVehiclePartStatus) X(SetVehicleTyreStatus) \
+    X(GetVehicleTyreStatus) X(SetVehicleDamageData) X(GetVehicleDamageData) X(SetVehicleRadio) \
+    X(GetVehicleRadio) X(GetVehicleTurretRotation) X(ResetAllVehicleHandlings) \
+    X(ExistsHandlingRule) X(SetHandlingRule) X(GetHandlingRule) X(ResetHandlingRule) \
+    X(ResetHandling) X(ExistsInstHandlingRule) X(SetInstHandlingRule) X(GetInstHandlingRule) \
+    X(ResetInstHandlingRule) X(ResetInstHandling) X(CreatePickup) X(DeletePickup) \
+    X(IsPickupStreamedForPlayer) X(SetPickupWorld) X(GetPickupWorld) X(SetPickupAlpha) \
+    X(GetPickupAlpha) X(SetPickupIsAutomatic) X(IsPickupAutomatic) X(SetPickupAutoTimer) \
+    X(GetPickupAutoTimer) X(RefreshPickup) X(SetPickupPosition) X(GetPickupPosition) \
+    X(GetPickupModel) X(GetPickupQuantity) X(CreateCheckPoint) X(DeleteCheckPoint) \
+    X(IsCheckPointStreamedForPlayer) X(IsCheckPointSphere) X(SetCheckPointWorld) \
+    X(GetCheckPointWorld) X(SetCheckPointColour) X(GetCheckPointColour) X(SetCheckPointPosition) \
+    X(GetCheckPointPosition) X(SetCheckPointRadius) X(GetCheckPointRadius) X(GetCheckPointOwner) \
+    X(CreateObject) X(DeleteObject) X(IsObjectStreamedForPlayer) X(GetObjectModel) \
+    X(SetObjectWorld) X(GetObjectWorld) X(SetObjectAlpha) X(GetObjectAlpha) X(MoveObjectTo) \
+    X(MoveObjectBy) X(SetObjectPosition) X(GetObjectPosition) X(RotateObjectTo) \
+    X(RotateObjectToEuler) X(RotateObjectBy) X(RotateObjectByEuler) X(GetObjectRotation) \
+    X(GetObjectRotationEuler) X(SetObjectShotReportEnabled) X(IsObjectShotReportEnabled) \
+    X(SetObjectTouchedReportEnabled) X(IsObjectTouchedReportEnabled) X(GetPlayerModuleList) \
+    X(SetPickupOption) X(GetPickupOption) X(SetFallTimer) X(GetFallTimer) X(SetVehicleLightsData) \
+    X(GetVehicleLightsData)
+#ifdef VCMP_SDK_2_1
+    #define SQHOST_FUNCS_21(X) \
+        X(KillPlayer) X(SetVehicle3DArrowForPlayer) X(GetVehicle3DArrowForPlayer) \
+        X(SetPlayer3DArrowForPlayer) X(GetPlayer3DArrowForPlayer) X(SetPlayerDrunkHandling) \
+        X(GetPlayerDrunkHandling) X(SetPlayerDrunkVisuals) X(GetPlayerDrunkVisuals) \
+        X(InterpolateCameraLookAt) X(GetNetworkStatistics)
+#else
+    #define SQHOST_FUNCS_21(X)
+#endif
+
+/* ------------------------------------------------------------------------------------------------
+ * Function that succeeds and returns zero, used for everything that isn't modeled.
+*/
+template < typename R, typename... A > static R StubFunc(A...)
+{
+    return R();
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Variadic function that succeeds and returns zero, used for everything that isn't modeled.
+*/
+template < typename R, typename... A > static R StubFuncV(A..., ...)
+{
+    return R();
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Assign the stub with the matching signature to a function pointer.
+*/
+template < typename R, typename... A > static void Stub(R (* & fn)(A...))
+{
+    fn = &StubFunc< R, A... >;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Assign the stub with the matching signature to a variadic function pointer.
+*/
+template < typename R, typename... A > static void Stub(R (* & fn)(A..., ...))
+{
+    fn = &StubFuncV< R, A... >;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Remember the result of a call and return it.
+*/
+static vcmpError Result(vcmpError e)
+{
+    g_Server.mLastError = e;
+    return e;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Copy a string into a buffer supplied by a plug-in.
+*/
+static vcmpError CopyStr(const std::string & str, char * buffer, size_t size)
+{
+    if (buffer == nullptr)
+    {
+        return Result(vcmpErrorNullArgument);
+    }
+    else if (str.size() >= size)
+    {
+        return Result(vcmpErrorBufferTooSmall);
+    }
+    std::memcpy(buffer, str.c_str(), str.size() + 1);
+    return Result(vcmpErrorNone);
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Retrieve an entity from a pool if it exists.
+*/
+template < typename T > static T * Find(std::vector< T > & pool, int32_t id)
+{
+    if (id < 0 || static_cast< size_t >(id) >= pool.size())
+    {
+        g_Server.mLastError = vcmpErrorNoSuchEntity;
+        return nullptr;
+    }
+    T & e = pool[static_cast< size_t >(id)];
+    g_Server.mLastError = e.mExists ? vcmpErrorNone : vcmpErrorNoSuchEntity;
+    return e.mExists ? &e : nullptr;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Retrieve a connected player.
+*/
+static PlayerState * FindPlayer(int32_t id)
+{
+    if (id < 0 || id >= HOST_PLAYER_POOL || !g_Server.mPlayers[static_cast< size_t >(id)].mConnected)
+    {
+        g_Server.mLastError = vcmpErrorNoSuchEntity;
+        return nullptr;
+    }
+    g_Server.mLastError = vcmpErrorNone;
+    return &g_Server.mPlayers[static_cast< size_t >(id)];
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Take the first free slot from a pool. Returns -1 if the pool is full.
+*/
+template < typename T > static int32_t Allocate(std::vector< T > & pool)
+{
+    for (size_t i = 0; i < pool.size(); ++i)
+    {
+        if (!pool[i].mExists)
+        {
+            pool[i] = T{};
+            pool[i].mExists = true;
+            g_Server.mLastError = vcmpErrorNone;
+            return static_cast< int32_t >(i);
+        }
+    }
+    g_Server.mLastError = vcmpErrorPoolExhausted;
+    return -1;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Release a slot from a pool.
+*/
+template < typename T > static vcmpError Release(std::vector< T > & pool, int32_t id)
+{
+    T * e = Find(pool, id);
+    if (e == nullptr)
+    {
+        return Result(vcmpErrorNoSuchEntity);
+    }
+    e->mExists = false;
+    return Result(vcmpErrorNone);
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Write a position to the output pointers supplied by a plug-in.
+*/
+static vcmpError ReadPos(const float * pos, float * x, float * y, float * z)
+{
+    if (pos == nullptr)
+    {
+        return Result(vcmpErrorNoSuchEntity);
+    }
+    if (x != nullptr) *x = pos[0];
+    if (y != nullptr) *y = pos[1];
+    if (z != nullptr) *z = pos[2];
+    return Result(vcmpErrorNone);
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Store a position received from a plug-in.
+*/
+static vcmpError WritePos(float * pos, float x, float y, float z)
+{
+    if (pos == nullptr)
+    {
+        return Result(vcmpErrorNoSuchEntity);
+    }
+    pos[0] = x;
+    pos[1] = y;
+    pos[2] = z;
+    return Result(vcmpErrorNone);
+}
+
+// ------------------------------------------------------------------------------------------------
+static uint32_t GetServerVersion()
+{
+    return 67000;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetServerSettings(ServerSettings * settings)
+{
+    if (settings == nullptr)
+    {
+        return Result(vcmpErrorNullArgument);
+    }
+    std::snprintf(settings->serverName, sizeof(settings->serverName), "%s", g_Server.mName.c_str());
+    settings->maxPlayers = g_Server.mMaxPlayers;
+    settings->port = g_Server.mPort;
+    settings->flags = 0;
+    return Result(vcmpErrorNone);
+}
+
+// ------------------------------------------------------------------------------------------------
+static uint32_t GetNumberOfPlugins()
+{
+    return 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetPluginInfo(int32_t plugin_id, PluginInfo * info)
+{
+    if (plugin_id != 0)
+    {
+        return Result(vcmpErrorNoSuchEntity);
+    }
+    else if (info == nullptr)
+    {
+        return Result(vcmpErrorNullArgument);
+    }
+    *info = g_Server.mInfo;
+    return Result(vcmpErrorNone);
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t FindPlugin(const char * name)
+{
+    return (name != nullptr && std::strcmp(name, g_Server.mInfo.name) == 0) ? 0 : -1;
+}
+
+// ------------------------------------------------------------------------------------------------
+static const void ** GetPluginExports(int32_t /*plugin_id*/, size_t * count)
+{
+    if (count != nullptr)
+    {
+        *count = 0;
+    }
+    return nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+static uint64_t GetTime()
+{
+    using namespace std::chrono;
+    return static_cast< uint64_t >(duration_cast< microseconds >(steady_clock::now().time_since_epoch()).count());
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError LogMessage(const char * format, ...)
+{
+    ++g_Server.mStats.mLogs;
+    // Are log messages shown?
+    if (!g_Server.mQuiet)
+    {
+        va_list args;
+        va_start(args, format);
+        std::vfprintf(stdout, format, args);
+        va_end(args);
+        std::fputc('\n', stdout);
+    }
+    return Result(vcmpErrorNone);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetLastError()
+{
+    return g_Server.mLastError;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SendClientScriptData(int32_t player_id, const void * /*data*/, size_t size)
+{
+    if (FindPlayer(player_id) == nullptr)
+    {
+        return Result(vcmpErrorNoSuchEntity);
+    }
+    ++g_Server.mStats.mScriptData;
+    g_Server.mStats.mScriptBytes += size;
+    return Result(vcmpErrorNone);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SendClientMessage(int32_t /*player_id*/, uint32_t /*colour*/, const char * /*format*/, ...)
+{
+    ++g_Server.mStats.mMessages;
+    return Result(vcmpErrorNone);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SendGameMessage(int32_t /*player_id*/, int32_t /*type*/, const char * /*format*/, ...)
+{
+    ++g_Server.mStats.mMessages;
+    return Result(vcmpErrorNone);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetServerName(const char * text)
+{
+    g_Server.mName = text != nullptr ? text : "";
+    return Result(vcmpErrorNone);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetServerName(char * buffer, size_t size)
+{
+    return CopyStr(g_Server.mName, buffer, size);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetMaxPlayers(uint32_t max_players)
+{
+    if (max_players < 1 || max_players > static_cast< uint32_t >(HOST_PLAYER_POOL))
+    {
+        return Result(vcmpErrorArgumentOutOfBounds);
+    }
+    g_Server.mMaxPlayers = max_players;
+    return Result(vcmpErrorNone);
+}
+
+// ------------------------------------------------------------------------------------------------
+static uint32_t GetMaxPlayers()
+{
+    return g_Server.mMaxPlayers;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetServerPassword(const char * password)
+{
+    g_Server.mPassword = password != nullptr ? password : "";
+    return Result(vcmpErrorNone);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetServerPassword(char * buffer, size_t size)
+{
+    return CopyStr(g_Server.mPassword, buffer, size);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetGameModeText(const char * text)
+{
+    g_Server.mGameMode = text != nullptr ? text : "";
+    return Result(vcmpErrorNone);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetGameModeText(char * buffer, size_t size)
+{
+    return CopyStr(g_Server.mGameMode, buffer, size);
+}
+
+// ------------------------------------------------------------------------------------------------
+static void ShutdownServer()
+{
+    g_Server.mShutdown = true;
+}
+
+// ------------------------------------------------------------------------------------------------
+static uint8_t IsPlayerConnected(int32_t player_id)
+{
+    return static_cast< uint8_t >(FindPlayer(player_id) != nullptr);
+}
+
+// ------------------------------------------------------------------------------------------------
+static uint8_t IsPlayerSpawned(int32_t player_id)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return static_cast< uint8_t >(p != nullptr && p->mSpawned);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetPlayerName(int32_t player_id, char * buffer, size_t size)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? Result(vcmpErrorNoSuchEntity) : CopyStr(p->mName, buffer, size);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetPlayerIP(int32_t player_id, char * buffer, size_t size)
+{
+    return FindPlayer(player_id) == nullptr ? Result(vcmpErrorNoSuchEntity) : CopyStr("127.0.0.1", buffer, size);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetPlayerUID(int32_t player_id, char * buffer, size_t size)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? Result(vcmpErrorNoSuchEntity) : CopyStr("UID-" + p->mName, buffer, size);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError KickPlayer(int32_t player_id)
+{
+    PlayerState * p = FindPlayer(player_id);
+    if (p == nullptr)
+    {
+        return Result(vcmpErrorNoSuchEntity);
+    }
+    // The driver notices and reports the disconnection
+    p->mConnected = false;
+    return Result(vcmpErrorNone);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpPlayerState GetPlayerState(int32_t player_id)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p != nullptr && p->mSpawned ? vcmpPlayerStateNormal : vcmpPlayerStateNone;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetPlayerWorld(int32_t player_id, int32_t world)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? Result(vcmpErrorNoSuchEntity) : (p->mWorld = world, Result(vcmpErrorNone));
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t GetPlayerWorld(int32_t player_id)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? 0 : p->mWorld;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetPlayerTeam(int32_t player_id, int32_t team)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? Result(vcmpErrorNoSuchEntity) : (p->mTeam = team, Result(vcmpErrorNone));
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t GetPlayerTeam(int32_t player_id)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? 0 : p->mTeam;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetPlayerSkin(int32_t player_id, int32_t skin)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? Result(vcmpErrorNoSuchEntity) : (p->mSkin = skin, Result(vcmpErrorNone));
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t GetPlayerSkin(int32_t player_id)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? 0 : p->mSkin;
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t GetPlayerScore(int32_t player_id)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? 0 : p->mScore;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetPlayerHealth(int32_t player_id, float health)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? Result(vcmpErrorNoSuchEntity) : (p->mHealth = health, Result(vcmpErrorNone));
+}
+
+// ------------------------------------------------------------------------------------------------
+static float GetPlayerHealth(int32_t player_id)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? 0.0f : p->mHealth;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetPlayerArmour(int32_t player_id, float armour)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? Result(vcmpErrorNoSuchEntity) : (p->mArmour = armour, Result(vcmpErrorNone));
+}
+
+// ------------------------------------------------------------------------------------------------
+static float GetPlayerArmour(int32_t player_id)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? 0.0f : p->mArmour;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetPlayerPosition(int32_t player_id, float x, float y, float z)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return WritePos(p == nullptr ? nullptr : p->mPos, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetPlayerPosition(int32_t player_id, float * x, float * y, float * z)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return ReadPos(p == nullptr ? nullptr : p->mPos, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetPlayerSpeed(int32_t player_id, float x, float y, float z)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return WritePos(p == nullptr ? nullptr : p->mSpeed, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetPlayerSpeed(int32_t player_id, float * x, float * y, float * z)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return ReadPos(p == nullptr ? nullptr : p->mSpeed, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetPlayerHeading(int32_t player_id, float angle)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? Result(vcmpErrorNoSuchEntity) : (p->mHeading = angle, Result(vcmpErrorNone));
+}
+
+// ------------------------------------------------------------------------------------------------
+static float GetPlayerHeading(int32_t player_id)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? 0.0f : p->mHeading;
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t GetPlayerWeapon(int32_t player_id)
+{
+    PlayerState * p = FindPlayer(player_id);
+    return p == nullptr ? 0 : p->mWeapon;
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t GetPlayerVehicleId(int32_t /*player_id*/)
+{
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+static uint8_t CheckEntityExists(vcmpEntityPool pool, int32_t id)
+{
+    switch (pool)
+    {
+        case vcmpEntityPoolVehicle: return static_cast< uint8_t >(Find(g_Server.mVehicles, id) != nullptr);
+        case vcmpEntityPoolObject: return static_cast< uint8_t >(Find(g_Server.mObjects, id) != nullptr);
+        case vcmpEntityPoolPickup: return static_cast< uint8_t >(Find(g_Server.mPickups, id) != nullptr);
+        case vcmpEntityPoolCheckPoint: return static_cast< uint8_t >(Find(g_Server.mCheckpoints, id) != nullptr);
+        case vcmpEntityPoolBlip: return static_cast< uint8_t >(Find(g_Server.mBlips, id) != nullptr);
+        default: return 0;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+int32_t SpawnVehicle(int32_t model, int32_t world, float x, float y, float z)
+{
+    const int32_t id = Allocate(g_Server.mVehicles);
+    if (id >= 0)
+    {
+        VehicleState & v = g_Server.mVehicles[static_cast< size_t >(id)];
+        v.mModel = model;
+        v.mWorld = world;
+        WritePos(v.mPos, x, y, z);
+    }
+    return id;
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t CreateVehicle(int32_t model, int32_t world, float x, float y, float z, float /*angle*/,
+                             int32_t primary, int32_t secondary)
+{
+    const int32_t id = SpawnVehicle(model, world, x, y, z);
+    if (id >= 0)
+    {
+        g_Server.mVehicles[static_cast< size_t >(id)].mColour[0] = primary;
+        g_Server.mVehicles[static_cast< size_t >(id)].mColour[1] = secondary;
+    }
+    return id;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError DeleteVehicle(int32_t vehicle_id)
+{
+    return Release(g_Server.mVehicles, vehicle_id);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetVehicleWorld(int32_t vehicle_id, int32_t world)
+{
+    VehicleState * v = Find(g_Server.mVehicles, vehicle_id);
+    return v == nullptr ? Result(vcmpErrorNoSuchEntity) : (v->mWorld = world, Result(vcmpErrorNone));
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t GetVehicleWorld(int32_t vehicle_id)
+{
+    VehicleState * v = Find(g_Server.mVehicles, vehicle_id);
+    return v == nullptr ? 0 : v->mWorld;
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t GetVehicleModel(int32_t vehicle_id)
+{
+    VehicleState * v = Find(g_Server.mVehicles, vehicle_id);
+    return v == nullptr ? 0 : v->mModel;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetVehiclePosition(int32_t vehicle_id, float x, float y, float z, uint8_t /*remove*/)
+{
+    VehicleState * v = Find(g_Server.mVehicles, vehicle_id);
+    return WritePos(v == nullptr ? nullptr : v->mPos, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetVehiclePosition(int32_t vehicle_id, float * x, float * y, float * z)
+{
+    VehicleState * v = Find(g_Server.mVehicles, vehicle_id);
+    return ReadPos(v == nullptr ? nullptr : v->mPos, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetVehicleRotation(int32_t vehicle_id, float x, float y, float z, float w)
+{
+    VehicleState * v = Find(g_Server.mVehicles, vehicle_id);
+    if (v == nullptr)
+    {
+        return Result(vcmpErrorNoSuchEntity);
+    }
+    v->mRot[0] = x;
+    v->mRot[1] = y;
+    v->mRot[2] = z;
+    v->mRot[3] = w;
+    return Result(vcmpErrorNone);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetVehicleRotation(int32_t vehicle_id, float * x, float * y, float * z, float * w)
+{
+    VehicleState * v = Find(g_Server.mVehicles, vehicle_id);
+    if (v == nullptr)
+    {
+        return Result(vcmpErrorNoSuchEntity);
+    }
+    if (w != nullptr) *w = v->mRot[3];
+    return ReadPos(v->mRot, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetVehicleRotationEuler(int32_t vehicle_id, float x, float y, float z)
+{
+    VehicleState * v = Find(g_Server.mVehicles, vehicle_id);
+    return WritePos(v == nullptr ? nullptr : v->mEuler, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetVehicleRotationEuler(int32_t vehicle_id, float * x, float * y, float * z)
+{
+    VehicleState * v = Find(g_Server.mVehicles, vehicle_id);
+    return ReadPos(v == nullptr ? nullptr : v->mEuler, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetVehicleSpeed(int32_t vehicle_id, float x, float y, float z, uint8_t add, uint8_t /*relative*/)
+{
+    VehicleState * v = Find(g_Server.mVehicles, vehicle_id);
+    if (v == nullptr)
+    {
+        return Result(vcmpErrorNoSuchEntity);
+    }
+    // Relative speed is not modeled and shares the absolute speed
+    return add ? WritePos(v->mSpeed, v->mSpeed[0] + x, v->mSpeed[1] + y, v->mSpeed[2] + z) : WritePos(v->mSpeed, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetVehicleSpeed(int32_t vehicle_id, float * x, float * y, float * z, uint8_t /*relative*/)
+{
+    VehicleState * v = Find(g_Server.mVehicles, vehicle_id);
+    return ReadPos(v == nullptr ? nullptr : v->mSpeed, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetVehicleHealth(int32_t vehicle_id, float health)
+{
+    VehicleState * v = Find(g_Server.mVehicles, vehicle_id);
+    return v == nullptr ? Result(vcmpErrorNoSuchEntity) : (v->mHealth = health, Result(vcmpErrorNone));
+}
+
+// ------------------------------------------------------------------------------------------------
+static float GetVehicleHealth(int32_t vehicle_id)
+{
+    VehicleState * v = Find(g_Server.mVehicles, vehicle_id);
+    return v == nullptr ? 0.0f : v->mHealth;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetVehicleColour(int32_t vehicle_id, int32_t primary, int32_t secondary)
+{
+    VehicleState * v = Find(g_Server.mVehicles, vehicle_id);
+    if (v == nullptr)
+    {
+        return Result(vcmpErrorNoSuchEntity);
+    }
+    v->mColour[0] = primary;
+    v->mColour[1] = secondary;
+    return Result(vcmpErrorNone);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetVehicleColour(int32_t vehicle_id, int32_t * primary, int32_t * secondary)
+{
+    VehicleState * v = Find(g_Server.mVehicles, vehicle_id);
+    if (v == nullptr)
+    {
+        return Result(vcmpErrorNoSuchEntity);
+    }
+    if (primary != nullptr) *primary = v->mColour[0];
+    if (secondary != nullptr) *secondary = v->mColour[1];
+    return Result(vcmpErrorNone);
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t CreateObject(int32_t model, int32_t world, float x, float y, float z, int32_t /*alpha*/)
+{
+    const int32_t id = Allocate(g_Server.mObjects);
+    if (id >= 0)
+    {
+        ThingState & o = g_Server.mObjects[static_cast< size_t >(id)];
+        o.mModel = model;
+        o.mWorld = world;
+        WritePos(o.mPos, x, y, z);
+    }
+    return id;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError DeleteObject(int32_t object_id)
+{
+    return Release(g_Server.mObjects, object_id);
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t GetObjectModel(int32_t object_id)
+{
+    ThingState * o = Find(g_Server.mObjects, object_id);
+    return o == nullptr ? 0 : o->mModel;
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t GetObjectWorld(int32_t object_id)
+{
+    ThingState * o = Find(g_Server.mObjects, object_id);
+    return o == nullptr ? 0 : o->mWorld;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetObjectPosition(int32_t object_id, float x, float y, float z)
+{
+    ThingState * o = Find(g_Server.mObjects, object_id);
+    return WritePos(o == nullptr ? nullptr : o->mPos, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetObjectPosition(int32_t object_id, float * x, float * y, float * z)
+{
+    ThingState * o = Find(g_Server.mObjects, object_id);
+    return ReadPos(o == nullptr ? nullptr : o->mPos, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t CreatePickup(int32_t model, int32_t world, int32_t /*quantity*/, float x, float y, float z,
+                            int32_t /*alpha*/, uint8_t /*automatic*/)
+{
+    const int32_t id = Allocate(g_Server.mPickups);
+    if (id >= 0)
+    {
+        ThingState & p = g_Server.mPickups[static_cast< size_t >(id)];
+        p.mModel = model;
+        p.mWorld = world;
+        WritePos(p.mPos, x, y, z);
+    }
+    return id;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError DeletePickup(int32_t pickup_id)
+{
+    return Release(g_Server.mPickups, pickup_id);
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t GetPickupModel(int32_t pickup_id)
+{
+    ThingState * p = Find(g_Server.mPickups, pickup_id);
+    return p == nullptr ? 0 : p->mModel;
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t GetPickupWorld(int32_t pickup_id)
+{
+    ThingState * p = Find(g_Server.mPickups, pickup_id);
+    return p == nullptr ? 0 : p->mWorld;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetPickupPosition(int32_t pickup_id, float x, float y, float z)
+{
+    ThingState * p = Find(g_Server.mPickups, pickup_id);
+    return WritePos(p == nullptr ? nullptr : p->mPos, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetPickupPosition(int32_t pickup_id, float * x, float * y, float * z)
+{
+    ThingState * p = Find(g_Server.mPickups, pickup_id);
+    return ReadPos(p == nullptr ? nullptr : p->mPos, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t CreateCheckPoint(int32_t /*player_id*/, int32_t world, uint8_t /*sphere*/, float x, float y, float z,
+                                int32_t /*r*/, int32_t /*g*/, int32_t /*b*/, int32_t /*a*/, float /*radius*/)
+{
+    const int32_t id = Allocate(g_Server.mCheckpoints);
+    if (id >= 0)
+    {
+        ThingState & c = g_Server.mCheckpoints[static_cast< size_t >(id)];
+        c.mWorld = world;
+        WritePos(c.mPos, x, y, z);
+    }
+    return id;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError DeleteCheckPoint(int32_t checkpoint_id)
+{
+    return Release(g_Server.mCheckpoints, checkpoint_id);
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t GetCheckPointWorld(int32_t checkpoint_id)
+{
+    ThingState * c = Find(g_Server.mCheckpoints, checkpoint_id);
+    return c == nullptr ? 0 : c->mWorld;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError SetCheckPointPosition(int32_t checkpoint_id, float x, float y, float z)
+{
+    ThingState * c = Find(g_Server.mCheckpoints, checkpoint_id);
+    return WritePos(c == nullptr ? nullptr : c->mPos, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetCheckPointPosition(int32_t checkpoint_id, float * x, float * y, float * z)
+{
+    ThingState * c = Find(g_Server.mCheckpoints, checkpoint_id);
+    return ReadPos(c == nullptr ? nullptr : c->mPos, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+static int32_t CreateCoordBlip(int32_t index, int32_t world, float x, float y, float z,
+                               int32_t /*scale*/, uint32_t /*colour*/, int32_t sprite)
+{
+    // Use the requested slot, if any
+    if (index >= 0 && index < HOST_BLIP_POOL && !g_Server.mBlips[static_cast< size_t >(index)].mExists)
+    {
+        g_Server.mBlips[static_cast< size_t >(index)].mExists = true;
+    }
+    else
+    {
+        index = Allocate(g_Server.mBlips);
+    }
+    if (index >= 0)
+    {
+        ThingState & b = g_Server.mBlips[static_cast< size_t >(index)];
+        b.mModel = sprite;
+        b.mWorld = world;
+        WritePos(b.mPos, x, y, z);
+    }
+    return index;
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError DestroyCoordBlip(int32_t index)
+{
+    return Release(g_Server.mBlips, index);
+}
+
+// ------------------------------------------------------------------------------------------------
+static vcmpError GetCoordBlipInfo(int32_t index, int32_t * world, float * x, float * y, float * z,
+                                  int32_t * scale, uint32_t * colour, int32_t * sprite)
+{
+    ThingState * b = Find(g_Server.mBlips, index);
+    if (b == nullptr)
+    {
+        return Result(vcmpErrorNoSuchEntity);
+    }
+    if (world != nullptr) *world = b->mWorld;
+    if (scale != nullptr) *scale = 1;
+    if (colour != nullptr) *colour = 0;
+    if (sprite != nullptr) *sprite = b->mModel;
+    return ReadPos(b->mPos, x, y, z);
+}
+
+// ------------------------------------------------------------------------------------------------
+void InstallFuncs(PluginFuncs & funcs)
+{
+    std::memset(&funcs, 0, sizeof(funcs));
+    funcs.structSize = sizeof(funcs);
+    // Start with stubs for everything
+#define SQHOST_STUB(name) Stub(funcs.name);
+    SQHOST_FUNCS(SQHOST_STUB)
+    SQHOST_FUNCS_21(SQHOST_STUB)
+#undef SQHOST_STUB
+    // Then model what the plug-in needs to track entities
+#define SQHOST_FUNC(name) funcs.name = &name;
+    SQHOST_FUNC(GetServerVersion)
+    SQHOST_FUNC(GetServerSettings)
+    SQHOST_FUNC(GetNumberOfPlugins)
+    SQHOST_FUNC(GetPluginInfo)
+    SQHOST_FUNC(FindPlugin)
+    SQHOST_FUNC(GetPluginExports)
+    SQHOST_FUNC(GetTime)
+    SQHOST_FUNC(LogMessage)
+    SQHOST_FUNC(GetLastError)
+    SQHOST_FUNC(SendClientScriptData)
+    SQHOST_FUNC(SendClientMessage)
+    SQHOST_FUNC(SendGameMessage)
+    SQHOST_FUNC(SetServerName)
+    SQHOST_FUNC(GetServerName)
+    SQHOST_FUNC(SetMaxPlayers)
+    SQHOST_FUNC(GetMaxPlayers)
+    SQHOST_FUNC(SetServerPassword)
+    SQHOST_FUNC(GetServerPassword)
+    SQHOST_FUNC(SetGameModeText)
+    SQHOST_FUNC(GetGameModeText)
+    SQHOST_FUNC(ShutdownServer)
+    SQHOST_FUNC(IsPlayerConnected)
+    SQHOST_FUNC(IsPlayerSpawned)
+    SQHOST_FUNC(GetPlayerName)
+    SQHOST_FUNC(GetPlayerIP)
+    SQHOST_FUNC(GetPlayerUID)
+    funcs.GetPlayerUID2 = &GetPlayerUID;
+    SQHOST_FUNC(KickPlayer)
+    funcs.BanPlayer = &KickPlayer;
+    SQHOST_FUNC(GetPlayerState)
+    SQHOST_FUNC(SetPlayerWorld)
+    SQHOST_FUNC(GetPlayerWorld)
+    SQHOST_FUNC(SetPlayerTeam)
+    SQHOST_FUNC(GetPlayerTeam)
+    SQHOST_FUNC(SetPlayerSkin)
+    SQHOST_FUNC(GetPlayerSkin)
+    SQHOST_FUNC(GetPlayerScore)
+    SQHOST_FUNC(SetPlayerHealth)
+    SQHOST_FUNC(GetPlayerHealth)
+    SQHOST_FUNC(SetPlayerArmour)
+    SQHOST_FUNC(GetPlayerArmour)
+    SQHOST_FUNC(SetPlayerPosition)
+    SQHOST_FUNC(GetPlayerPosition)
+    SQHOST_FUNC(SetPlayerSpeed)
+    SQHOST_FUNC(GetPlayerSpeed)
+    SQHOST_FUNC(SetPlayerHeading)
+    SQHOST_FUNC(GetPlayerHeading)
+    SQHOST_FUNC(GetPlayerWeapon)
+    SQHOST_FUNC(GetPlayerVehicleId)
+    SQHOST_FUNC(CheckEntityExists)
+    SQHOST_FUNC(CreateVehicle)
+    SQHOST_FUNC(DeleteVehicle)
+    SQHOST_FUNC(SetVehicleWorld)
+    SQHOST_FUNC(GetVehicleWorld)
+    SQHOST_FUNC(GetVehicleModel)
+    SQHOST_FUNC(SetVehiclePosition)
+    SQHOST_FUNC(GetVehiclePosition)
+    SQHOST_FUNC(SetVehicleRotation)
+    SQHOST_FUNC(GetVehicleRotation)
+    SQHOST_FUNC(SetVehicleRotationEuler)
+    SQHOST_FUNC(GetVehicleRotationEuler)
+    SQHOST_FUNC(SetVehicleSpeed)
+    SQHOST_FUNC(GetVehicleSpeed)
+    SQHOST_FUNC(SetVehicleHealth)
+    SQHOST_FUNC(GetVehicleHealth)
+    SQHOST_FUNC(SetVehicleColour)
+    SQHOST_FUNC(GetVehicleColour)
+    SQHOST_FUNC(CreateObject)
+    SQHOST_FUNC(DeleteObject)
+    SQHOST_FUNC(GetObjectModel)
+    SQHOST_FUNC(GetObjectWorld)
+    SQHOST_FUNC(SetObjectPosition)
+    SQHOST_FUNC(GetObjectPosition)
+    SQHOST_FUNC(CreatePickup)
+    SQHOST_FUNC(DeletePickup)
+    SQHOST_FUNC(GetPickupModel)
+    SQHOST_FUNC(GetPickupWorld)
+    SQHOST_FUNC(SetPickupPosition)
+    SQHOST_FUNC(GetPickupPosition)
+    SQHOST_FUNC(CreateCheckPoint)
+    SQHOST_FUNC(DeleteCheckPoint)
+    SQHOST_FUNC(GetCheckPointWorld)
+    SQHOST_FUNC(SetCheckPointPosition)
+    SQHOST_FUNC(GetCheckPointPosition)
+    SQHOST_FUNC(CreateCoordBlip)
+    SQHOST_FUNC(DestroyCoordBlip)
+    SQHOST_FUNC(GetCoordBlipInfo)
+#undef SQHOST_FUNC
+}
+
+} // Namespace:: SqHost
@@ -0,0 +1,129 @@
+#pragma once
+
+// ------------------------------------------------------------------------------------------------
+#include "vcmp.h"
+
+// ------------------------------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// ------------------------------------------------------------------------------------------------
+namespace SqHost {
+
+/* ------------------------------------------------------------------------------------------------
+ * Size of the entity pools. Matches the limits the plug-in was built for.
+*/
+static constexpr int32_t HOST_PLAYER_POOL = 100;
+static constexpr int32_t HOST_VEHICLE_POOL = 1000;
+static constexpr int32_t HOST_OBJECT_POOL = 3000;
+static constexpr int32_t HOST_PICKUP_POOL = 2000;
+static constexpr int32_t HOST_CHECKPOINT_POOL = 2000;
+static constexpr int32_t HOST_BLIP_POOL = 128;
+
+/* ------------------------------------------------------------------------------------------------
+ * In-memory state of a connected player.
+*/
+struct PlayerState
+{
+    bool        mConnected{false}; // Whether the player is connected.
+    bool        mSpawned{false}; // Whether the player is spawned.
+    std::string mName{}; // Player name.
+    float       mPos[3]{0.0f, 0.0f, 0.0f}; // Position.
+    float       mSpeed[3]{0.0f, 0.0f, 0.0f}; // Speed.
+    float       mHeading{0.0f}; // Heading angle.
+    float       mHealth{100.0f}; // Health.
+    float       mArmour{0.0f}; // Armour.
+    int32_t     mWorld{1}; // World.
+    int32_t     mSkin{0}; // Skin.
+    int32_t     mTeam{0}; // Team.
+    int32_t     mWeapon{0}; // Held weapon.
+    int32_t     mScore{0}; // Score.
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * In-memory state of a vehicle.
+*/
+struct VehicleState
+{
+    bool        mExists{false}; // Whether the vehicle exists.
+    int32_t     mModel{0}; // Model identifier.
+    int32_t     mWorld{1}; // World.
+    float       mPos[3]{0.0f, 0.0f, 0.0f}; // Position.
+    float       mRot[4]{0.0f, 0.0f, 0.0f, 1.0f}; // Rotation quaternion.
+    float       mEuler[3]{0.0f, 0.0f, 0.0f}; // Rotation as Euler angles.
+    float       mSpeed[3]{0.0f, 0.0f, 0.0f}; // Speed.
+    float       mHealth{1000.0f}; // Health.
+    int32_t     mColour[2]{0, 0}; // Primary and secondary colour.
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * In-memory state of an object, pickup, checkpoint or blip.
+*/
+struct ThingState
+{
+    bool        mExists{false}; // Whether the entity exists.
+    int32_t     mModel{0}; // Model identifier, if any.
+    int32_t     mWorld{1}; // World.
+    float       mPos[3]{0.0f, 0.0f, 0.0f}; // Position.
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Measurements collected by the server.
+*/
+struct ServerStats
+{
+    uint64_t    mMessages{0}; // Messages sent to players.
+    uint64_t    mScriptData{0}; // Client script data packets sent to players.
+    uint64_t    mScriptBytes{0}; // Client script data bytes sent to players.
+    uint64_t    mLogs{0}; // Messages logged by plug-ins.
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Everything the fake server keeps in memory.
+*/
+struct ServerState
+{
+    std::string                 mName{"SqHost"}; // Server name.
+    std::string                 mPassword{}; // Server password.
+    std::string                 mGameMode{}; // Game mode text.
+    uint32_t                    mMaxPlayers{HOST_PLAYER_POOL}; // Maximum number of players.
+    uint32_t                    mPort{8192}; // Server port.
+    bool                        mQuiet{false}; // Whether plug-in log messages are discarded.
+    bool                        mShutdown{false}; // Whether a plug-in asked the server to shut down.
+    vcmpError                   mLastError{vcmpErrorNone}; // Result of the last call.
+    PluginInfo                  mInfo{}; // Information about the loaded plug-in.
+    ServerStats                 mStats{}; // Measurements.
+    std::vector< PlayerState >  mPlayers{}; // Player pool.
+    std::vector< VehicleState > mVehicles{}; // Vehicle pool.
+    std::vector< ThingState >   mObjects{}; // Object pool.
+    std::vector< ThingState >   mPickups{}; // Pickup pool.
+    std::vector< ThingState >   mCheckpoints{}; // Checkpoint pool.
+    std::vector< ThingState >   mBlips{}; // Blip pool.
+
+    /* --------------------------------------------------------------------------------------------
+     * Default constructor.
+    */
+    ServerState()
+        : mPlayers(HOST_PLAYER_POOL), mVehicles(HOST_VEHICLE_POOL), mObjects(HOST_OBJECT_POOL)
+        , mPickups(HOST_PICKUP_POOL), mCheckpoints(HOST_CHECKPOINT_POOL), mBlips(HOST_BLIP_POOL)
+    {
+    }
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * State of the fake server. Only accessed from the main thread.
+*/
+extern ServerState g_Server;
+
+/* ------------------------------------------------------------------------------------------------
+ * Fill the server function table. Functions that the stand-in doesn't model succeed and return zero.
+*/
+void InstallFuncs(PluginFuncs & funcs);
+
+/* ------------------------------------------------------------------------------------------------
+ * Create a vehicle directly in the server state. Returns the vehicle identifier or -1 if the pool is full.
+*/
+int32_t SpawnVehicle(int32_t model, int32_t world, float x, float y, float z);
+
+} // Namespace:: SqHost
@@ -0,0 +1,71 @@
+/* ------------------------------------------------------------------------------------------------
+ * Member access and method calls with constant keys, as gamemode scripts write them. These go
+ * through _OP_GETK and _OP_PREPCALLK and hit the inline caches when the receiver keeps its class.
+*/
+class BenchEntity
+{
+    mID = 0;
+    mHealth = 100.0;
+    mScore = 0;
+    mPos = null;
+
+    constructor(id)
+    {
+        mID = id;
+        mPos = Vector3(id.tofloat(), 0.0, 10.0);
+    }
+
+    function Damage(amount) { mHealth -= amount; if (mHealth < 0.0) mHealth = 100.0; }
+    function AddScore(n) { mScore += n; return mScore; }
+    function IsAlive() { return mHealth > 0.0; }
+}
+
+// A second class with the same member names keeps some call sites polymorphic
+class BenchVehicle extends BenchEntity
+{
+    function Damage(amount) { mHealth -= amount * 0.5; if (mHealth < 0.0) mHealth = 100.0; }
+}
+
+// ------------------------------------------------------------------------------------------------
+SqBench.Add("Member access and method calls", function() {
+    local players = [], mixed = [];
+    for (local i = 0; i < 100; ++i)
+    {
+        players.push(BenchEntity(i));
+        mixed.push(i % 2 ? BenchVehicle(i) : BenchEntity(i));
+    }
+    local rounds = 5000;
+    SqBench.Time("fields (monomorphic)", rounds * 100, function(n) {
+        for (local r = 0; r < rounds; ++r)
+        {
+            foreach (p in players) p.mScore = p.mID + p.mScore;
+        }
+    });
+    SqBench.Time("methods (monomorphic)", rounds * 100, function(n) {
+        for (local r = 0; r < rounds; ++r)
+        {
+            foreach (p in players) { p.Damage(1.0); if (p.IsAlive()) p.AddScore(1); }
+        }
+    });
+    SqBench.Time("methods (two classes)", rounds * 100, function(n) {
+        for (local r = 0; r < rounds; ++r)
+        {
+            foreach (p in mixed) { p.Damage(1.0); if (p.IsAlive()) p.AddScore(1); }
+        }
+    });
+    SqBench.Time("native members (Vector3 Dot and x)", rounds * 100, function(n) {
+        local dir = Vector3(0.0, 1.0, 0.0), sum = 0.0;
+        for (local r = 0; r < rounds; ++r)
+        {
+            foreach (p in players) sum += p.mPos.Dot(dir) + p.mPos.x;
+        }
+    });
+    // Adding a member changes the class shape, so the caches must miss once and refill
+    SqBench.Time("methods after class modification", rounds * 100, function(n) {
+        BenchEntity.Heal <- function() { mHealth = 100.0; };
+        for (local r = 0; r < rounds; ++r)
+        {
+            foreach (p in players) { p.Damage(1.0); p.Heal(); }
+        }
+    });
+});
@@ -0,0 +1,56 @@
+/* ------------------------------------------------------------------------------------------------
+ * Helpers shared by the benchmark scripts. Benchmarks are queued when the scripts load and run on
+ * the first server frame, once SqHost connected the players and created the vehicles.
+*/
+SqBench <- {
+    // Benchmarks waiting for the first frame
+    Pending = []
+
+    /* --------------------------------------------------------------------------------------------
+     * Queue a benchmark.
+    */
+    function Add(name, fn)
+    {
+        Pending.push([name, fn]);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Call fn(n) once and report the time it took per operation. Returns the time in microseconds.
+    */
+    function Time(label, n, fn)
+    {
+        local start = SqChrono.Current();
+        fn(n);
+        local us = SqChrono.Current() - start;
+        print(format("  %-44s %10.3f ms %10.3f us/op", label, us / 1000.0, us.tofloat() / n));
+        return us;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Report how many times faster the second measurement is than the first.
+    */
+    function Ratio(label, before, after)
+    {
+        print(format("  %-44s %10.2fx", label, after > 0 ? before.tofloat() / after : 0.0));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Deterministic pseudo-random generator so that every run measures the same inputs.
+    */
+    Seed = 12345
+    function Random(lo, hi)
+    {
+        Seed = (Seed * 1103515245 + 12345) & 0x7FFFFFFF;
+        return lo + (hi - lo) * (Seed.tofloat() / 0x7FFFFFFF);
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+SqCore.On().ServerFrame.Connect(function(elapsed) {
+    foreach (b in SqBench.Pending)
+    {
+        print("== " + b[0]);
+        b[1]();
+    }
+    SqBench.Pending.clear();
+});
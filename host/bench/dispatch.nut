@@ -0,0 +1,43 @@
+/* ------------------------------------------------------------------------------------------------
+ * Interpreter dispatch. The loops are dominated by integer constants feeding comparisons and
+ * jumps (the _OP_CMPI and _OP_JCMPI superinstructions) and by member calls. Build the plug-in with
+ * and without ENABLE_SQ_COMPUTED_GOTO to compare the dispatch modes. With ENABLE_SQ_OPCODE_PROFILE
+ * the most frequent opcode pairs of these loops are listed as well.
+*/
+SqBench.Add("Interpreter dispatch", function() {
+    if (SqCore.OpcodeProfiling()) SqCore.ResetOpcodeProfile();
+    local n = 5000000;
+    SqBench.Time("integer compare and jump loop", n, function(n) {
+        local hits = 0;
+        for (local i = 0; i < n; ++i)
+        {
+            local m = i % 16;
+            if (m < 4) ++hits;
+            else if (m == 7) hits += 2;
+            else if (m > 12) --hits;
+        }
+    });
+    SqBench.Time("arithmetic loop", n, function(n) {
+        local a = 1, b = 0.0;
+        for (local i = 0; i < n; ++i)
+        {
+            a = (a * 31 + i) & 0xFFFF;
+            b += a * 0.5;
+        }
+    });
+    local counter = { mValue = 0, function Step(v) { mValue += v; return mValue < 1000; } };
+    SqBench.Time("member call loop", n / 5, function(n) {
+        for (local i = 0; i < n; ++i)
+        {
+            if (!counter.Step(1)) counter.mValue = 0;
+        }
+    });
+    if (SqCore.OpcodeProfiling())
+    {
+        print("  Most frequent opcode pairs:");
+        foreach (p in SqCore.OpcodePairs(10))
+        {
+            print(format("  %16s -> %-16s %12d", p.From == null ? "(entry)" : p.From, p.To, p.Hits));
+        }
+    }
+});
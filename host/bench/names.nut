@@ -0,0 +1,45 @@
+/* ------------------------------------------------------------------------------------------------
+ * Weapon, vehicle and skin name lookups over every known name, and district lookups over random
+ * points on the map. Exact names hit the compile-time tables, abbreviations take the fallback.
+*/
+SqBench.Add("Name and district lookups", function() {
+    local weapons = [], vehicles = [], skins = [];
+    for (local id = 0; id < 256; ++id)
+    {
+        if (IsWeaponValid(id)) weapons.push(GetWeaponName(id));
+        if (IsAutomobileValid(id)) vehicles.push(GetAutomobileName(id));
+        if (IsSkinValid(id)) skins.push(GetSkinName(id));
+    }
+    // Repeat each set enough times to get a stable measurement
+    local rounds = 2000;
+    local lookup = function(label, names, fn) {
+        SqBench.Time(label, names.len() * rounds, function(n) {
+            for (local r = 0; r < rounds; ++r)
+            {
+                foreach (name in names) fn(name);
+            }
+        });
+    };
+    local abbreviate = function(names) {
+        local out = [];
+        foreach (name in names) out.push(name.len() > 4 ? name.slice(0, 4) : name);
+        return out;
+    };
+    lookup(format("GetWeaponID (%d names)", weapons.len()), weapons, GetWeaponID);
+    lookup(format("GetAutomobileID (%d names)", vehicles.len()), vehicles, GetAutomobileID);
+    lookup(format("GetSkinID (%d names)", skins.len()), skins, GetSkinID);
+    lookup("GetWeaponID (abbreviated)", abbreviate(weapons), GetWeaponID);
+    lookup("GetAutomobileID (abbreviated)", abbreviate(vehicles), GetAutomobileID);
+    lookup("GetSkinID (abbreviated)", abbreviate(skins), GetSkinID);
+    // Points are spread a little past the map so that some miss every district
+    local points = 200000, xs = array(points), ys = array(points);
+    for (local i = 0; i < points; ++i)
+    {
+        xs[i] = SqBench.Random(-2500.0, 2500.0);
+        ys[i] = SqBench.Random(-2500.0, 2500.0);
+    }
+    SqBench.Time("SqServer.GetDistrictNameEx (random points)", points, function(n) {
+        local find = SqServer.GetDistrictNameEx;
+        for (local i = 0; i < n; ++i) find(xs[i], ys[i]);
+    });
+});
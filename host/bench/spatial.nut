@@ -0,0 +1,60 @@
+/* ------------------------------------------------------------------------------------------------
+ * Spatial queries against the script loops they replace. SqHost places the players on circles
+ * around the origin and the vehicles on a grid, so the query centers are spread over that area.
+*/
+SqBench.Add("Spatial queries", function() {
+    local queries = 2000, radius = 50.0, centers = array(queries);
+    for (local i = 0; i < queries; ++i)
+    {
+        centers[i] = Vector3(SqBench.Random(-150.0, 150.0), SqBench.Random(-150.0, 150.0), 10.0);
+    }
+    // The loop scripts write without an index
+    local script_in_radius = function(entities, pos, r) {
+        local out = [];
+        foreach (e in entities)
+        {
+            if (e.Pos.DistanceTo(pos) <= r) out.push(e);
+        }
+        return out;
+    };
+    local script_nearest = function(entities, pos, k) {
+        local all = [];
+        foreach (e in entities) all.push([e.Pos.DistanceTo(pos), e]);
+        all.sort(@(a, b) a[0] <=> b[0]);
+        return all.slice(0, all.len() < k ? all.len() : k);
+    };
+    foreach (name in ["Player", "Vehicle"])
+    {
+        local index = SqSpatial[name], collect = SqCollect[name].Active;
+        print(format("  %d %s entities, %d queries", collect().len(), name, queries));
+        local a = SqBench.Time(name + " script InRadius", queries, function(n) {
+            for (local i = 0; i < n; ++i) script_in_radius(collect(), centers[i], radius);
+        });
+        local b = SqBench.Time(name + " SqSpatial InRadius", queries, function(n) {
+            for (local i = 0; i < n; ++i) index.InRadius(centers[i], radius);
+        });
+        SqBench.Ratio(name + " InRadius speedup", a, b);
+        SqBench.Time(name + " SqSpatial CountInRadius", queries, function(n) {
+            for (local i = 0; i < n; ++i) index.CountInRadius(centers[i], radius);
+        });
+        SqBench.Time(name + " SqSpatial ForeachInRadius", queries, function(n) {
+            local visit = function(e) { };
+            for (local i = 0; i < n; ++i) index.ForeachInRadius(centers[i], radius, visit);
+        });
+        a = SqBench.Time(name + " script Nearest(5)", queries, function(n) {
+            for (local i = 0; i < n; ++i) script_nearest(collect(), centers[i], 5);
+        });
+        b = SqBench.Time(name + " SqSpatial Nearest(5)", queries, function(n) {
+            for (local i = 0; i < n; ++i) index.Nearest(centers[i], 5);
+        });
+        SqBench.Ratio(name + " Nearest speedup", a, b);
+        // Worst case where every query pays for a rebuild of the index
+        SqBench.Time(name + " SqSpatial InRadius with rebuild", queries, function(n) {
+            for (local i = 0; i < n; ++i)
+            {
+                SqSpatial.Invalidate();
+                index.InRadius(centers[i], radius);
+            }
+        });
+    }
+});
@@ -0,0 +1,34 @@
+/* ------------------------------------------------------------------------------------------------
+ * String table churn. Every string created by a script or pushed by native code is interned, so
+ * these loops mostly measure hashing and probing in the string table.
+*/
+SqBench.Add("String interning", function() {
+    SqBench.Time("short string concatenation", 2000000, function(n) {
+        local s = "";
+        for (local i = 0; i < n; ++i) s = "p" + (i & 1023);
+    });
+    SqBench.Time("native formatted strings", 1000000, function(n) {
+        for (local i = 0; i < n; ++i) format("player_%d", i & 4095);
+    });
+    // Long keys that differ only at the end used to collide when hashing skipped characters
+    local prefix = "gamemode.player.statistics.session.counter.";
+    local keys = 20000, tbl = {};
+    SqBench.Time("long keys with numeric suffix (insert)", keys, function(n) {
+        for (local i = 0; i < n; ++i) tbl[prefix + i] <- i;
+    });
+    SqBench.Time("long keys with numeric suffix (lookup)", keys * 10, function(n) {
+        local sum = 0;
+        for (local r = 0; r < 10; ++r)
+        {
+            for (local i = 0; i < keys; ++i) sum += tbl[prefix + i];
+        }
+    });
+    SqBench.Time("string split and join", 200000, function(n) {
+        for (local i = 0; i < n; ++i)
+        {
+            local parts = split("kick " + (i & 255) + " spamming the chat", " ");
+            local s = parts[0];
+            for (local p = 1; p < parts.len(); ++p) s += "," + parts[p];
+        }
+    });
+});
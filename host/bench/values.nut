@@ -0,0 +1,41 @@
+/* ------------------------------------------------------------------------------------------------
+ * Allocation churn of the small value types. Arithmetic on them returns new instances, which the
+ * pooled allocator serves from released blocks. The counters show how many allocations were reused.
+*/
+SqBench.Add("Value type allocations", function() {
+    local stats = function() {
+        local out = {};
+        foreach (s in SqCore.AllocatorStats())
+        {
+            if (s.Name != null) out[s.Name] <- s; // Types that were never created have no name yet
+        }
+        return out;
+    };
+    local n = 1000000;
+    // Drop the cached blocks so the first run starts from an empty pool
+    SqCore.TrimAllocators();
+    local before = stats();
+    SqBench.Time("Vector3 arithmetic (empty pool)", n, function(n) {
+        local a = Vector3(1.0, 2.0, 3.0), b = Vector3(0.5, 0.5, 0.5);
+        for (local i = 0; i < n; ++i) a = (a + b) * 0.5;
+    });
+    SqBench.Time("Vector3 arithmetic (warm pool)", n, function(n) {
+        local a = Vector3(1.0, 2.0, 3.0), b = Vector3(0.5, 0.5, 0.5);
+        for (local i = 0; i < n; ++i) a = (a + b) * 0.5;
+    });
+    SqBench.Time("Color3 and Quaternion construction", n, function(n) {
+        for (local i = 0; i < n; ++i)
+        {
+            local c = Color3(i & 255, 128, 64), q = Quaternion(0.0, 0.0, 0.0, 1.0);
+        }
+    });
+    local after = stats();
+    print(format("  %-16s %12s %12s %12s %8s %8s", "Type", "Allocated", "Reused", "Released", "Live", "Cached"));
+    foreach (name, s in after)
+    {
+        local b = name in before ? before[name] : { Allocated = 0, Reused = 0, Released = 0 };
+        if (s.Allocated == b.Allocated && s.Reused == b.Reused) continue;
+        print(format("  %-16s %12d %12d %12d %8d %8d", name, s.Allocated - b.Allocated, s.Reused - b.Reused,
+                     s.Released - b.Released, s.Live, s.Cached));
+    }
+});
@@ -0,0 +1,52 @@
+/* ------------------------------------------------------------------------------------------------
+ * Native SqVector kernels against the per element script callbacks they replace.
+*/
+SqBench.Add("Vector kernels", function() {
+    local size = 1000000, fv = SqUtils.FloatVec(), iv = SqUtils.IntVec();
+    fv.Reserve(size);
+    iv.Reserve(size);
+    for (local i = 0; i < size; ++i)
+    {
+        fv.Push(SqBench.Random(0.0, 1000.0));
+        iv.Push(SqBench.Random(0.0, 1000000.0).tointeger());
+    }
+    print(format("  %d float and integer elements", size));
+    // Reductions
+    local a = SqBench.Time("script Sum (Each)", size, function(n) {
+        local s = 0.0;
+        fv.Each(function(v) { s += v; });
+    });
+    local b = SqBench.Time("native Sum", size, function(n) { fv.Sum; });
+    SqBench.Ratio("Sum speedup", a, b);
+    a = SqBench.Time("script Min/Max (Each)", size, function(n) {
+        local lo = fv.Front, hi = fv.Front;
+        fv.Each(function(v) { if (v < lo) lo = v; if (v > hi) hi = v; });
+    });
+    b = SqBench.Time("native Min/Max", size, function(n) { fv.Min; fv.Max; });
+    SqBench.Ratio("Min/Max speedup", a, b);
+    a = SqBench.Time("script Histogram(10)", size, function(n) {
+        local h = array(10, 0);
+        fv.Each(function(v) { h[(v / 100.0).tointeger() < 10 ? (v / 100.0).tointeger() : 9] += 1; });
+    });
+    b = SqBench.Time("native Histogram(10)", size, function(n) { fv.Histogram(SqUtils.IntVec(), 0.0, 1000.0, 10); });
+    SqBench.Ratio("Histogram speedup", a, b);
+    // Element-wise arithmetic
+    a = SqBench.Time("script MulScalar (Get/Set)", size, function(n) {
+        for (local i = 0; i < n; ++i) fv.Set(i, fv.Get(i) * 1.5);
+    });
+    b = SqBench.Time("native MulScalar", size, function(n) { fv.MulScalar(1.5); });
+    SqBench.Ratio("MulScalar speedup", a, b);
+    local other = fv.Slice(0, size);
+    a = SqBench.Time("script AddVec (Get/Set)", size, function(n) {
+        for (local i = 0; i < n; ++i) fv.Set(i, fv.Get(i) + other.Get(i));
+    });
+    b = SqBench.Time("native AddVec", size, function(n) { fv.AddVec(other); });
+    SqBench.Ratio("AddVec speedup", a, b);
+    // Selection and sorting
+    a = SqBench.Time("Sort then take 10", size, function(n) { iv.Slice(0, n).Sort(); });
+    b = SqBench.Time("TopK(10)", size, function(n) { iv.Slice(0, n).TopK(10); });
+    SqBench.Ratio("TopK speedup", a, b);
+    a = SqBench.Time("Sort", size, function(n) { iv.Slice(0, n).Sort(); });
+    b = SqBench.Time("ParallelSort (hardware threads)", size, function(n) { iv.Slice(0, n).ParallelSort(0); });
+    SqBench.Ratio("ParallelSort speedup", a, b);
+});
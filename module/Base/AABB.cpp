@@ -777,7 +777,7 @@ void Register_AABB(HSQUIRRELVM vm)
     typedef AABB::Value Val;
 
     RootTable(vm).Bind(Typename::Str,
-        Class< AABB >(vm, Typename::Str)
+        Class< AABB, PooledAllocator< AABB > >(vm, Typename::Str)
         // Constructors
         .Ctor()
         .Ctor< const AABB & >()
@@ -829,6 +829,15 @@ void Register_AABB(HSQUIRRELVM vm)
         .Func(_SC("MergeAABBEx"), &AABB::MergeAABBEx)
         .Func(_SC("MergeSphere"), &AABB::MergeSphere)
         .Func(_SC("MergeSphereEx"), &AABB::MergeSphereEx)
+        .Func(_SC("AddAssign"), &AABB::AddAssign)
+        .Func(_SC("SubAssign"), &AABB::SubAssign)
+        .Func(_SC("MulAssign"), &AABB::MulAssign)
+        .Func(_SC("DivAssign"), &AABB::DivAssign)
+        .Func(_SC("AddScalarAssign"), &AABB::AddScalarAssign)
+        .Func(_SC("SubScalarAssign"), &AABB::SubScalarAssign)
+        .Func(_SC("MulScalarAssign"), &AABB::MulScalarAssign)
+        .Func(_SC("DivScalarAssign"), &AABB::DivScalarAssign)
+        .Func(_SC("TranslateAssign"), &AABB::TranslateAssign)
         .Func(_SC("IsVector3Inside"), &AABB::IsVector3Inside)
         .Func(_SC("IsVector3InsideEx"), &AABB::IsVector3InsideEx)
         .Func(_SC("IsAABBInside"), &AABB::IsAABBInside)
@@ -384,6 +384,79 @@ struct AABB
     */
     void MergeSphereEx(Value x, Value y, Value z, Value r);
 
+    /* --------------------------------------------------------------------------------------------
+     * Add another bounding box in place.
+    */
+    void AddAssign(const AABB & o)
+    {
+        *this += o;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Subtract another bounding box in place.
+    */
+    void SubAssign(const AABB & o)
+    {
+        *this -= o;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Multiply by another bounding box in place.
+    */
+    void MulAssign(const AABB & o)
+    {
+        *this *= o;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Divide by another bounding box in place.
+    */
+    void DivAssign(const AABB & o)
+    {
+        *this /= o;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Add a scalar value to each component in place.
+    */
+    void AddScalarAssign(Value s)
+    {
+        *this += s;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Subtract a scalar value from each component in place.
+    */
+    void SubScalarAssign(Value s)
+    {
+        *this -= s;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Multiply by a scalar value in place.
+    */
+    void MulScalarAssign(Value s)
+    {
+        *this *= s;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Divide by a scalar value in place.
+    */
+    void DivScalarAssign(Value s)
+    {
+        *this /= s;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Move the bounding box by the specified offset in place.
+    */
+    void TranslateAssign(const Vector3 & v)
+    {
+        min += v;
+        max += v;
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Check if the box is empty. This means that there is no space between the min and max edge.
     */
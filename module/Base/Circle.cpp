@@ -537,7 +537,7 @@ void Register_Circle(HSQUIRRELVM vm)
     typedef Circle::Value Val;
 
     RootTable(vm).Bind(Typename::Str,
-        Class< Circle >(vm, Typename::Str)
+        Class< Circle, PooledAllocator< Circle > >(vm, Typename::Str)
         // Constructors
         .Ctor()
         .Ctor< Val >()
@@ -724,7 +724,7 @@ void Register_Color3(HSQUIRRELVM vm)
     typedef Color3::Value Val;
 
     RootTable(vm).Bind(Typename::Str,
-        Class< Color3 >(vm, Typename::Str)
+        Class< Color3, PooledAllocator< Color3 > >(vm, Typename::Str)
         // Constructors
         .Ctor()
         .Ctor< Val >()
@@ -710,6 +710,22 @@ Quaternion Quaternion::NlerpEx(const Quaternion & quat, Value t, bool shortest_p
     return result;
 }
 
+// ------------------------------------------------------------------------------------------------
+void Quaternion::RotateInto(Vector3 & out, const Vector3 & v) const
+{
+    // t = 2 * cross(q.xyz, v)
+    const Value tx = STOVAL(2.0) * (y * v.z - z * v.y);
+    const Value ty = STOVAL(2.0) * (z * v.x - x * v.z);
+    const Value tz = STOVAL(2.0) * (x * v.y - y * v.x);
+    // v' = v + w * t + cross(q.xyz, t)
+    const Value rx = v.x + w * tx + (y * tz - z * ty);
+    const Value ry = v.y + w * ty + (z * tx - x * tz);
+    const Value rz = v.z + w * tz + (x * ty - y * tx);
+    out.x = rx;
+    out.y = ry;
+    out.z = rz;
+}
+
 // ------------------------------------------------------------------------------------------------
 const Quaternion & Quaternion::Get(StackStrF & str)
 {
@@ -756,7 +772,7 @@ void Register_Quaternion(HSQUIRRELVM vm)
     typedef Quaternion::Value Val;
 
     RootTable(vm).Bind(Typename::Str,
-        Class< Quaternion >(vm, Typename::Str)
+        Class< Quaternion, PooledAllocator< Quaternion > >(vm, Typename::Str)
         // Constructors
         .Ctor()
         .Ctor< Val >()
@@ -810,6 +826,17 @@ void Register_Quaternion(HSQUIRRELVM vm)
         .Func(_SC("Slerp"), &Quaternion::Slerp)
         .Func(_SC("Nlerp"), &Quaternion::Nlerp)
         .Func(_SC("NlerpEx"), &Quaternion::NlerpEx)
+        .Func(_SC("AddAssign"), &Quaternion::AddAssign)
+        .Func(_SC("SubAssign"), &Quaternion::SubAssign)
+        .Func(_SC("MulAssign"), &Quaternion::MulAssign)
+        .Func(_SC("DivAssign"), &Quaternion::DivAssign)
+        .Func(_SC("AddScalarAssign"), &Quaternion::AddScalarAssign)
+        .Func(_SC("SubScalarAssign"), &Quaternion::SubScalarAssign)
+        .Func(_SC("MulScalarAssign"), &Quaternion::MulScalarAssign)
+        .Func(_SC("DivScalarAssign"), &Quaternion::DivScalarAssign)
+        .Func(_SC("NlerpInto"), &Quaternion::NlerpInto)
+        .Func(_SC("SlerpInto"), &Quaternion::SlerpInto)
+        .Func(_SC("RotateInto"), &Quaternion::RotateInto)
         // Member Overloads
         .Overload(_SC("Generate"), &Quaternion::Generate)
         .Overload(_SC("Generate"), &Quaternion::GenerateB)
@@ -439,6 +439,91 @@ struct Quaternion
     */
     SQMOD_NODISCARD Quaternion NlerpEx(const Quaternion & quat, Value t, bool shortest_path) const;
 
+    /* --------------------------------------------------------------------------------------------
+     * Add another quaternion in place.
+    */
+    void AddAssign(const Quaternion & o)
+    {
+        *this += o;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Subtract another quaternion in place.
+    */
+    void SubAssign(const Quaternion & o)
+    {
+        *this -= o;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Multiply by another quaternion in place.
+    */
+    void MulAssign(const Quaternion & o)
+    {
+        *this *= o;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Divide by another quaternion in place.
+    */
+    void DivAssign(const Quaternion & o)
+    {
+        *this /= o;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Add a scalar value to each component in place.
+    */
+    void AddScalarAssign(Value s)
+    {
+        *this += s;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Subtract a scalar value from each component in place.
+    */
+    void SubScalarAssign(Value s)
+    {
+        *this -= s;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Multiply by a scalar value in place.
+    */
+    void MulScalarAssign(Value s)
+    {
+        *this *= s;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Divide by a scalar value in place.
+    */
+    void DivScalarAssign(Value s)
+    {
+        *this /= s;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Store the normalized linear interpolation with another quaternion into an existing quaternion.
+    */
+    void NlerpInto(Quaternion & out, const Quaternion & quat, Value t) const
+    {
+        out = Nlerp(quat, t);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Store the spherical interpolation with another quaternion into an existing quaternion.
+    */
+    void SlerpInto(Quaternion & out, const Quaternion & quat, Value t) const
+    {
+        out = Slerp(quat, t);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Rotate a vector by this quaternion and store the result into an existing vector.
+    */
+    void RotateInto(Vector3 & out, const Vector3 & v) const;
+
     /* --------------------------------------------------------------------------------------------
      * Generate a formatted string with the values from this instance.
     */
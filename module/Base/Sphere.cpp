@@ -512,7 +512,7 @@ void Register_Sphere(HSQUIRRELVM vm)
     typedef Sphere::Value Val;
 
     RootTable(vm).Bind(Typename::Str,
-        Class< Sphere >(vm, Typename::Str)
+        Class< Sphere, PooledAllocator< Sphere > >(vm, Typename::Str)
         // Constructors
         .Ctor()
         .Ctor< Val >()
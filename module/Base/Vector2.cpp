@@ -414,7 +414,7 @@ void Register_Vector2(HSQUIRRELVM vm)
     typedef Vector2::Value Val;
 
     RootTable(vm).Bind(Typename::Str,
-        Class< Vector2 >(vm, Typename::Str)
+        Class< Vector2, PooledAllocator< Vector2 > >(vm, Typename::Str)
         // Constructors
         .Ctor()
         .Ctor< Val >()
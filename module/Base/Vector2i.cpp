@@ -560,7 +560,7 @@ void Register_Vector2i(HSQUIRRELVM vm)
     typedef Vector2i::Value Val;
 
     RootTable(vm).Bind(Typename::Str,
-        Class< Vector2i >(vm, Typename::Str)
+        Class< Vector2i, PooledAllocator< Vector2i > >(vm, Typename::Str)
         // Constructors
         .Ctor()
         .Ctor< Val >()
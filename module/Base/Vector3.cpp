@@ -669,7 +669,7 @@ void Register_Vector3(HSQUIRRELVM vm)
     typedef Vector3::Value Val;
 
     RootTable(vm).Bind(Typename::Str,
-        Class< Vector3 >(vm, Typename::Str)
+        Class< Vector3, PooledAllocator< Vector3 > >(vm, Typename::Str)
         // Constructors
         .Ctor()
         .Ctor< Val >()
@@ -737,6 +737,18 @@ void Register_Vector3(HSQUIRRELVM vm)
         .Func(_SC("CenterRotateXYBy"), &Vector3::CenterRotateXYBy)
         .Func(_SC("RotateYZBy"), &Vector3::RotateYZBy)
         .Func(_SC("CenterRotateYZBy"), &Vector3::CenterRotateYZBy)
+        .Func(_SC("AddAssign"), &Vector3::AddAssign)
+        .Func(_SC("SubAssign"), &Vector3::SubAssign)
+        .Func(_SC("MulAssign"), &Vector3::MulAssign)
+        .Func(_SC("DivAssign"), &Vector3::DivAssign)
+        .Func(_SC("AddScalarAssign"), &Vector3::AddScalarAssign)
+        .Func(_SC("SubScalarAssign"), &Vector3::SubScalarAssign)
+        .Func(_SC("MulScalarAssign"), &Vector3::MulScalarAssign)
+        .Func(_SC("DivScalarAssign"), &Vector3::DivScalarAssign)
+        .Func(_SC("AddScaledAssign"), &Vector3::AddScaledAssign)
+        .Func(_SC("NegateAssign"), &Vector3::NegateAssign)
+        .Func(_SC("LerpInto"), &Vector3::LerpInto)
+        .Func(_SC("CrossInto"), &Vector3::CrossInto)
         // Member Overloads
         .Overload(_SC("Generate"), &Vector3::Generate)
         .Overload(_SC("Generate"), &Vector3::GenerateB)
@@ -445,6 +445,111 @@ struct Vector3
     */
     SQMOD_NODISCARD Vector3 Interpolated(const Vector3 & vec, Value d) const;
 
+    /* --------------------------------------------------------------------------------------------
+     * Add another vector in place.
+    */
+    void AddAssign(const Vector3 & o)
+    {
+        *this += o;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Subtract another vector in place.
+    */
+    void SubAssign(const Vector3 & o)
+    {
+        *this -= o;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Multiply by another vector in place.
+    */
+    void MulAssign(const Vector3 & o)
+    {
+        *this *= o;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Divide by another vector in place.
+    */
+    void DivAssign(const Vector3 & o)
+    {
+        *this /= o;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Add a scalar value to each component in place.
+    */
+    void AddScalarAssign(Value s)
+    {
+        *this += s;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Subtract a scalar value from each component in place.
+    */
+    void SubScalarAssign(Value s)
+    {
+        *this -= s;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Multiply by a scalar value in place.
+    */
+    void MulScalarAssign(Value s)
+    {
+        *this *= s;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Divide by a scalar value in place.
+    */
+    void DivScalarAssign(Value s)
+    {
+        *this /= s;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Add another vector scaled by a scalar value in place.
+    */
+    void AddScaledAssign(const Vector3 & v, Value s)
+    {
+        x += v.x * s;
+        y += v.y * s;
+        z += v.z * s;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Negate each component in place.
+    */
+    void NegateAssign()
+    {
+        x = -x;
+        y = -y;
+        z = -z;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Store the linear interpolation between this vector and another vector into an existing vector.
+    */
+    void LerpInto(Vector3 & out, const Vector3 & v, Value d) const
+    {
+        out.x = x + (v.x - x) * d;
+        out.y = y + (v.y - y) * d;
+        out.z = z + (v.z - z) * d;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Store the cross product between this vector and another vector into an existing vector.
+    */
+    void CrossInto(Vector3 & out, const Vector3 & v) const
+    {
+        const Value cx = y * v.z - z * v.y, cy = z * v.x - x * v.z, cz = x * v.y - y * v.x;
+        out.x = cx;
+        out.y = cy;
+        out.z = cz;
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Rotates the vector by a specified number of degrees around the Y axis and the specified center.
     */
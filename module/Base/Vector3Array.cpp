@@ -0,0 +1,279 @@
+// ------------------------------------------------------------------------------------------------
+#include "Base/Vector3Array.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <cmath>
+#include <limits>
+
+// ------------------------------------------------------------------------------------------------
+namespace SqMod {
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_DECL_TYPENAME(Typename, _SC("Vector3Array"))
+
+// ------------------------------------------------------------------------------------------------
+void Vector3Array::Reserve(SQInteger n)
+{
+    const auto c = static_cast< size_t >(ClampMin(n, SQInteger(0)));
+    mX.reserve(c);
+    mY.reserve(c);
+    mZ.reserve(c);
+    mR.reserve(c);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Vector3Array::Resize(SQInteger n)
+{
+    const auto c = static_cast< size_t >(ClampMin(n, SQInteger(0)));
+    mX.resize(c, 0);
+    mY.resize(c, 0);
+    mZ.resize(c, 0);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Vector3Array::Clear()
+{
+    mX.clear();
+    mY.clear();
+    mZ.clear();
+    mR.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+void Vector3Array::PushEx(Value x, Value y, Value z)
+{
+    mX.push_back(x);
+    mY.push_back(y);
+    mZ.push_back(z);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Vector3Array::Remove(SQInteger i)
+{
+    const size_t n = Valid(i);
+    // Keep the results lined up with the vectors. Results from before a resize are stale anyway
+    if (mR.size() == mX.size())
+    {
+        mR[n] = mR.back();
+        mR.pop_back();
+    }
+    else
+    {
+        mR.clear();
+    }
+    // Move the last vector in place of the removed one
+    mX[n] = mX.back();
+    mY[n] = mY.back();
+    mZ[n] = mZ.back();
+    mX.pop_back();
+    mY.pop_back();
+    mZ.pop_back();
+}
+
+// ------------------------------------------------------------------------------------------------
+void Vector3Array::Distance(const Vector3 & p)
+{
+    DistanceSq(p);
+    // Take the square root of each result
+    Value * r = mR.data();
+    for (size_t i = 0, n = mR.size(); i < n; ++i)
+    {
+        r[i] = std::sqrt(r[i]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void Vector3Array::DistanceSq(const Vector3 & p)
+{
+    const size_t n = mX.size();
+    mR.resize(n);
+    // Plain loops over separate lanes so the compiler can vectorize them
+    const Value * x = mX.data(), * y = mY.data(), * z = mZ.data();
+    Value * r = mR.data();
+    for (size_t i = 0; i < n; ++i)
+    {
+        const Value dx = x[i] - p.x, dy = y[i] - p.y, dz = z[i] - p.z;
+        r[i] = dx * dx + dy * dy + dz * dz;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void Vector3Array::Dot(const Vector3 & v)
+{
+    const size_t n = mX.size();
+    mR.resize(n);
+    const Value * x = mX.data(), * y = mY.data(), * z = mZ.data();
+    Value * r = mR.data();
+    for (size_t i = 0; i < n; ++i)
+    {
+        r[i] = x[i] * v.x + y[i] * v.y + z[i] * v.z;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void Vector3Array::Normalize()
+{
+    Value * x = mX.data(), * y = mY.data(), * z = mZ.data();
+    for (size_t i = 0, n = mX.size(); i < n; ++i)
+    {
+        const Value len = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+        // Avoid a branch so the loop stays vectorizable
+        const Value inv = len > 0 ? Value(1) / len : Value(1);
+        x[i] *= inv;
+        y[i] *= inv;
+        z[i] *= inv;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void Vector3Array::Translate(const Vector3 & v)
+{
+    Value * x = mX.data(), * y = mY.data(), * z = mZ.data();
+    for (size_t i = 0, n = mX.size(); i < n; ++i)
+    {
+        x[i] += v.x;
+        y[i] += v.y;
+        z[i] += v.z;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void Vector3Array::Scale(Value s)
+{
+    Value * x = mX.data(), * y = mY.data(), * z = mZ.data();
+    for (size_t i = 0, n = mX.size(); i < n; ++i)
+    {
+        x[i] *= s;
+        y[i] *= s;
+        z[i] *= s;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void Vector3Array::Transform(const Quaternion & q, const Vector3 & t)
+{
+    Value * x = mX.data(), * y = mY.data(), * z = mZ.data();
+    for (size_t i = 0, n = mX.size(); i < n; ++i)
+    {
+        // t = 2 * cross(q.xyz, v)
+        const Value tx = Value(2) * (q.y * z[i] - q.z * y[i]);
+        const Value ty = Value(2) * (q.z * x[i] - q.x * z[i]);
+        const Value tz = Value(2) * (q.x * y[i] - q.y * x[i]);
+        // v' = v + w * t + cross(q.xyz, t) + offset
+        x[i] += q.w * tx + (q.y * tz - q.z * ty) + t.x;
+        y[i] += q.w * ty + (q.z * tx - q.x * tz) + t.y;
+        z[i] += q.w * tz + (q.x * ty - q.y * tx) + t.z;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void Vector3Array::AddScaled(const Vector3Array & o, Value s)
+{
+    const size_t n = mX.size();
+    // Both arrays must have the same size
+    if (o.mX.size() != n)
+    {
+        STHROWF("Array size mismatch ({} != {})", o.mX.size(), n);
+    }
+    Value * x = mX.data(), * y = mY.data(), * z = mZ.data();
+    const Value * ox = o.mX.data(), * oy = o.mY.data(), * oz = o.mZ.data();
+    for (size_t i = 0; i < n; ++i)
+    {
+        x[i] += ox[i] * s;
+        y[i] += oy[i] * s;
+        z[i] += oz[i] * s;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger Vector3Array::Nearest(const Vector3 & p) const
+{
+    return NearestWithin(p, std::numeric_limits< Value >::infinity());
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger Vector3Array::NearestWithin(const Vector3 & p, Value radius) const
+{
+    const Value * x = mX.data(), * y = mY.data(), * z = mZ.data();
+    Value best = radius * radius;
+    SQInteger idx = -1;
+    for (size_t i = 0, n = mX.size(); i < n; ++i)
+    {
+        const Value dx = x[i] - p.x, dy = y[i] - p.y, dz = z[i] - p.z;
+        const Value d = dx * dx + dy * dy + dz * dz;
+        // Is this one closer?
+        if (d <= best)
+        {
+            best = d;
+            idx = static_cast< SQInteger >(i);
+        }
+    }
+    return idx;
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger Vector3Array::CountWithin(const Vector3 & p, Value radius) const
+{
+    const Value * x = mX.data(), * y = mY.data(), * z = mZ.data();
+    const Value range = radius * radius;
+    SQInteger count = 0;
+    for (size_t i = 0, n = mX.size(); i < n; ++i)
+    {
+        const Value dx = x[i] - p.x, dy = y[i] - p.y, dz = z[i] - p.z;
+        count += (dx * dx + dy * dy + dz * dz) <= range ? 1 : 0;
+    }
+    return count;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Vector3Array::BoundsInto(AABB & out) const
+{
+    out.Clear();
+    // Merge each vector into the bounding box
+    for (size_t i = 0, n = mX.size(); i < n; ++i)
+    {
+        out.MergeVector3Ex(mX[i], mY[i], mZ[i]);
+    }
+}
+
+// ================================================================================================
+void Register_Vector3Array(HSQUIRRELVM vm)
+{
+    RootTable(vm).Bind(Typename::Str,
+        Class< Vector3Array >(vm, Typename::Str)
+        // Constructors
+        .Ctor()
+        .Ctor< SQInteger >()
+        // Meta-methods
+        .SquirrelFunc(_SC("_typename"), &Typename::Fn)
+        // Properties
+        .Prop(_SC("Size"), &Vector3Array::GetSize, &Vector3Array::Resize)
+        .Prop(_SC("Capacity"), &Vector3Array::GetCapacity)
+        // Member Methods
+        .Func(_SC("Reserve"), &Vector3Array::Reserve)
+        .Func(_SC("Resize"), &Vector3Array::Resize)
+        .Func(_SC("Clear"), &Vector3Array::Clear)
+        .Func(_SC("Push"), &Vector3Array::Push)
+        .Func(_SC("PushEx"), &Vector3Array::PushEx)
+        .Func(_SC("Remove"), &Vector3Array::Remove)
+        .Func(_SC("Get"), &Vector3Array::Get)
+        .Func(_SC("GetInto"), &Vector3Array::GetInto)
+        .Func(_SC("Set"), &Vector3Array::Set)
+        .Func(_SC("SetEx"), &Vector3Array::SetEx)
+        .Func(_SC("Result"), &Vector3Array::GetResult)
+        .Func(_SC("Distance"), &Vector3Array::Distance)
+        .Func(_SC("DistanceSq"), &Vector3Array::DistanceSq)
+        .Func(_SC("Dot"), &Vector3Array::Dot)
+        .Func(_SC("Normalize"), &Vector3Array::Normalize)
+        .Func(_SC("Translate"), &Vector3Array::Translate)
+        .Func(_SC("Scale"), &Vector3Array::Scale)
+        .Func(_SC("Transform"), &Vector3Array::Transform)
+        .Func(_SC("AddScaled"), &Vector3Array::AddScaled)
+        .Func(_SC("Nearest"), &Vector3Array::Nearest)
+        .Func(_SC("NearestWithin"), &Vector3Array::NearestWithin)
+        .Func(_SC("CountWithin"), &Vector3Array::CountWithin)
+        .Func(_SC("BoundsInto"), &Vector3Array::BoundsInto)
+    );
+}
+
+} // Namespace:: SqMod
@@ -0,0 +1,250 @@
+#pragma once
+
+// ------------------------------------------------------------------------------------------------
+#include "Base/Vector3.hpp"
+#include "Base/Quaternion.hpp"
+#include "Base/AABB.hpp"
+#include "Core/Utility.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <vector>
+
+// ------------------------------------------------------------------------------------------------
+namespace SqMod {
+
+/* ------------------------------------------------------------------------------------------------
+ * Array of three-dimensional vectors stored as separate component lanes (structure of arrays).
+ * Batch operations work on contiguous lanes that the compiler can vectorize and store per element
+ * results in an internal result lane so that hot loops don't allocate script objects.
+*/
+struct Vector3Array
+{
+    /* --------------------------------------------------------------------------------------------
+     * The type of value used by components of type.
+    */
+    typedef Vector3::Value Value;
+
+    /* --------------------------------------------------------------------------------------------
+     * The type of container used by each lane.
+    */
+    typedef std::vector< Value > Lane;
+
+    /* --------------------------------------------------------------------------------------------
+     * Default constructor.
+    */
+    Vector3Array() = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Construct with the specified number of zeroed vectors.
+    */
+    explicit Vector3Array(SQInteger n)
+        : Vector3Array()
+    {
+        Resize(n);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy constructor.
+    */
+    Vector3Array(const Vector3Array & o) = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move constructor.
+    */
+    Vector3Array(Vector3Array && o) noexcept = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Destructor.
+    */
+    ~Vector3Array() = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy assignment operator.
+    */
+    Vector3Array & operator = (const Vector3Array & o) = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move assignment operator.
+    */
+    Vector3Array & operator = (Vector3Array && o) noexcept = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of vectors.
+    */
+    SQMOD_NODISCARD SQInteger GetSize() const
+    {
+        return static_cast< SQInteger >(mX.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of vectors that can be stored without reallocating.
+    */
+    SQMOD_NODISCARD SQInteger GetCapacity() const
+    {
+        return static_cast< SQInteger >(mX.capacity());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Reserve room for the specified number of vectors.
+    */
+    void Reserve(SQInteger n);
+
+    /* --------------------------------------------------------------------------------------------
+     * Change the number of vectors. New vectors are zeroed.
+    */
+    void Resize(SQInteger n);
+
+    /* --------------------------------------------------------------------------------------------
+     * Remove all vectors.
+    */
+    void Clear();
+
+    /* --------------------------------------------------------------------------------------------
+     * Append a vector.
+    */
+    void Push(const Vector3 & v)
+    {
+        PushEx(v.x, v.y, v.z);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Append a vector.
+    */
+    void PushEx(Value x, Value y, Value z);
+
+    /* --------------------------------------------------------------------------------------------
+     * Remove a vector by moving the last vector in its place.
+    */
+    void Remove(SQInteger i);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve a vector as a new instance.
+    */
+    SQMOD_NODISCARD Vector3 Get(SQInteger i) const
+    {
+        const size_t n = Valid(i);
+        return Vector3(mX[n], mY[n], mZ[n]);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy a vector into an existing instance.
+    */
+    void GetInto(SQInteger i, Vector3 & out) const
+    {
+        const size_t n = Valid(i);
+        out.x = mX[n];
+        out.y = mY[n];
+        out.z = mZ[n];
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify a vector.
+    */
+    void Set(SQInteger i, const Vector3 & v)
+    {
+        SetEx(i, v.x, v.y, v.z);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify a vector.
+    */
+    void SetEx(SQInteger i, Value x, Value y, Value z)
+    {
+        const size_t n = Valid(i);
+        mX[n] = x;
+        mY[n] = y;
+        mZ[n] = z;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve a value from the result lane.
+    */
+    SQMOD_NODISCARD Value GetResult(SQInteger i) const
+    {
+        if (i < 0 || static_cast< size_t >(i) >= mR.size())
+        {
+            STHROWF("Result index ({}) is out of range ({})", i, mR.size());
+        }
+        return mR[static_cast< size_t >(i)];
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Store the distance from each vector to a point into the result lane.
+    */
+    void Distance(const Vector3 & p);
+
+    /* --------------------------------------------------------------------------------------------
+     * Store the squared distance from each vector to a point into the result lane.
+    */
+    void DistanceSq(const Vector3 & p);
+
+    /* --------------------------------------------------------------------------------------------
+     * Store the dot product of each vector with another vector into the result lane.
+    */
+    void Dot(const Vector3 & v);
+
+    /* --------------------------------------------------------------------------------------------
+     * Normalize each vector to unit length. Zero vectors are left untouched.
+    */
+    void Normalize();
+
+    /* --------------------------------------------------------------------------------------------
+     * Add an offset to each vector.
+    */
+    void Translate(const Vector3 & v);
+
+    /* --------------------------------------------------------------------------------------------
+     * Multiply each vector by a scalar value.
+    */
+    void Scale(Value s);
+
+    /* --------------------------------------------------------------------------------------------
+     * Rotate each vector by a quaternion and then add an offset.
+    */
+    void Transform(const Quaternion & q, const Vector3 & t);
+
+    /* --------------------------------------------------------------------------------------------
+     * Add the vectors from another array of the same size, scaled by a scalar value.
+    */
+    void AddScaled(const Vector3Array & o, Value s);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the index of the vector closest to a point. Returns -1 if the array is empty.
+    */
+    SQMOD_NODISCARD SQInteger Nearest(const Vector3 & p) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the index of the vector closest to a point within a radius. Returns -1 if there is none.
+    */
+    SQMOD_NODISCARD SQInteger NearestWithin(const Vector3 & p, Value radius) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Count the vectors within a radius from a point.
+    */
+    SQMOD_NODISCARD SQInteger CountWithin(const Vector3 & p, Value radius) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Store the bounding box of all vectors into an existing instance.
+    */
+    void BoundsInto(AABB & out) const;
+
+private:
+
+    // --------------------------------------------------------------------------------------------
+    Lane mX{}, mY{}, mZ{}; // Component lanes.
+    Lane mR{}; // Result lane.
+
+    /* --------------------------------------------------------------------------------------------
+     * Validate an index and return it as an unsigned value.
+    */
+    SQMOD_NODISCARD size_t Valid(SQInteger i) const
+    {
+        if (i < 0 || static_cast< size_t >(i) >= mX.size())
+        {
+            STHROWF("Vector index ({}) is out of range ({})", i, mX.size());
+        }
+        return static_cast< size_t >(i);
+    }
+};
+
+} // Namespace:: SqMod
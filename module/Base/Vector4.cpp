@@ -507,7 +507,7 @@ void Register_Vector4(HSQUIRRELVM vm)
     typedef Vector4::Value Val;
 
     RootTable(vm).Bind(Typename::Str,
-        Class< Vector4 >(vm, Typename::Str)
+        Class< Vector4, PooledAllocator< Vector4 > >(vm, Typename::Str)
         // Constructors
         .Ctor()
         .Ctor< Val >()
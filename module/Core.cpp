@@ -3,6 +3,9 @@
 #include "Logger.hpp"
 #include "Core/Areas.hpp"
 #include "Core/Signal.hpp"
+#include "Core/Routine.hpp"
+#include "Core/Tasks.hpp"
+#include "Core/Command.hpp"
 #include "Core/Buffer.hpp"
 #include "Core/ThreadPool.hpp"
 #include "Library/IO/Buffer.hpp"
@@ -30,6 +33,7 @@
 #include <exception>
 #include <stdexcept>
 #include <algorithm>
+#include <tuple>
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
@@ -45,9 +49,12 @@ extern void InitializeRoutines();
 extern void TerminateAreas();
 extern void TerminateTasks();
 extern void TerminatePrivileges();
+extern void TerminateLoot();
 extern void TerminateRoutines();
 extern void TerminateCommands();
 extern void TerminateSignals();
+extern void TerminateProfiler();
+extern void SamplerCommand(const char * message);
 extern void TerminateNet();
 #ifdef VCMP_ENABLE_DISCORD
     extern void TerminateDPP();
@@ -58,6 +65,9 @@ extern void TerminatePocoData();
 // ------------------------------------------------------------------------------------------------
 extern Buffer GetRealFilePath(const SQChar * path);
 
+// ------------------------------------------------------------------------------------------------
+extern void EntityFlushDeferred();
+
 // ------------------------------------------------------------------------------------------------
 #ifdef VCMP_ENABLE_OFFICIAL
     extern void LgCheckpointSetID(LgCheckpoint * inst, int32_t id);
@@ -163,6 +173,7 @@ Core::Core() noexcept
     , m_VM(nullptr)
     , m_Scripts()
     , m_PendingScripts()
+    , m_HotReload()
     , m_Options()
     , m_Blips()
     , m_Checkpoints()
@@ -180,6 +191,7 @@ Core::Core() noexcept
     , m_AreasEnabled(false)
     , m_Debugging(false)
     , m_Executed(false)
+    , m_HotReloadChanged(false)
     , m_Shutdown(false)
     , m_LockPreLoadSignal(false)
     , m_LockPostLoadSignal(false)
@@ -543,12 +555,18 @@ void Core::Terminate(bool shutdown)
     // Release all resources from signals
     TerminateSignals();
     cLogDbg(m_Verbosity >= 2, "Signals terminated");
+    // Release the profiled callbacks
+    TerminateProfiler();
+    cLogDbg(m_Verbosity >= 2, "Profiler terminated");
     // Release all managed areas
     TerminateAreas();
     cLogDbg(m_Verbosity >= 2, "Areas terminated");
     // Release privilege managers
     TerminatePrivileges();
     cLogDbg(m_Verbosity >= 2, "Privileges terminated");
+    // Release loot managers
+    TerminateLoot();
+    cLogDbg(m_Verbosity >= 2, "Loot terminated");
     // Release announcers
     AnnounceTerminate();
     cLogDbg(m_Verbosity >= 1, "Announcer terminated");
@@ -596,6 +614,8 @@ void Core::Terminate(bool shutdown)
         // Release the script instances
         m_Scripts.clear();
         m_PendingScripts.clear(); // Just in case
+        m_HotReload.clear();
+        m_HotReloadChanged = false;
         // Specify that no scripts are left executed
         m_Executed = false;
         // Retrieve the VM context before closing
@@ -867,6 +887,142 @@ bool Core::LoadScript(const SQChar * filepath, Function & cb, LightObj & ctx, bo
     return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+bool Core::QueueHotReload(const SQChar * filepath)
+{
+    // Is the specified path empty?
+    if (!filepath || *filepath == '\0')
+    {
+        LogErr("Cannot hot reload script with empty or invalid path");
+        // Failed to queue
+        return false;
+    }
+
+    Buffer bpath;
+    // Attempt to get the real file path
+    try
+    {
+        bpath = GetRealFilePath(filepath);
+    }
+    catch (const std::exception & e)
+    {
+        LogErr("Unable to hot reload script: %s", e.what());
+        // Failed to queue
+        return false;
+    }
+
+    // Make the path into a string
+    String path(bpath.Data(), bpath.Position());
+    // Only scripts that were already executed can be hot reloaded
+    if (FindScript(path.c_str()) == m_Scripts.end())
+    {
+        LogErr("Cannot hot reload script that was not loaded: %s", path.c_str());
+        // Failed to queue
+        return false;
+    }
+    // Don't queue the same script twice
+    if (std::find(m_HotReload.begin(), m_HotReload.end(), path) == m_HotReload.end())
+    {
+        m_HotReload.push_back(std::move(path));
+    }
+    // The script will be reloaded at the end of the frame
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Core::ProcessHotReload()
+{
+    // Is there anything to reload? Scripts must be executed first and a full reload takes precedence
+    if ((m_HotReload.empty() && !m_HotReloadChanged) || !m_Executed || (m_CircularLocks & CCL_RELOAD_SCRIPTS))
+    {
+        return;
+    }
+    // Queue the scripts that were modified
+    if (m_HotReloadChanged)
+    {
+        for (const auto & s : m_Scripts)
+        {
+            if (s.Modified() && std::find(m_HotReload.begin(), m_HotReload.end(), s.mPath) == m_HotReload.end())
+            {
+                m_HotReload.push_back(s.mPath);
+            }
+        }
+        m_HotReloadChanged = false;
+    }
+    // Take the queue so that scripts can request another hot reload while being executed
+    std::vector< String > queue;
+    queue.swap(m_HotReload);
+    // Reload the scripts in the order they were queued
+    for (const auto & path : queue)
+    {
+        auto itr = FindScript(path.c_str());
+        // Was the script removed in the mean time?
+        if (itr != m_Scripts.end())
+        {
+            HotReload(*itr);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool Core::HotReload(ScriptSrc & s)
+{
+    // Compile the new code first so that a broken file leaves the current one untouched
+    Script exec;
+    try
+    {
+        exec.CompileFile(s.mPath);
+    }
+    catch (const std::exception & e)
+    {
+        LogErr("Unable to hot reload (%s) exception caught: %s", s.mPath.c_str(), e.what());
+        // Keep the previous code
+        return false;
+    }
+    // Release whatever the previous code left behind
+    const SQInteger slots = Signal::DropSource(s.mPath);
+    const SQInteger routines = Routine::TerminateSource(s.mPath);
+    const SQInteger tasks = Tasks::TerminateSource(s.mPath);
+    const SQInteger listeners = Cmd::Listener::DropSource(s.mPath);
+    cLogDbg(m_Verbosity >= 2, "Hot reload of (%s) released %" PRINT_INT_FMT " slots, %" PRINT_INT_FMT
+                " routines, %" PRINT_INT_FMT " tasks and %" PRINT_INT_FMT " command listeners",
+                s.mPath.c_str(), slots, routines, tasks, listeners);
+    // Replace the compiled code
+    s.mExec = exec;
+    s.mTime = ScriptSrc::GetModifiedTime(s.mPath);
+    // Refresh line information, if any
+    if (s.mInfo)
+    {
+        s.mData.clear();
+        s.mLine.clear();
+        // The line information is only used for debugging
+        try
+        {
+            s.Process();
+        }
+        catch (const std::exception & e)
+        {
+            LogWrn("Unable to refresh line information for (%s): %s", s.mPath.c_str(), e.what());
+        }
+    }
+    // Attempt to execute the compiled script code
+    try
+    {
+        s.mExec.Run();
+        // Invoke the global callback
+        (*mOnScript.first)(s.mPath, s.mCtx);
+    }
+    catch (const std::exception & e)
+    {
+        LogFtl("Unable to execute (%s) exception caught: %s", s.mPath.c_str(), e.what());
+        // Failed to execute properly
+        return false;
+    }
+    // At this point the script was reloaded
+    cLogScs(m_Verbosity >= 1, "Hot reloaded script: %s", s.mPath.c_str());
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 void Core::SetIncomingName(const SQChar * name)
 {
@@ -2636,6 +2792,18 @@ static void SqSetReloadStatus(bool toggle)
     SetReloadStatus(toggle);
 }
 
+// ------------------------------------------------------------------------------------------------
+static bool SqHotReload(StackStrF & path)
+{
+    return Core::Get().QueueHotReload(path.mPtr);
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqHotReloadChanged()
+{
+    Core::Get().QueueHotReloadChanged();
+}
+
 // ------------------------------------------------------------------------------------------------
 static void SqReloadBecause(int32_t header, LightObj & payload)
 {
@@ -2687,6 +2855,64 @@ static void SqSetAreasEnabled(bool toggle)
     Core::Get().AreasEnabled(toggle);
 }
 
+// ------------------------------------------------------------------------------------------------
+static bool SqGetEntitySnapshots()
+{
+    return g_EntitySnapshots;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqSetEntitySnapshots(bool toggle)
+{
+    g_EntitySnapshots = toggle;
+}
+
+// ------------------------------------------------------------------------------------------------
+static bool SqGetDeferredSetters()
+{
+    return g_EntityDeferred;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqSetDeferredSetters(bool toggle)
+{
+    g_EntityDeferred = toggle;
+    // Don't leave pending writes behind when switching back to immediate setters
+    if (!toggle)
+    {
+        EntityFlushDeferred();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqFlushDeferredSetters()
+{
+    EntityFlushDeferred();
+}
+
+// ------------------------------------------------------------------------------------------------
+static Table SqGetSnapshotStats()
+{
+    Table tbl(SqVM());
+    tbl.SetValue(_SC("Hits"), static_cast< SQInteger >(g_SnapshotHits));
+    tbl.SetValue(_SC("Misses"), static_cast< SQInteger >(g_SnapshotMisses));
+    tbl.SetValue(_SC("Frame"), static_cast< SQInteger >(g_EntityFrame));
+    tbl.SetValue(_SC("Deferred"), static_cast< SQInteger >(g_DeferredWrites));
+    tbl.SetValue(_SC("Coalesced"), static_cast< SQInteger >(g_DeferredCoalesced));
+    tbl.SetValue(_SC("Flushed"), static_cast< SQInteger >(g_DeferredFlushed));
+    return tbl;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqResetSnapshotStats()
+{
+    g_SnapshotHits = 0;
+    g_SnapshotMisses = 0;
+    g_DeferredWrites = 0;
+    g_DeferredCoalesced = 0;
+    g_DeferredFlushed = 0;
+}
+
 // ------------------------------------------------------------------------------------------------
 static const String & SqGetOption(StackStrF & name)
 {
@@ -2869,6 +3095,99 @@ static LightObj & SqGetClientDataBuffer()
     return Core::Get().GetClientDataBuffer();
 }
 
+// ------------------------------------------------------------------------------------------------
+static bool SqGetOpcodeProfiling()
+{
+    return sq_opcodeprofiling() == SQTrue;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqResetOpcodeProfile()
+{
+    sq_resetopcodeprofile(SqVM());
+}
+
+// ------------------------------------------------------------------------------------------------
+static Table SqGetOpcodeProfile()
+{
+    HSQUIRRELVM vm = SqVM();
+    Table tbl(vm);
+    // Only include the opcodes that were executed (none if profiling was not enabled at build time)
+    for (SQInteger op = 0, n = sq_opcodecount(); op < n; ++op)
+    {
+        const SQUnsignedInteger hits = sq_getopcodehits(vm, op);
+        if (hits != 0)
+        {
+            tbl.SetValue(sq_opcodename(op), static_cast< SQInteger >(hits));
+        }
+    }
+    return tbl;
+}
+
+// ------------------------------------------------------------------------------------------------
+static Array SqGetAllocatorStats()
+{
+    HSQUIRRELVM vm = SqVM();
+    Array arr(vm);
+    // Pools of classes that were never instantiated have no name yet
+    for (const PoolStats * p = PoolStats::Head(); p != nullptr; p = p->next)
+    {
+        Table tbl(vm);
+        tbl.SetValue(_SC("Name"), p->name);
+        tbl.SetValue(_SC("Allocated"), static_cast< SQInteger >(p->allocated));
+        tbl.SetValue(_SC("Reused"), static_cast< SQInteger >(p->reused));
+        tbl.SetValue(_SC("Released"), static_cast< SQInteger >(p->released));
+        tbl.SetValue(_SC("Live"), static_cast< SQInteger >(p->live));
+        tbl.SetValue(_SC("Cached"), static_cast< SQInteger >(p->cached));
+        arr.Append(tbl);
+    }
+    return arr;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqTrimAllocators()
+{
+    PoolStats::TrimAll();
+}
+
+// ------------------------------------------------------------------------------------------------
+static Array SqGetOpcodePairs(SQInteger top)
+{
+    HSQUIRRELVM vm = SqVM();
+    const SQInteger n = sq_opcodecount();
+    std::vector< std::tuple< SQUnsignedInteger, SQInteger, SQInteger > > pairs;
+    // A negative previous opcode stands for the first opcode executed by a function
+    for (SQInteger prev = -1; prev < n; ++prev)
+    {
+        for (SQInteger op = 0; op < n; ++op)
+        {
+            const SQUnsignedInteger hits = sq_getopcodepairhits(vm, prev, op);
+            if (hits != 0)
+            {
+                pairs.emplace_back(hits, prev, op);
+            }
+        }
+    }
+    // Most frequent pairs first
+    std::sort(pairs.begin(), pairs.end(), [](const auto & a, const auto & b) {
+        return std::get< 0 >(a) > std::get< 0 >(b);
+    });
+    if (top >= 0 && static_cast< size_t >(top) < pairs.size())
+    {
+        pairs.resize(static_cast< size_t >(top));
+    }
+    Array arr(vm);
+    for (const auto & p : pairs)
+    {
+        Table tbl(vm);
+        tbl.SetValue(_SC("From"), std::get< 1 >(p) < 0 ? LightObj{} : LightObj(sq_opcodename(std::get< 1 >(p)), -1));
+        tbl.SetValue(_SC("To"), sq_opcodename(std::get< 2 >(p)));
+        tbl.SetValue(_SC("Hits"), static_cast< SQInteger >(std::get< 0 >(p)));
+        arr.Append(tbl);
+    }
+    return arr;
+}
+
 // ================================================================================================
 void Register_Core(HSQUIRRELVM vm)
 {
@@ -2893,6 +3212,8 @@ void Register_Core(HSQUIRRELVM vm)
         .Func(_SC("Reload"), &SqSetReloadStatus)
         .Func(_SC("Reloading"), &SqGetReloadStatus)
         .Func(_SC("ReloadBecause"), &SqReloadBecause)
+        .FmtFunc(_SC("HotReload"), &SqHotReload)
+        .Func(_SC("HotReloadChanged"), &SqHotReloadChanged)
         .Func(_SC("SetReloadInfo"), &SqSetReloadInfo)
         .Func(_SC("GetReloadHeader"), &SqGetReloadHeader)
         .Func(_SC("GetReloadPayload"), &SqGetReloadPayload)
@@ -2901,6 +3222,13 @@ void Register_Core(HSQUIRRELVM vm)
         .Func(_SC("SetState"), &SqSetState)
         .Func(_SC("AreasEnabled"), &SqGetAreasEnabled)
         .Func(_SC("SetAreasEnabled"), &SqSetAreasEnabled)
+        .Func(_SC("EntitySnapshots"), &SqGetEntitySnapshots)
+        .Func(_SC("SetEntitySnapshots"), &SqSetEntitySnapshots)
+        .Func(_SC("SnapshotStats"), &SqGetSnapshotStats)
+        .Func(_SC("DeferredSetters"), &SqGetDeferredSetters)
+        .Func(_SC("SetDeferredSetters"), &SqSetDeferredSetters)
+        .Func(_SC("FlushDeferredSetters"), &SqFlushDeferredSetters)
+        .Func(_SC("ResetSnapshotStats"), &SqResetSnapshotStats)
         .Func(_SC("GetOption"), &SqGetOption)
         .Func(_SC("GetOptionOr"), &SqGetOptionOr)
         .Func(_SC("SetOption"), &SqSetOption)
@@ -2918,6 +3246,12 @@ void Register_Core(HSQUIRRELVM vm)
         .Func(_SC("DestroyPickup"), &SqDelPickup)
         .Func(_SC("DestroyVehicle"), &SqDelVehicle)
         .Func(_SC("ClientDataBuffer"), &SqGetClientDataBuffer)
+        .Func(_SC("OpcodeProfiling"), &SqGetOpcodeProfiling)
+        .Func(_SC("OpcodeProfile"), &SqGetOpcodeProfile)
+        .Func(_SC("OpcodePairs"), &SqGetOpcodePairs)
+        .Func(_SC("ResetOpcodeProfile"), &SqResetOpcodeProfile)
+        .Func(_SC("AllocatorStats"), &SqGetAllocatorStats)
+        .Func(_SC("TrimAllocators"), &SqTrimAllocators)
         .Func(_SC("OnPreLoad"), &SqGetPreLoadEvent)
         .Func(_SC("OnPostLoad"), &SqGetPostLoadEvent)
         .Func(_SC("OnUnload"), &SqGetUnloadEvent)
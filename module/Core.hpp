@@ -67,6 +67,7 @@ private:
     HSQUIRRELVM                     m_VM; // Script virtual machine.
     Scripts                         m_Scripts; // Loaded scripts objects.
     Scripts                         m_PendingScripts; // Pending scripts objects.
+    std::vector< String >           m_HotReload; // Scripts queued for hot reloading.
     Options                         m_Options; // Custom configuration options.
 
     // --------------------------------------------------------------------------------------------
@@ -96,6 +97,7 @@ private:
     bool                            m_AreasEnabled; // Whether area tracking is enabled.
     bool                            m_Debugging; // Enable debugging features, if any.
     bool                            m_Executed; // Whether the scripts were executed.
+    bool                            m_HotReloadChanged; // Whether modified scripts must be hot reloaded.
     bool                            m_Shutdown; // Whether the server currently shutting down.
     bool                            m_LockPreLoadSignal; // Lock pre load signal container.
     bool                            m_LockPostLoadSignal; // Lock post load signal container.
@@ -373,6 +375,30 @@ public:
     */
     bool LoadScript(const SQChar * filepath, Function & cb, LightObj & ctx, bool delay = false);
 
+    /* --------------------------------------------------------------------------------------------
+     * Queue a loaded script to be compiled and executed again without reloading the plug-in.
+    */
+    bool QueueHotReload(const SQChar * filepath);
+
+    /* --------------------------------------------------------------------------------------------
+     * Queue all loaded scripts that were modified since they were compiled.
+    */
+    void QueueHotReloadChanged()
+    {
+        m_HotReloadChanged = true;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Hot reload the queued scripts.
+    */
+    void ProcessHotReload();
+
+    /* --------------------------------------------------------------------------------------------
+     * Compile and execute a loaded script again. Only the signal slots, routines and tasks whose
+     * callbacks were compiled from this script are released. Everything else is left intact.
+    */
+    bool HotReload(ScriptSrc & s);
+
     /* --------------------------------------------------------------------------------------------
      * Modify the name for the currently assigned incoming connection.
     */
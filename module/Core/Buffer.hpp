@@ -751,6 +751,19 @@ public:
         }
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Reduce the capacity without reallocating, so that only the beginning of the memory is exposed.
+     * The memory is still released as a whole. The edit cursor is kept within the new capacity.
+    */
+    void Limit(SzType n) noexcept
+    {
+        if (n < m_Cap)
+        {
+            m_Cap = n;
+            m_Cur = m_Cur > n ? n : m_Cur;
+        }
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Swap the contents of two buffers.
     */
@@ -18,6 +18,53 @@ Listener *  Listener::s_Head = nullptr;
 SQMOD_DECL_TYPENAME(ManagerTypename, _SC("SqCmdManager"))
 SQMOD_DECL_TYPENAME(ListenerTypename, _SC("SqCmdListener"))
 
+// ------------------------------------------------------------------------------------------------
+SQInteger Listener::DropSource(const String & source)
+{
+    // See if any of the callbacks came from the specified source
+    const auto from_source = [&source](const Listener * l) {
+        return IsFunctionFromSource(l->m_OnExec.GetFunc(), source) ||
+               IsFunctionFromSource(l->m_OnAuth.GetFunc(), source) ||
+               IsFunctionFromSource(l->m_OnAudit.GetFunc(), source) ||
+               IsFunctionFromSource(l->m_OnPost.GetFunc(), source) ||
+               IsFunctionFromSource(l->m_OnFail.GetFunc(), source);
+    };
+    // Grab the virtual machine once
+    HSQUIRRELVM vm = SqVM();
+    // Remember the current stack size
+    const StackGuard sg(vm);
+    // Hold strong references so that releasing one listener can't destroy the others while we iterate
+    std::vector< std::pair< Listener *, LightObj > > found;
+    const auto collect = [&](Listener * node) {
+        if (from_source(node))
+        {
+            ClassType< Listener >::PushInstance(vm, node, nullptr);
+            found.emplace_back(node, Var< LightObj >(vm, -1).value);
+            sq_poptop(vm);
+        }
+    };
+    // Listeners may be chained in both directions from the head
+    for (Listener * node = s_Head; node != nullptr; node = node->m_Next)
+    {
+        collect(node);
+    }
+    for (Listener * node = (s_Head != nullptr ? s_Head->m_Prev : nullptr); node != nullptr; node = node->m_Prev)
+    {
+        collect(node);
+    }
+    // Detach them and release their callbacks
+    for (auto & f : found)
+    {
+        f.first->Detach();
+        f.first->m_OnExec.Release();
+        f.first->m_OnAuth.Release();
+        f.first->m_OnAudit.Release();
+        f.first->m_OnPost.Release();
+        f.first->m_OnFail.Release();
+    }
+    return static_cast< SQInteger >(found.size());
+}
+
 // ------------------------------------------------------------------------------------------------
 Guard::Guard(CtrRef ctr, Object & invoker)
     : mController(std::move(ctr))
@@ -152,16 +199,14 @@ Object & Controller::Attach(Object && obj, Listener * ptr)
         STHROWF("Cannot attach command without a name");
     }
     // Obtain the unique identifier of the specified name
-    const std::size_t hash = std::hash< String >()(name);
+    const std::size_t hash = HashName(name);
     // Make sure the command doesn't already exist
     for (const auto & cmd : m_Commands)
     {
-        // Are the hashes identical?
-        if (cmd.mHash == hash)
+        // Are the names identical?
+        if (cmd.mHash == hash && cmd.mName == name)
         {
-            // Include information necessary to help identify hash collisions!
-            STHROWF("Command '{}' already exists as '{}' for hash ({})",
-                        name.c_str(), cmd.mName.c_str(), hash);
+            STHROWF("Command '{}' already exists", name.c_str());
         }
     }
     // Attempt to insert the command
@@ -209,16 +254,14 @@ Object & Controller::Attach(Object && obj, Listener * ptr, String name)
         STHROWF("Cannot attach command without a name");
     }
     // Obtain the unique identifier of the specified name
-    const std::size_t hash = std::hash< String >()(name);
+    const std::size_t hash = HashName(name);
     // Make sure the command doesn't already exist
     for (const auto & cmd : m_Commands)
     {
-        // Are the hashes identical?
-        if (cmd.mHash == hash)
+        // Are the names identical?
+        if (cmd.mHash == hash && cmd.mName == name)
         {
-            // Include information necessary to help identify hash collisions!
-            STHROWF("Command '{}' already exists as '{}' for hash ({})",
-                        name.c_str(), cmd.mName.c_str(), hash);
+            STHROWF("Command '{}' already exists", name.c_str());
         }
     }
     // Attempt to insert the command
@@ -455,10 +498,15 @@ int32_t Controller::Exec(Context & ctx)
             {
                 tbl.SetValue(SQInteger(arg), ctx.mArgv[arg].second);
             }
-            // Nope, we have a name for this argument!
+            // Nope, we have a name for this argument! (already interned, so it's pushed as is)
             else
             {
-                tbl.SetValue(ctx.mInstance->m_ArgTags[arg].c_str(), ctx.mArgv[arg].second);
+                HSQUIRRELVM vm = SqVM();
+                sq_pushobject(vm, tbl.GetObj());
+                sq_pushobject(vm, ctx.mInstance->m_ArgKeys[arg].mObj);
+                sq_pushobject(vm, ctx.mArgv[arg].second.GetObj());
+                sq_newslot(vm, -3, SQFalse);
+                sq_pop(vm, 1);
             }
         }
         // Store the table object into an abstract script object
@@ -895,6 +943,17 @@ bool Controller::Parse(Context & ctx)
     return good;
 }
 
+// ------------------------------------------------------------------------------------------------
+void Listener::InternArgTags()
+{
+    for (uint32_t arg = 0; arg < SQMOD_MAX_CMD_ARGS; ++arg)
+    {
+        const String & tag = m_ArgTags[arg];
+        // Untagged arguments use their index as the key
+        m_ArgKeys[arg] = tag.empty() ? LightObj{} : LightObj(tag.c_str(), static_cast< SQInteger >(tag.size()));
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void Listener::GenerateInfo(bool full)
 {
@@ -465,10 +465,10 @@ protected:
     void Detach(const String & name)
     {
         // Obtain the unique identifier of the specified name
-        const std::size_t hash = std::hash< String >()(name);
+        const std::size_t hash = HashName(name);
         // Attempt to find the specified command
-        auto itr = std::find_if(m_Commands.cbegin(), m_Commands.cend(), [=](Commands::const_reference c) {
-            return (c.mHash == hash);
+        auto itr = std::find_if(m_Commands.cbegin(), m_Commands.cend(), [&](Commands::const_reference c) {
+            return (c.mHash == hash && c.mName == name);
         });
         // Make sure the command exist before attempting to remove it
         if (itr != m_Commands.end())
@@ -553,12 +553,12 @@ public:
     SQMOD_NODISCARD bool Attached(const String & name) const
     {
         // Obtain the unique identifier of the specified name
-        const std::size_t hash = std::hash< String >()(name);
+        const std::size_t hash = HashName(name);
         // Attempt to find the specified command
         for (const auto & cmd : m_Commands) // NOLINT(readability-use-anyofallof)
         {
-            // Are the hashes identical?
-            if (cmd.mHash == hash)
+            // Are the names identical?
+            if (cmd.mHash == hash && cmd.mName == name)
             {
                 return true; // We found our command!
             }
@@ -610,12 +610,12 @@ public:
     const Object & FindByName(const String & name)
     {
         // Obtain the unique identifier of the specified name
-        const std::size_t hash = std::hash< String >()(name);
+        const std::size_t hash = HashName(name);
         // Attempt to find the specified command
         for (const auto & cmd : m_Commands)
         {
-            // Are the hashes identical?
-            if (cmd.mHash == hash)
+            // Are the names identical?
+            if (cmd.mHash == hash && cmd.mName == name)
             {
                 return cmd.mObj; // We found our command!
             }
@@ -1134,6 +1134,12 @@ public:
         // Better safe than sorry
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Detach the listeners with a callback compiled from the specified source and release their
+     * callbacks. Returns the number of affected listeners.
+    */
+    static SQInteger DropSource(const String & source);
+
     /* --------------------------------------------------------------------------------------------
      * Convenience constructor.
     */
@@ -1205,6 +1211,7 @@ public:
         , m_Name()
         , m_ArgSpec()
         , m_ArgTags()
+        , m_ArgKeys()
         , m_MinArgc(0)
         , m_MaxArgc(SQMOD_MAX_CMD_ARGS-1)
         , m_Aliases(0)
@@ -1561,6 +1568,8 @@ public:
             {
                 m_ArgTag.clear();
             }
+            // Keep the keys in sync with the tags
+            InternArgTags();
             // We're done here!
             return;
         }
@@ -1584,6 +1593,8 @@ public:
         {
             STHROWF("Argument tag ({}) is out of range ({})", max, SQMOD_MAX_CMD_ARGS);
         }
+        // Keep the keys in sync with the tags
+        InternArgTags();
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -1878,6 +1889,8 @@ public:
         {
             m_ArgTags[arg].clear();
         }
+        // Keep the keys in sync with the tags
+        InternArgTags();
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -1960,6 +1973,7 @@ protected:
     // --------------------------------------------------------------------------------------------
     typedef uint8_t   ArgSpec[SQMOD_MAX_CMD_ARGS];
     typedef String  ArgTags[SQMOD_MAX_CMD_ARGS];
+    typedef LightObj ArgKeys[SQMOD_MAX_CMD_ARGS];
 
     /* --------------------------------------------------------------------------------------------
      * Execute the designated audit callback by passing the arguments in their specified order.
@@ -1988,6 +2002,11 @@ protected:
     */
     void ProcSpec(const SQChar * spec);
 
+    /* --------------------------------------------------------------------------------------------
+     * Intern the argument tags into the keys used by associative listeners.
+    */
+    void InternArgTags();
+
 private:
 
     // --------------------------------------------------------------------------------------------
@@ -2000,6 +2019,7 @@ private:
     // --------------------------------------------------------------------------------------------
     ArgSpec     m_ArgSpec; // List of argument type specifications.
     ArgTags     m_ArgTags; // List of argument tags/names.
+    ArgKeys     m_ArgKeys; // Interned argument tags used as keys by associative listeners.
 
     // --------------------------------------------------------------------------------------------
     uint8_t     m_MinArgc; // Minimum number of arguments supported by this listener.
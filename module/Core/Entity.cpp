@@ -12,9 +12,73 @@
 #include "Entity/Player.hpp"
 #include "Entity/Vehicle.hpp"
 
+// ------------------------------------------------------------------------------------------------
+#include <algorithm>
+
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
+// ------------------------------------------------------------------------------------------------
+bool g_EntitySnapshots = false;
+uint32_t g_EntityFrame = 1;
+SQUnsignedInteger g_SnapshotHits = 0;
+SQUnsignedInteger g_SnapshotMisses = 0;
+bool g_EntityDeferred = false;
+SQUnsignedInteger g_DeferredWrites = 0;
+SQUnsignedInteger g_DeferredCoalesced = 0;
+SQUnsignedInteger g_DeferredFlushed = 0;
+
+// ------------------------------------------------------------------------------------------------
+static std::vector< std::pair< EntityType, int32_t > > g_DeferredEntities; // Entities with pending writes.
+
+// ------------------------------------------------------------------------------------------------
+void EntitySnapshotNewFrame()
+{
+    // Anything cached so far belongs to the previous frame
+    ++g_EntityFrame;
+}
+
+// ------------------------------------------------------------------------------------------------
+void EntitySnapshot::Defer(EntityType type, int32_t id, uint32_t field)
+{
+    // Remember the entity the first time it receives a pending write
+    if (mPending == ESF_NONE)
+    {
+        g_DeferredEntities.emplace_back(type, id);
+    }
+    // Was there a pending value that this write replaces?
+    else if (mPending & field)
+    {
+        ++g_DeferredCoalesced;
+    }
+    ++g_DeferredWrites;
+    // Getters must return the pending value until it reaches the server
+    mPending |= field;
+    Store(field);
+}
+
+// ------------------------------------------------------------------------------------------------
+void EntityFlushDeferred()
+{
+    // Writes made while flushing (from server callbacks) go to the next batch
+    std::vector< std::pair< EntityType, int32_t > > entities;
+    entities.swap(g_DeferredEntities);
+    // Flush in a deterministic order regardless of the order in which scripts made the writes
+    std::sort(entities.begin(), entities.end());
+    entities.erase(std::unique(entities.begin(), entities.end()), entities.end());
+    // Entities destroyed in the meantime have no pending writes left
+    for (const auto & e : entities)
+    {
+        switch (e.first)
+        {
+            case ENT_OBJECT: Core::Get().GetObj(e.second).FlushPending(ESF_ALL); break;
+            case ENT_PLAYER: Core::Get().GetPlayer(e.second).FlushPending(ESF_ALL); break;
+            case ENT_VEHICLE: Core::Get().GetVehicle(e.second).FlushPending(ESF_ALL); break;
+            default: break;
+        }
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 #define SQMOD_CATCH_EVENT_EXCEPTION(action) /*
 */ catch (const Poco::Exception & e) /*
@@ -31,6 +95,7 @@ namespace SqMod {
 
 // ------------------------------------------------------------------------------------------------
 extern void CleanupTasks(int32_t id, int32_t type);
+extern void CleanupBroadcastGroups(int32_t id);
 
 // ------------------------------------------------------------------------------------------------
 #ifdef VCMP_ENABLE_OFFICIAL
@@ -386,6 +451,11 @@ void PlayerInst::Destroy(bool /*destroy*/, int32_t header, LightObj & payload)
 #endif
     // Release tasks, if any
     CleanupTasks(mID, ENT_PLAYER);
+    // Leave the broadcast groups
+    if (VALID_ENTITYEX(mID, SQMOD_PLAYER_POOL))
+    {
+        CleanupBroadcastGroups(mID);
+    }
     // Reset the instance to it's initial state
     ResetInstance();
     // Don't release the callbacks abruptly
@@ -480,6 +550,19 @@ void ObjectInst::ResetInstance()
 {
     mID = -1;
     mFlags = ENF_DEFAULT;
+    mSnapshot.Clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+void ObjectInst::FlushPending(uint32_t fields)
+{
+    const uint32_t pending = mSnapshot.TakePending(fields);
+    // Send the pending values in a fixed order
+    if (pending & ESF_POSITION)
+    {
+        _Func->SetObjectPosition(mID, mSnapPosition.x, mSnapPosition.y, mSnapPosition.z);
+        ++g_DeferredFlushed;
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -507,9 +590,37 @@ void PlayerInst::ResetInstance()
     mLastArmour = 0.0;
     mLastHeading = 0.0;
     mLastPosition.Clear();
+    mSnapshot.Clear();
     mAuthority = 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+void PlayerInst::FlushPending(uint32_t fields)
+{
+    const uint32_t pending = mSnapshot.TakePending(fields);
+    // Send the pending values in a fixed order
+    if (pending & ESF_POSITION)
+    {
+        _Func->SetPlayerPosition(mID, mSnapPosition.x, mSnapPosition.y, mSnapPosition.z);
+        ++g_DeferredFlushed;
+    }
+    if (pending & ESF_HEADING)
+    {
+        _Func->SetPlayerHeading(mID, mSnapHeading);
+        ++g_DeferredFlushed;
+    }
+    if (pending & ESF_HEALTH)
+    {
+        _Func->SetPlayerHealth(mID, mSnapHealth);
+        ++g_DeferredFlushed;
+    }
+    if (pending & ESF_ARMOUR)
+    {
+        _Func->SetPlayerArmour(mID, mSnapArmour);
+        ++g_DeferredFlushed;
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void VehicleInst::ResetInstance()
 {
@@ -524,6 +635,35 @@ void VehicleInst::ResetInstance()
     mLastHealth = 0.0;
     mLastPosition.Clear();
     mLastRotation.Clear();
+    mSnapshot.Clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+void VehicleInst::FlushPending(uint32_t fields)
+{
+    const uint32_t pending = mSnapshot.TakePending(fields);
+    // Send the pending values in a fixed order
+    if (pending & ESF_POSITION)
+    {
+        _Func->SetVehiclePosition(mID, mSnapPosition.x, mSnapPosition.y, mSnapPosition.z, static_cast< uint8_t >(false));
+        ++g_DeferredFlushed;
+    }
+    if (pending & ESF_ROTATION)
+    {
+        _Func->SetVehicleRotation(mID, mSnapRotation.x, mSnapRotation.y, mSnapRotation.z, mSnapRotation.w);
+        ++g_DeferredFlushed;
+    }
+    if (pending & ESF_SPEED)
+    {
+        _Func->SetVehicleSpeed(mID, mSnapSpeed.x, mSnapSpeed.y, mSnapSpeed.z,
+                                static_cast< uint8_t >(false), static_cast< uint8_t >(false));
+        ++g_DeferredFlushed;
+    }
+    if (pending & ESF_HEALTH)
+    {
+        _Func->SetVehicleHealth(mID, mSnapHealth);
+        ++g_DeferredFlushed;
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
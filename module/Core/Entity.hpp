@@ -15,6 +15,111 @@ namespace SqMod {
 // --------------------------------------------------------------------------------------------
 typedef std::vector< std::pair< Area *, LightObj > > AreaList; // List of collided areas.
 
+// --------------------------------------------------------------------------------------------
+extern bool g_EntitySnapshots; // Whether entity getters may be served from the state snapshot.
+extern uint32_t g_EntityFrame; // Server frame that the state snapshots belong to.
+extern SQUnsignedInteger g_SnapshotHits; // Getter calls served from the state snapshot.
+extern SQUnsignedInteger g_SnapshotMisses; // Getter calls that had to query the server.
+extern bool g_EntityDeferred; // Whether entity setters are deferred until the end of the frame.
+extern SQUnsignedInteger g_DeferredWrites; // Setter calls that were deferred.
+extern SQUnsignedInteger g_DeferredCoalesced; // Deferred setter calls that replaced a pending value.
+extern SQUnsignedInteger g_DeferredFlushed; // Pending values that were sent to the server.
+
+/* --------------------------------------------------------------------------------------------
+ * Helper structure used to remember which entity fields were cached during the current frame.
+*/
+struct EntitySnapshot
+{
+    // ----------------------------------------------------------------------------------------
+    uint32_t        mFrame{0}; // Frame in which the cached fields were stored.
+    uint32_t        mFields{ESF_NONE}; // Fields cached during that frame.
+    uint32_t        mPending{ESF_NONE}; // Fields with deferred writes not yet sent to the server.
+
+    /* ----------------------------------------------------------------------------------------
+     * See if a field can be served from the snapshot. Only counted when snapshots are enabled.
+    */
+    SQMOD_NODISCARD bool Has(uint32_t field) const
+    {
+        // Pending values must be visible regardless of the snapshot mode
+        if (mPending & field)
+        {
+            return true;
+        }
+        else if (!g_EntitySnapshots)
+        {
+            return false;
+        }
+        else if (mFrame == g_EntityFrame && (mFields & field))
+        {
+            ++g_SnapshotHits;
+            return true;
+        }
+        ++g_SnapshotMisses;
+        return false;
+    }
+
+    /* ----------------------------------------------------------------------------------------
+     * Mark a field as cached for the current frame.
+    */
+    void Store(uint32_t field)
+    {
+        // Discard fields cached in a previous frame
+        if (mFrame != g_EntityFrame)
+        {
+            mFrame = g_EntityFrame;
+            mFields = ESF_NONE;
+        }
+        mFields |= field;
+    }
+
+    /* ----------------------------------------------------------------------------------------
+     * Mark a field as cached for the current frame, unless it holds a pending write.
+    */
+    SQMOD_NODISCARD bool Refresh(uint32_t field)
+    {
+        // The pending value must not be replaced by the one from the server
+        if (mPending & field)
+        {
+            return false;
+        }
+        Store(field);
+        return true;
+    }
+
+    /* ----------------------------------------------------------------------------------------
+     * Record a deferred write to a field. The value must be stored by the caller.
+    */
+    void Defer(EntityType type, int32_t id, uint32_t field);
+
+    /* ----------------------------------------------------------------------------------------
+     * Take the pending fields out of the specified ones so they can be sent to the server.
+    */
+    SQMOD_NODISCARD uint32_t TakePending(uint32_t fields)
+    {
+        const uint32_t pending = mPending & fields;
+        mPending &= ~pending;
+        return pending;
+    }
+
+    /* ----------------------------------------------------------------------------------------
+     * Discard cached fields because they were modified.
+    */
+    void Invalidate(uint32_t fields)
+    {
+        mFields &= ~fields;
+    }
+
+    /* ----------------------------------------------------------------------------------------
+     * Discard all cached fields.
+    */
+    void Clear()
+    {
+        mFrame = 0;
+        mFields = ESF_NONE;
+        mPending = ESF_NONE;
+    }
+};
+
 // --------------------------------------------------------------------------------------------
 #ifdef VCMP_ENABLE_OFFICIAL
     struct LgCheckpoint;
@@ -311,6 +416,11 @@ struct ObjectInst
     */
     void ResetInstance();
 
+    /* ----------------------------------------------------------------------------------------
+     * Send the deferred writes of the specified fields to the server.
+    */
+    void FlushPending(uint32_t fields);
+
     /* ----------------------------------------------------------------------------------------
      * Create the associated signals.
     */
@@ -327,6 +437,10 @@ struct ObjectInst
     CObject *       mInst{nullptr}; // Pointer to the actual instance used to interact this entity.
     LightObj        mObj{}; // Script object of the instance used to interact this entity.
 
+    // ----------------------------------------------------------------------------------------
+    EntitySnapshot  mSnapshot{}; // Fields with deferred writes.
+    Vector3         mSnapPosition{}; // Pending position of the object entity.
+
     // ----------------------------------------------------------------------------------------
     LightObj        mEvents{}; // Table containing the emitted entity events.
 
@@ -482,6 +596,11 @@ struct PlayerInst
     */
     void ResetInstance();
 
+    /* ----------------------------------------------------------------------------------------
+     * Send the deferred writes of the specified fields to the server.
+    */
+    void FlushPending(uint32_t fields);
+
     /* ----------------------------------------------------------------------------------------
      * Create the associated signals.
     */
@@ -521,6 +640,14 @@ struct PlayerInst
     float           mLastHeading{0}; // Last known heading of the player entity.
     Vector3         mLastPosition{}; // Last known position of the player entity.
 
+    // ----------------------------------------------------------------------------------------
+    EntitySnapshot  mSnapshot{}; // Fields cached during the current frame.
+    int32_t         mSnapWeapon{0}; // Weapon of the player entity in the snapshot.
+    float           mSnapHealth{0}; // Health of the player entity in the snapshot.
+    float           mSnapArmour{0}; // Armor of the player entity in the snapshot.
+    float           mSnapHeading{0}; // Heading of the player entity in the snapshot.
+    Vector3         mSnapPosition{}; // Position of the player entity in the snapshot.
+
     // ----------------------------------------------------------------------------------------
     int32_t         mAuthority{0}; // The authority level of the managed player.
 
@@ -663,6 +790,11 @@ struct VehicleInst
     */
     void ResetInstance();
 
+    /* ----------------------------------------------------------------------------------------
+     * Send the deferred writes of the specified fields to the server.
+    */
+    void FlushPending(uint32_t fields);
+
     /* ----------------------------------------------------------------------------------------
      * Create the associated signals.
     */
@@ -694,6 +826,13 @@ struct VehicleInst
     Vector3         mLastPosition{}; // Last known position of the vehicle entity.
     Quaternion      mLastRotation{}; // Last known rotation of the vehicle entity.
 
+    // ----------------------------------------------------------------------------------------
+    EntitySnapshot  mSnapshot{}; // Fields cached during the current frame.
+    float           mSnapHealth{0}; // Health of the vehicle entity in the snapshot.
+    Vector3         mSnapPosition{}; // Position of the vehicle entity in the snapshot.
+    Quaternion      mSnapRotation{}; // Rotation of the vehicle entity in the snapshot.
+    Vector3         mSnapSpeed{}; // Pending speed of the vehicle entity.
+
     // ----------------------------------------------------------------------------------------
     LightObj        mEvents{}; // Table containing the emitted entity events.
 
@@ -1,19 +1,665 @@
 // ------------------------------------------------------------------------------------------------
 #include "Core/Inventory.hpp"
+#include "Library/IO/Buffer.hpp"
 
 // ------------------------------------------------------------------------------------------------
 #include <cstring>
+#include <iterator>
+#include <algorithm>
+#include <functional>
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
 // ------------------------------------------------------------------------------------------------
+SQMOD_DECL_TYPENAME(InventoryManagerTn, _SC("SqInventoryManager"))
 
+/* ------------------------------------------------------------------------------------------------
+ * See if the attributes of a slot are identical to the specified blob.
+*/
+static inline bool SameAttr(const String & a, const char * attr, size_t len)
+{
+    return a.size() == len && (len == 0 || std::memcmp(a.data(), attr, len) == 0);
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Read a value from the cursor position of a buffer and advance the cursor.
+*/
+template < typename T > static inline T InventoryRead(Buffer & b)
+{
+    const T v = b.Cursor< T >();
+    b.Advance< T >(1);
+    return v;
+}
+
+// ------------------------------------------------------------------------------------------------
+InventorySlot & InventoryManager::ValidSlot(SQInteger slot)
+{
+    if (slot < 0 || static_cast< size_t >(slot) >= mSlots.size())
+    {
+        STHROWF("Invalid inventory slot ({})", slot);
+    }
+    return mSlots[static_cast< size_t >(slot)];
+}
+
+// ------------------------------------------------------------------------------------------------
+const InventorySlot & InventoryManager::ValidSlot(SQInteger slot) const
+{
+    if (slot < 0 || static_cast< size_t >(slot) >= mSlots.size())
+    {
+        STHROWF("Invalid inventory slot ({})", slot);
+    }
+    return mSlots[static_cast< size_t >(slot)];
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Occupy(uint32_t slot, int32_t item, uint32_t count, const char * attr, size_t len)
+{
+    InventorySlot & s = mSlots[slot];
+    s.mItem = item;
+    s.mCount = count;
+    s.mAttr.assign(attr == nullptr ? "" : attr, len);
+    // Keep the slots of each item sorted so that the first ones are preferred
+    std::vector< uint32_t > & idx = mIndex[item];
+    idx.insert(std::lower_bound(idx.begin(), idx.end(), slot), slot);
+    // One more slot is occupied (the empty heap is cleaned lazily)
+    ++mUsed;
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Vacate(uint32_t slot)
+{
+    InventorySlot & s = mSlots[slot];
+    // Forget that this slot holds the item
+    auto itr = mIndex.find(s.mItem);
+    if (itr != mIndex.end())
+    {
+        auto pos = std::lower_bound(itr->second.begin(), itr->second.end(), slot);
+        if (pos != itr->second.end() && *pos == slot)
+        {
+            itr->second.erase(pos);
+        }
+        // Don't keep entries for items that are no longer present
+        if (itr->second.empty())
+        {
+            mIndex.erase(itr);
+        }
+    }
+    // Reset the slot
+    s.mItem = -1;
+    s.mCount = 0;
+    s.mAttr.clear();
+    --mUsed;
+    // Discard stale entries once they outnumber the slots
+    if (mEmpty.size() > (mSlots.size() * 2 + 16))
+    {
+        mEmpty.clear();
+        for (uint32_t i = 0; i < mSlots.size(); ++i)
+        {
+            if (mSlots[i].Empty())
+            {
+                mEmpty.push_back(i);
+            }
+        }
+        std::make_heap(mEmpty.begin(), mEmpty.end(), std::greater< uint32_t >());
+    }
+    // Make the slot available again
+    else
+    {
+        mEmpty.push_back(slot);
+        std::push_heap(mEmpty.begin(), mEmpty.end(), std::greater< uint32_t >());
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+int32_t InventoryManager::NextEmpty()
+{
+    // Discard entries for slots that were occupied or removed since they were freed
+    while (!mEmpty.empty())
+    {
+        const uint32_t slot = mEmpty.front();
+        // Is this slot still empty?
+        if (slot < mSlots.size() && mSlots[slot].Empty())
+        {
+            return static_cast< int32_t >(slot);
+        }
+        std::pop_heap(mEmpty.begin(), mEmpty.end(), std::greater< uint32_t >());
+        mEmpty.pop_back();
+    }
+    // No empty slots
+    return -1;
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Resize(SQInteger capacity)
+{
+    if (capacity < 0 || capacity > INVENTORY_CAPACITY_MAX)
+    {
+        STHROWF("Invalid inventory capacity ({})", capacity);
+    }
+    const auto n = static_cast< uint32_t >(capacity);
+    const auto c = static_cast< uint32_t >(mSlots.size());
+    // Make sure we don't discard any items
+    for (uint32_t i = n; i < c; ++i)
+    {
+        if (!mSlots[i].Empty())
+        {
+            STHROWF("Inventory slot ({}) is not empty", i);
+        }
+    }
+    mSlots.resize(n);
+    // Forget about changes in discarded slots
+    mDirty.erase(std::remove_if(mDirty.begin(), mDirty.end(), [n](uint32_t s) { return s >= n; }), mDirty.end());
+    // Make the new slots available
+    for (uint32_t i = c; i < n; ++i)
+    {
+        mEmpty.push_back(i);
+        std::push_heap(mEmpty.begin(), mEmpty.end(), std::greater< uint32_t >());
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Set(SQInteger slot, SQInteger item, SQInteger count)
+{
+    static_cast< void >(ValidSlot(slot));
+    const int32_t i = ValidItem(item);
+    const uint32_t n = ValidCount(count);
+    const auto s = static_cast< uint32_t >(slot);
+    // Does the stack fit?
+    if (n > StackLimit(i))
+    {
+        STHROWF("Stack of ({}) exceeds the limit ({}) of item ({})", n, StackLimit(i), i);
+    }
+    // Empty the slot first
+    if (!mSlots[s].Empty())
+    {
+        Vacate(s);
+    }
+    // Place the stack, if any
+    if (n > 0)
+    {
+        Occupy(s, i, n, nullptr, 0);
+    }
+    Touch(s);
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::SetCount(SQInteger slot, SQInteger count)
+{
+    InventorySlot & s = ValidSlot(slot);
+    const uint32_t n = ValidCount(count);
+    // Is there a stack to modify?
+    if (s.Empty())
+    {
+        STHROWF("Inventory slot ({}) is empty", slot);
+    }
+    // Should the slot be emptied?
+    else if (n == 0)
+    {
+        Vacate(static_cast< uint32_t >(slot));
+    }
+    // Does the stack fit?
+    else if (n > StackLimit(s.mItem))
+    {
+        STHROWF("Stack of ({}) exceeds the limit ({}) of item ({})", n, StackLimit(s.mItem), s.mItem);
+    }
+    else
+    {
+        s.mCount = n;
+    }
+    Touch(static_cast< uint32_t >(slot));
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::SetAttr(SQInteger slot, StackStrF & attr)
+{
+    InventorySlot & s = ValidSlot(slot);
+    const size_t len = ValidAttr(attr);
+    // Is there a stack to modify?
+    if (s.Empty())
+    {
+        STHROWF("Inventory slot ({}) is empty", slot);
+    }
+    s.mAttr.assign(attr.mPtr == nullptr ? "" : attr.mPtr, len);
+    Touch(static_cast< uint32_t >(slot));
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Clear(SQInteger slot)
+{
+    // Is there anything to clear?
+    if (!ValidSlot(slot).Empty())
+    {
+        Vacate(static_cast< uint32_t >(slot));
+        Touch(static_cast< uint32_t >(slot));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::ClearAll()
+{
+    for (uint32_t i = 0; i < mSlots.size(); ++i)
+    {
+        if (!mSlots[i].Empty())
+        {
+            Vacate(i);
+            Touch(i);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Swap(SQInteger a, SQInteger b)
+{
+    InventorySlot & x = ValidSlot(a);
+    InventorySlot & y = ValidSlot(b);
+    // Is there anything to swap?
+    if (a == b || (x.Empty() && y.Empty()))
+    {
+        return;
+    }
+    const auto sa = static_cast< uint32_t >(a), sb = static_cast< uint32_t >(b);
+    // Take the stacks out
+    InventorySlot tx(x), ty(y);
+    if (!x.Empty()) Vacate(sa);
+    if (!y.Empty()) Vacate(sb);
+    // Put them back in reverse
+    if (!ty.Empty()) Occupy(sa, ty.mItem, ty.mCount, ty.mAttr.data(), ty.mAttr.size());
+    if (!tx.Empty()) Occupy(sb, tx.mItem, tx.mCount, tx.mAttr.data(), tx.mAttr.size());
+    Touch(sa);
+    Touch(sb);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger InventoryManager::Move(SQInteger from, SQInteger to, SQInteger count)
+{
+    InventorySlot & src = ValidSlot(from);
+    InventorySlot & dst = ValidSlot(to);
+    uint32_t n = ValidCount(count);
+    // Is there anything to move?
+    if (from == to || src.Empty())
+    {
+        return 0;
+    }
+    // Zero or more than available means the whole stack
+    if (n == 0 || n > src.mCount)
+    {
+        n = src.mCount;
+    }
+    const auto sf = static_cast< uint32_t >(from), st = static_cast< uint32_t >(to);
+    // Is the destination empty?
+    if (dst.Empty())
+    {
+        const InventorySlot tmp(src);
+        Occupy(st, tmp.mItem, n, tmp.mAttr.data(), tmp.mAttr.size());
+        // Was the whole stack moved?
+        if (n == tmp.mCount)
+        {
+            Vacate(sf);
+        }
+        else
+        {
+            mSlots[sf].mCount -= n;
+        }
+    }
+    // Can the stacks be merged?
+    else if (dst.mItem == src.mItem && SameAttr(dst.mAttr, src.mAttr.data(), src.mAttr.size()))
+    {
+        const uint32_t limit = StackLimit(dst.mItem);
+        // Move only what fits
+        n = std::min(n, dst.mCount < limit ? limit - dst.mCount : 0u);
+        // Is there room for anything?
+        if (n == 0)
+        {
+            return 0;
+        }
+        dst.mCount += n;
+        src.mCount -= n;
+        // Was the whole stack moved?
+        if (src.mCount == 0)
+        {
+            Vacate(sf);
+        }
+    }
+    // Different stacks can only be exchanged as a whole
+    else if (n == src.mCount)
+    {
+        Swap(from, to);
+        return static_cast< SQInteger >(n);
+    }
+    else
+    {
+        return 0;
+    }
+    Touch(sf);
+    Touch(st);
+    // Return the number of moved items
+    return static_cast< SQInteger >(n);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger InventoryManager::Insert(int32_t item, uint32_t count, const char * attr, size_t len)
+{
+    const uint32_t limit = StackLimit(item);
+    // Fill the existing stacks first
+    auto itr = mIndex.find(item);
+    if (itr != mIndex.end())
+    {
+        for (const uint32_t s : itr->second)
+        {
+            InventorySlot & slot = mSlots[s];
+            // Can this stack take more items?
+            if (count == 0 || slot.mCount >= limit || !SameAttr(slot.mAttr, attr, len))
+            {
+                continue;
+            }
+            const uint32_t n = std::min(count, limit - slot.mCount);
+            slot.mCount += n;
+            count -= n;
+            Touch(s);
+        }
+    }
+    // Create new stacks with the remaining items
+    while (count > 0)
+    {
+        const int32_t s = NextEmpty();
+        // Is there any room left?
+        if (s < 0)
+        {
+            break;
+        }
+        const uint32_t n = std::min(count, limit);
+        Occupy(static_cast< uint32_t >(s), item, n, attr, len);
+        Touch(static_cast< uint32_t >(s));
+        count -= n;
+    }
+    // Return what did not fit
+    return static_cast< SQInteger >(count);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger InventoryManager::Remove(SQInteger item, SQInteger count)
+{
+    uint32_t n = ValidCount(count), removed = 0;
+    auto itr = mIndex.find(ValidItem(item));
+    // Is this item present?
+    if (itr == mIndex.end())
+    {
+        return 0;
+    }
+    // Vacating slots modifies the index
+    const std::vector< uint32_t > slots(itr->second);
+    // Take from the last stacks first
+    for (auto s = slots.rbegin(); s != slots.rend() && n > 0; ++s)
+    {
+        InventorySlot & slot = mSlots[*s];
+        const uint32_t r = std::min(n, slot.mCount);
+        slot.mCount -= r;
+        removed += r;
+        n -= r;
+        // Was the stack depleted?
+        if (slot.mCount == 0)
+        {
+            Vacate(*s);
+        }
+        Touch(*s);
+    }
+    // Return the number of removed items
+    return static_cast< SQInteger >(removed);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger InventoryManager::CountOf(SQInteger item) const
+{
+    auto itr = mIndex.find(static_cast< int32_t >(item));
+    // Is this item present?
+    if (itr == mIndex.end())
+    {
+        return 0;
+    }
+    SQInteger n = 0;
+    // Add up all stacks
+    for (const uint32_t s : itr->second)
+    {
+        n += mSlots[s].mCount;
+    }
+    return n;
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger InventoryManager::Find(SQInteger item) const
+{
+    auto itr = mIndex.find(static_cast< int32_t >(item));
+    // Slots are kept sorted so the first one is the lowest
+    return itr == mIndex.end() || itr->second.empty() ? -1 : static_cast< SQInteger >(itr->second.front());
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger InventoryManager::FindEmpty()
+{
+    return NextEmpty();
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::ClearChanged()
+{
+    for (const uint32_t s : mDirty)
+    {
+        mSlots[s].mDirty = false;
+    }
+    mDirty.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::WriteSlot(Buffer & b, uint32_t slot) const
+{
+    const InventorySlot & s = mSlots[slot];
+    b.Push< uint32_t >(slot);
+    b.Push< int32_t >(s.mItem);
+    // Empty slots have nothing else to write
+    if (!s.Empty())
+    {
+        b.Push< uint32_t >(s.mCount);
+        b.Push< uint16_t >(static_cast< uint16_t >(s.mAttr.size()));
+        b.Append(s.mAttr.data(), static_cast< Buffer::SzType >(s.mAttr.size()));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Snapshot(SqBuffer & buffer)
+{
+    Buffer & b = buffer.Valid();
+    // Write the header
+    b.Push< uint8_t >(INVENTORY_SNAPSHOT);
+    b.Push< uint32_t >(static_cast< uint32_t >(mSlots.size()));
+    b.Push< uint32_t >(mUsed);
+    // Write the occupied slots
+    for (uint32_t i = 0; i < mSlots.size(); ++i)
+    {
+        if (!mSlots[i].Empty())
+        {
+            WriteSlot(b, i);
+        }
+    }
+    // Everything was written
+    ClearChanged();
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Delta(SqBuffer & buffer)
+{
+    Buffer & b = buffer.Valid();
+    // Write the header
+    b.Push< uint8_t >(INVENTORY_DELTA);
+    b.Push< uint32_t >(static_cast< uint32_t >(mSlots.size()));
+    b.Push< uint32_t >(static_cast< uint32_t >(mDirty.size()));
+    // Write the changed slots
+    for (const uint32_t s : mDirty)
+    {
+        WriteSlot(b, s);
+    }
+    // The changes were written
+    ClearChanged();
+}
+
+// ------------------------------------------------------------------------------------------------
+void InventoryManager::Load(SqBuffer & buffer)
+{
+    Buffer & b = buffer.ValidDeeper();
+    // Read the header
+    const auto type = InventoryRead< uint8_t >(b);
+    const auto capacity = InventoryRead< uint32_t >(b);
+    const auto count = InventoryRead< uint32_t >(b);
+    // Validate the format
+    if (type != INVENTORY_SNAPSHOT && type != INVENTORY_DELTA)
+    {
+        STHROWF("Unknown inventory format ({})", static_cast< uint32_t >(type));
+    }
+    // Validate the capacity
+    else if (capacity > INVENTORY_CAPACITY_MAX)
+    {
+        STHROWF("Invalid inventory capacity ({})", capacity);
+    }
+    // Every slot record takes at least 8 bytes (slot and item)
+    else if (count > (b.Capacity() - b.Position()) / 8)
+    {
+        STHROWF("Inventory slot count ({}) exceeds the remaining buffer size ({})", count, b.Capacity() - b.Position());
+    }
+    // Load into a copy so that a malformed buffer leaves the inventory untouched
+    Slots slots;
+    // A snapshot replaces everything, a delta starts from the current slots
+    if (type == INVENTORY_DELTA)
+    {
+        slots = mSlots;
+    }
+    // Slots beyond the capacity are dropped
+    slots.resize(capacity);
+    // Read the slots
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const auto slot = InventoryRead< uint32_t >(b);
+        const auto item = InventoryRead< int32_t >(b);
+        // Validate the slot
+        if (slot >= capacity)
+        {
+            STHROWF("Inventory slot ({}) is out of capacity ({})", slot, capacity);
+        }
+        InventorySlot & s = slots[slot];
+        // Empty the slot first. The loaded state is the persisted one, so it's not a change
+        s.mItem = -1;
+        s.mCount = 0;
+        s.mAttr.clear();
+        s.mDirty = false;
+        // Was the slot emptied?
+        if (item < 0)
+        {
+            continue;
+        }
+        const auto n = InventoryRead< uint32_t >(b);
+        const auto len = InventoryRead< uint16_t >(b);
+        // Validate the stack
+        if (n == 0)
+        {
+            STHROWF("Inventory slot ({}) holds an empty stack of item ({})", slot, item);
+        }
+        else if (n > StackLimit(item))
+        {
+            STHROWF("Stack of ({}) exceeds the limit ({}) of item ({})", n, StackLimit(item), item);
+        }
+        // Validate the attributes
+        else if ((b.Position() + len) > b.Capacity())
+        {
+            STHROWF("Attributes of size ({}) starting at ({}) are out of buffer capacity ({})",
+                    len, b.Position(), b.Capacity());
+        }
+        s.mItem = item;
+        s.mCount = n;
+        s.mAttr.assign(&b.Cursor(), len);
+        b.Advance(len);
+    }
+    // Rebuild the item index and the empty slots (ascending order is already a valid heap)
+    Index index;
+    std::vector< uint32_t > empty;
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < capacity; ++i)
+    {
+        if (slots[i].Empty())
+        {
+            empty.push_back(i);
+        }
+        else
+        {
+            index[slots[i].mItem].push_back(i);
+            ++used;
+        }
+    }
+    // A snapshot represents the persisted state, a delta keeps the changes of the remaining slots
+    std::vector< uint32_t > dirty;
+    if (type == INVENTORY_DELTA)
+    {
+        std::copy_if(mDirty.begin(), mDirty.end(), std::back_inserter(dirty), [&](uint32_t s) {
+            return s < capacity && slots[s].mDirty;
+        });
+    }
+    // Everything was validated so replace the current state
+    mSlots.swap(slots);
+    mIndex.swap(index);
+    mEmpty.swap(empty);
+    mDirty.swap(dirty);
+    mUsed = used;
+}
 
 // ================================================================================================
 void Register_Inventory(HSQUIRRELVM vm)
 {
+    Table ns(vm);
+
+    // --------------------------------------------------------------------------------------------
+    ns.Bind(_SC("Manager"),
+        Class< InventoryManager, NoCopy< InventoryManager > >(vm, InventoryManagerTn::Str)
+        // Constructors
+        .Ctor()
+        .Ctor< SQInteger >()
+        // Meta-methods
+        .SquirrelFunc(_SC("_typename"), &InventoryManagerTn::Fn)
+        // Core Properties
+        .Prop(_SC("Tag"), &InventoryManager::GetTag, &InventoryManager::SetTag)
+        .Prop(_SC("Data"), &InventoryManager::GetData, &InventoryManager::SetData)
+        // Member Properties
+        .Prop(_SC("Capacity"), &InventoryManager::GetCapacity, &InventoryManager::Resize)
+        .Prop(_SC("Used"), &InventoryManager::GetUsed)
+        .Prop(_SC("Free"), &InventoryManager::GetFree)
+        .Prop(_SC("Changed"), &InventoryManager::GetChanged)
+        .Prop(_SC("DefaultStack"), &InventoryManager::GetDefaultStack, &InventoryManager::SetDefaultStack)
+        // Member Methods
+        .Func(_SC("Resize"), &InventoryManager::Resize)
+        .Func(_SC("GetStack"), &InventoryManager::GetStack)
+        .Func(_SC("SetStack"), &InventoryManager::SetStack)
+        .Func(_SC("GetItem"), &InventoryManager::GetItem)
+        .Func(_SC("GetCount"), &InventoryManager::GetCount)
+        .Func(_SC("GetAttr"), &InventoryManager::GetAttr)
+        .Func(_SC("IsEmpty"), &InventoryManager::IsEmpty)
+        .Func(_SC("IsChanged"), &InventoryManager::IsChanged)
+        .Func(_SC("Set"), &InventoryManager::Set)
+        .Func(_SC("SetCount"), &InventoryManager::SetCount)
+        .Func(_SC("SetAttr"), &InventoryManager::SetAttr)
+        .Func(_SC("Clear"), &InventoryManager::Clear)
+        .Func(_SC("ClearAll"), &InventoryManager::ClearAll)
+        .Func(_SC("Swap"), &InventoryManager::Swap)
+        .Func(_SC("Move"), &InventoryManager::Move)
+        .Func(_SC("Add"), &InventoryManager::Add)
+        .Func(_SC("AddEx"), &InventoryManager::AddEx)
+        .Func(_SC("Remove"), &InventoryManager::Remove)
+        .Func(_SC("CountOf"), &InventoryManager::CountOf)
+        .Func(_SC("Find"), &InventoryManager::Find)
+        .Func(_SC("FindEmpty"), &InventoryManager::FindEmpty)
+        .Func(_SC("ClearChanged"), &InventoryManager::ClearChanged)
+        .Func(_SC("Snapshot"), &InventoryManager::Snapshot)
+        .Func(_SC("Delta"), &InventoryManager::Delta)
+        .Func(_SC("Load"), &InventoryManager::Load)
+    );
 
+    RootTable(vm).Bind(_SC("SqInventory"), ns);
 }
 
 } // Namespace:: SqMod
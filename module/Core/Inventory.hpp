@@ -2,6 +2,7 @@
 
 // ------------------------------------------------------------------------------------------------
 #include "Core/Utility.hpp"
+#include "Core/Buffer.hpp"
 #include "Base/Vector3.hpp"
 #include "Base/Quaternion.hpp"
 
@@ -10,10 +11,49 @@
 #include <vector>
 #include <random>
 #include <chrono>
+#include <unordered_map>
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
+// ------------------------------------------------------------------------------------------------
+class SqBuffer;
+
+/* ------------------------------------------------------------------------------------------------
+ * Maximum size of the attribute blob associated with a slot.
+*/
+static constexpr size_t INVENTORY_ATTR_MAX = 0xFFFF;
+
+/* ------------------------------------------------------------------------------------------------
+ * Maximum number of slots in an inventory. Also keeps a malformed buffer from allocating too much.
+*/
+static constexpr uint32_t INVENTORY_CAPACITY_MAX = 0x100000;
+
+/* ------------------------------------------------------------------------------------------------
+ * Identifiers used to tell apart the serialized inventory formats.
+*/
+static constexpr uint8_t INVENTORY_SNAPSHOT = 'S';
+static constexpr uint8_t INVENTORY_DELTA = 'D';
+
+/* ------------------------------------------------------------------------------------------------
+ * Single slot from an inventory.
+*/
+struct InventorySlot
+{
+    int32_t     mItem{-1}; // Identifier of the item in this slot. Negative means empty.
+    uint32_t    mCount{0}; // Number of items in the stack.
+    String      mAttr{}; // Attribute blob associated with the stack.
+    bool        mDirty{false}; // Whether this slot changed since the last serialization.
+
+    /* --------------------------------------------------------------------------------------------
+     * See if this slot is empty.
+    */
+    SQMOD_NODISCARD bool Empty() const
+    {
+        return mItem < 0;
+    }
+};
+
 /* ------------------------------------------------------------------------------------------------
  * Built-in inventory.
 */
@@ -26,6 +66,15 @@ public:
     */
     InventoryManager() = default;
 
+    /* --------------------------------------------------------------------------------------------
+     * Base constructor.
+    */
+    explicit InventoryManager(SQInteger capacity)
+        : InventoryManager()
+    {
+        Resize(capacity);
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Copy constructor. (disabled)
     */
@@ -51,8 +100,358 @@ public:
     */
     InventoryManager & operator = (InventoryManager && o) = delete;
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the associated user tag.
+    */
+    SQMOD_NODISCARD const String & GetTag() const
+    {
+        return mTag;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the associated user tag.
+    */
+    void SetTag(StackStrF & tag)
+    {
+        mTag.assign(tag.mPtr, static_cast< size_t >(ClampMin(tag.mLen, SQInteger(0))));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the associated user data.
+    */
+    SQMOD_NODISCARD LightObj & GetData()
+    {
+        return mData;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the associated user data.
+    */
+    void SetData(LightObj & data)
+    {
+        mData = data;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of slots.
+    */
+    SQMOD_NODISCARD SQInteger GetCapacity() const
+    {
+        return static_cast< SQInteger >(mSlots.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Change the number of slots. Slots that would be discarded must be empty.
+    */
+    void Resize(SQInteger capacity);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of occupied slots.
+    */
+    SQMOD_NODISCARD SQInteger GetUsed() const
+    {
+        return static_cast< SQInteger >(mUsed);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of empty slots.
+    */
+    SQMOD_NODISCARD SQInteger GetFree() const
+    {
+        return static_cast< SQInteger >(mSlots.size() - mUsed);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of slots that changed since the last serialization.
+    */
+    SQMOD_NODISCARD SQInteger GetChanged() const
+    {
+        return static_cast< SQInteger >(mDirty.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the stack limit of items without an explicit limit.
+    */
+    SQMOD_NODISCARD SQInteger GetDefaultStack() const
+    {
+        return static_cast< SQInteger >(mDefaultStack);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the stack limit of items without an explicit limit.
+    */
+    void SetDefaultStack(SQInteger limit)
+    {
+        mDefaultStack = ValidLimit(limit);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the stack limit of an item.
+    */
+    SQMOD_NODISCARD SQInteger GetStack(SQInteger item) const
+    {
+        return static_cast< SQInteger >(StackLimit(static_cast< int32_t >(item)));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the stack limit of an item. Existing stacks are not affected.
+    */
+    void SetStack(SQInteger item, SQInteger limit)
+    {
+        mStacks[ValidItem(item)] = ValidLimit(limit);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the item in a slot. Returns -1 if the slot is empty.
+    */
+    SQMOD_NODISCARD SQInteger GetItem(SQInteger slot) const
+    {
+        return ValidSlot(slot).mItem;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of items in a slot.
+    */
+    SQMOD_NODISCARD SQInteger GetCount(SQInteger slot) const
+    {
+        return static_cast< SQInteger >(ValidSlot(slot).mCount);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the attribute blob of a slot.
+    */
+    SQMOD_NODISCARD const String & GetAttr(SQInteger slot) const
+    {
+        return ValidSlot(slot).mAttr;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * See if a slot is empty.
+    */
+    SQMOD_NODISCARD bool IsEmpty(SQInteger slot) const
+    {
+        return ValidSlot(slot).Empty();
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * See if a slot changed since the last serialization.
+    */
+    SQMOD_NODISCARD bool IsChanged(SQInteger slot) const
+    {
+        return ValidSlot(slot).mDirty;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Place a stack in a slot, replacing whatever was there.
+    */
+    void Set(SQInteger slot, SQInteger item, SQInteger count);
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the number of items in an occupied slot. A count of zero empties the slot.
+    */
+    void SetCount(SQInteger slot, SQInteger count);
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the attribute blob of an occupied slot.
+    */
+    void SetAttr(SQInteger slot, StackStrF & attr);
+
+    /* --------------------------------------------------------------------------------------------
+     * Empty a slot.
+    */
+    void Clear(SQInteger slot);
+
+    /* --------------------------------------------------------------------------------------------
+     * Empty all slots.
+    */
+    void ClearAll();
+
+    /* --------------------------------------------------------------------------------------------
+     * Exchange the contents of two slots.
+    */
+    void Swap(SQInteger a, SQInteger b);
+
+    /* --------------------------------------------------------------------------------------------
+     * Move items from one slot to another, merging or swapping stacks as needed. Returns the moved count.
+    */
+    SQInteger Move(SQInteger from, SQInteger to, SQInteger count);
+
+    /* --------------------------------------------------------------------------------------------
+     * Add items, filling existing stacks first. Returns the number of items that did not fit.
+    */
+    SQInteger Add(SQInteger item, SQInteger count)
+    {
+        return Insert(ValidItem(item), ValidCount(count), nullptr, 0);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Add items with the specified attributes. Only stacks with identical attributes are merged.
+    */
+    SQInteger AddEx(SQInteger item, SQInteger count, StackStrF & attr)
+    {
+        return Insert(ValidItem(item), ValidCount(count), attr.mPtr, ValidAttr(attr));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Remove items, starting with the last stacks. Returns the number of removed items.
+    */
+    SQInteger Remove(SQInteger item, SQInteger count);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the total number of items of a certain type.
+    */
+    SQMOD_NODISCARD SQInteger CountOf(SQInteger item) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the first slot with a certain item. Returns -1 if there is none.
+    */
+    SQMOD_NODISCARD SQInteger Find(SQInteger item) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the first empty slot. Returns -1 if there is none.
+    */
+    SQMOD_NODISCARD SQInteger FindEmpty();
+
+    /* --------------------------------------------------------------------------------------------
+     * Forget about the changes since the last serialization.
+    */
+    void ClearChanged();
+
+    /* --------------------------------------------------------------------------------------------
+     * Write all occupied slots to a buffer and forget about the changes.
+    */
+    void Snapshot(SqBuffer & buffer);
+
+    /* --------------------------------------------------------------------------------------------
+     * Write only the slots that changed since the last serialization to a buffer.
+    */
+    void Delta(SqBuffer & buffer);
+
+    /* --------------------------------------------------------------------------------------------
+     * Apply a snapshot or a delta from a buffer. Loaded slots are not marked as changed.
+    */
+    void Load(SqBuffer & buffer);
+
 private:
 
+    // --------------------------------------------------------------------------------------------
+    using Slots = std::vector< InventorySlot >;
+    using Index = std::unordered_map< int32_t, std::vector< uint32_t > >;
+    using Stacks = std::unordered_map< int32_t, uint32_t >;
+
+    // --------------------------------------------------------------------------------------------
+    Slots                   mSlots{}; // Inventory slots.
+    Index                   mIndex{}; // Occupied slots of each item.
+    Stacks                  mStacks{}; // Stack limit of each item.
+    std::vector< uint32_t > mEmpty{}; // Empty slots (min-heap, may contain stale entries).
+    std::vector< uint32_t > mDirty{}; // Slots that changed since the last serialization.
+    uint32_t                mUsed{0}; // Number of occupied slots.
+    uint32_t                mDefaultStack{1}; // Stack limit of items without an explicit limit.
+
+    // --------------------------------------------------------------------------------------------
+    String                  mTag{}; // User tag associated with this instance.
+    LightObj                mData{}; // User data associated with this instance.
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the stack limit of an item.
+    */
+    SQMOD_NODISCARD uint32_t StackLimit(int32_t item) const
+    {
+        auto itr = mStacks.find(item);
+        // Use the default limit if there's no explicit limit
+        return itr == mStacks.end() ? mDefaultStack : itr->second;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Validate an item identifier.
+    */
+    SQMOD_NODISCARD static int32_t ValidItem(SQInteger item)
+    {
+        if (item < 0 || item > INT32_MAX)
+        {
+            STHROWF("Invalid inventory item ({})", item);
+        }
+        return static_cast< int32_t >(item);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Validate an item count.
+    */
+    SQMOD_NODISCARD static uint32_t ValidCount(SQInteger count)
+    {
+        if (count < 0 || count > UINT32_MAX)
+        {
+            STHROWF("Invalid inventory item count ({})", count);
+        }
+        return static_cast< uint32_t >(count);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Validate a stack limit.
+    */
+    SQMOD_NODISCARD static uint32_t ValidLimit(SQInteger limit)
+    {
+        if (limit < 1 || limit > UINT32_MAX)
+        {
+            STHROWF("Invalid inventory stack limit ({})", limit);
+        }
+        return static_cast< uint32_t >(limit);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Validate an attribute blob and return its size.
+    */
+    SQMOD_NODISCARD static size_t ValidAttr(StackStrF & attr)
+    {
+        if (attr.mLen < 0 || static_cast< size_t >(attr.mLen) > INVENTORY_ATTR_MAX)
+        {
+            STHROWF("Invalid inventory attribute size ({})", attr.mLen);
+        }
+        return static_cast< size_t >(attr.mLen);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve a slot or throw an exception if it doesn't exist.
+    */
+    SQMOD_NODISCARD InventorySlot & ValidSlot(SQInteger slot);
+    SQMOD_NODISCARD const InventorySlot & ValidSlot(SQInteger slot) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Remember that a slot changed.
+    */
+    void Touch(uint32_t slot)
+    {
+        if (!mSlots[slot].mDirty)
+        {
+            mSlots[slot].mDirty = true;
+            mDirty.push_back(slot);
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Place a stack in an empty slot.
+    */
+    void Occupy(uint32_t slot, int32_t item, uint32_t count, const char * attr, size_t len);
+
+    /* --------------------------------------------------------------------------------------------
+     * Empty an occupied slot.
+    */
+    void Vacate(uint32_t slot);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the first empty slot. Returns -1 if there is none.
+    */
+    SQMOD_NODISCARD int32_t NextEmpty();
+
+    /* --------------------------------------------------------------------------------------------
+     * Add items, filling existing stacks with identical attributes first.
+    */
+    SQInteger Insert(int32_t item, uint32_t count, const char * attr, size_t len);
+
+    /* --------------------------------------------------------------------------------------------
+     * Write a single slot to a buffer.
+    */
+    void WriteSlot(Buffer & b, uint32_t slot) const;
 };
 
 } // Namespace:: SqMod
@@ -1,19 +1,685 @@
 // ------------------------------------------------------------------------------------------------
 #include "Core/Loot.hpp"
+#include "Core.hpp"
 
 // ------------------------------------------------------------------------------------------------
 #include <cstring>
+#include <algorithm>
+#include <functional>
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
 // ------------------------------------------------------------------------------------------------
+SQMOD_DECL_TYPENAME(LootManagerTn, _SC("SqLootManager"))
 
+// ------------------------------------------------------------------------------------------------
+static constexpr uint64_t LOOT_REGION_MASK = (uint64_t(1) << LOOT_REGION_BITS) - 1;
+static constexpr uint64_t LOOT_CLUSTER_MASK = (uint64_t(1) << LOOT_CLUSTER_BITS) - 1;
+static constexpr uint64_t LOOT_SPAWN_MASK = (uint64_t(1) << LOOT_SPAWN_BITS) - 1;
+
+// ------------------------------------------------------------------------------------------------
+void TerminateLoot()
+{
+    // Go over all managers and release their script resources
+    for (LootManager * inst = LootManager::sHead; inst && inst->mNext != LootManager::sHead; inst = inst->mNext)
+    {
+        inst->Terminate();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ProcessLoot()
+{
+    // Go over all managers and update their regions and timers
+    for (LootManager * inst = LootManager::sHead; inst && inst->mNext != LootManager::sHead; inst = inst->mNext)
+    {
+        inst->Process();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootRegion::SetWeight(uint32_t factory, double weight)
+{
+    auto itr = std::find_if(mWeights.begin(), mWeights.end(),
+                            [factory](const std::pair< uint32_t, double > & w) { return w.first == factory; });
+    // Should the factory be removed?
+    if (weight <= 0.0)
+    {
+        if (itr != mWeights.end())
+        {
+            mWeights.erase(itr);
+        }
+    }
+    // Should the factory be added?
+    else if (itr == mWeights.end())
+    {
+        mWeights.emplace_back(factory, weight);
+    }
+    // Just update the weight
+    else
+    {
+        itr->second = weight;
+    }
+    // The alias table must be rebuilt before the next roll
+    mDirty = true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootRegion::Build()
+{
+    const size_t n = mWeights.size();
+    // Reset the tables
+    mProb.assign(n, 0.0);
+    mAlias.assign(n, 0);
+    mDirty = false;
+    // Anything to build?
+    if (n == 0)
+    {
+        return;
+    }
+    double total = 0.0;
+    // Compute the sum of the weights
+    for (const auto & w : mWeights)
+    {
+        total += w.second;
+    }
+    std::vector< double > scaled(n);
+    std::vector< uint32_t > small, large;
+    small.reserve(n);
+    large.reserve(n);
+    // Scale the weights so that their average is one and sort them by size
+    for (size_t i = 0; i < n; ++i)
+    {
+        scaled[i] = (mWeights[i].second * static_cast< double >(n)) / total;
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast< uint32_t >(i));
+    }
+    // Pair each small entry with a large one
+    while (!small.empty() && !large.empty())
+    {
+        const uint32_t s = small.back(), l = large.back();
+        small.pop_back();
+        large.pop_back();
+        mProb[s] = scaled[s];
+        mAlias[s] = l;
+        // Give the large entry what the small one didn't use
+        scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+        (scaled[l] < 1.0 ? small : large).push_back(l);
+    }
+    // Whatever is left has a probability of one (save for rounding errors)
+    for (const uint32_t i : large)
+    {
+        mProb[i] = 1.0;
+    }
+    for (const uint32_t i : small)
+    {
+        mProb[i] = 1.0;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+int32_t LootRegion::Roll(std::mt19937 & rng)
+{
+    // Rebuild the alias table, if necessary
+    if (mDirty)
+    {
+        Build();
+    }
+    // Anything to choose from?
+    if (mProb.empty())
+    {
+        return -1;
+    }
+    // Pick a column and then choose between it and its alias
+    const auto i = std::uniform_int_distribution< uint32_t >(0, static_cast< uint32_t >(mProb.size() - 1))(rng);
+    const bool keep = std::uniform_real_distribution< double >(0.0, 1.0)(rng) < mProb[i];
+    // Retrieve the factory from the chosen column
+    return static_cast< int32_t >(mWeights[keep ? i : mAlias[i]].first);
+}
+
+// ------------------------------------------------------------------------------------------------
+LootManager::LootManager()
+    : mRng(std::random_device{}())
+{
+    // Remember this instance
+    ChainInstance();
+}
+
+// ------------------------------------------------------------------------------------------------
+LootManager::~LootManager()
+{
+    // Release script resources
+    Terminate();
+    // Forget about this instance
+    UnchainInstance();
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Terminate()
+{
+    // Release items without notifying the script
+    for (auto & region : mRegions)
+    {
+        region.mData.Release();
+        for (auto & cluster : region.mClusters)
+        {
+            for (auto & spawn : cluster.mSpawns)
+            {
+                spawn.mItem.Release();
+            }
+        }
+    }
+    // Release factories
+    for (auto & factory : mFactories)
+    {
+        factory.Release();
+    }
+    // Release everything else
+    mFactories.clear();
+    mRegions.clear();
+    mTimers.clear();
+    mSpawned = 0;
+    mData.Release();
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger LootManager::GetActive() const
+{
+    return static_cast< SQInteger >(std::count_if(mRegions.begin(), mRegions.end(),
+                                                  [](const LootRegion & r) { return r.mActive; }));
+}
+
+// ------------------------------------------------------------------------------------------------
+LootFactory & LootManager::ValidFactory(SQInteger factory)
+{
+    if (factory < 0 || static_cast< size_t >(factory) >= mFactories.size())
+    {
+        STHROWF("Invalid loot factory ({})", factory);
+    }
+    return mFactories[static_cast< size_t >(factory)];
+}
+
+// ------------------------------------------------------------------------------------------------
+const LootFactory & LootManager::ValidFactory(SQInteger factory) const
+{
+    if (factory < 0 || static_cast< size_t >(factory) >= mFactories.size())
+    {
+        STHROWF("Invalid loot factory ({})", factory);
+    }
+    return mFactories[static_cast< size_t >(factory)];
+}
+
+// ------------------------------------------------------------------------------------------------
+LootRegion & LootManager::ValidRegion(SQInteger region)
+{
+    if (region < 0 || static_cast< size_t >(region) >= mRegions.size())
+    {
+        STHROWF("Invalid loot region ({})", region);
+    }
+    return mRegions[static_cast< size_t >(region)];
+}
+
+// ------------------------------------------------------------------------------------------------
+const LootRegion & LootManager::ValidRegion(SQInteger region) const
+{
+    if (region < 0 || static_cast< size_t >(region) >= mRegions.size())
+    {
+        STHROWF("Invalid loot region ({})", region);
+    }
+    return mRegions[static_cast< size_t >(region)];
+}
+
+// ------------------------------------------------------------------------------------------------
+LootSpawn * LootManager::FindSpawn(SQInteger key)
+{
+    // Negative keys are never valid
+    if (key < 0)
+    {
+        return nullptr;
+    }
+    const auto k = static_cast< uint64_t >(key);
+    // Extract the components of the key
+    const size_t r = (k >> (LOOT_CLUSTER_BITS + LOOT_SPAWN_BITS)) & LOOT_REGION_MASK;
+    const size_t c = (k >> LOOT_SPAWN_BITS) & LOOT_CLUSTER_MASK;
+    const size_t s = k & LOOT_SPAWN_MASK;
+    // Validate each component
+    if (r >= mRegions.size() || c >= mRegions[r].mClusters.size() || s >= mRegions[r].mClusters[c].mSpawns.size())
+    {
+        return nullptr;
+    }
+    return &mRegions[r].mClusters[c].mSpawns[s];
+}
+
+// ------------------------------------------------------------------------------------------------
+LootSpawn & LootManager::ValidSpawn(SQInteger key)
+{
+    LootSpawn * spawn = FindSpawn(key);
+    // Does this spawn exist?
+    if (spawn == nullptr)
+    {
+        STHROWF("Invalid loot spawn key ({})", key);
+    }
+    return *spawn;
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger LootManager::AddFactory(SQInteger id, SQInteger type, SQInteger cls, Function & create, Function & destroy)
+{
+    ValidateUnlocked();
+    // Create the factory
+    mFactories.emplace_back();
+    LootFactory & f = mFactories.back();
+    f.mID = id;
+    f.mType = type;
+    f.mClass = cls;
+    f.mCreate = create;
+    f.mDelete = destroy;
+    // Return the index of the factory
+    return static_cast< SQInteger >(mFactories.size() - 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger LootManager::AddRegion(const Vector3 & center, SQFloat radius, SQInteger world)
+{
+    ValidateUnlocked();
+    // Is there room for another region?
+    if (mRegions.size() > LOOT_REGION_MASK)
+    {
+        STHROWF("Reached the maximum number of loot regions ({})", LOOT_REGION_MASK + 1);
+    }
+    // Create the region
+    mRegions.emplace_back(center, static_cast< Vector3::Value >(radius), static_cast< int32_t >(world));
+    // Check the activation of the new region as soon as possible
+    mNextActivation = 0;
+    // Return the index of the region
+    return static_cast< SQInteger >(mRegions.size() - 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::SetRegionItem(SQInteger region, SQInteger factory, SQFloat weight)
+{
+    // Make sure the factory exists
+    static_cast< void >(ValidFactory(factory));
+    // Update the weight
+    ValidRegion(region).SetWeight(static_cast< uint32_t >(factory), static_cast< double >(weight));
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger LootManager::AddCluster(SQInteger region, SQInteger limit)
+{
+    ValidateUnlocked();
+    LootRegion & r = ValidRegion(region);
+    // Is there room for another cluster?
+    if (r.mClusters.size() > LOOT_CLUSTER_MASK)
+    {
+        STHROWF("Reached the maximum number of clusters in loot region ({})", LOOT_CLUSTER_MASK + 1);
+    }
+    // Create the cluster
+    r.mClusters.emplace_back(static_cast< uint32_t >(ClampMin(limit, SQInteger(0))));
+    // Return the index of the cluster
+    return static_cast< SQInteger >(r.mClusters.size() - 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger LootManager::AddSpawn(SQInteger region, SQInteger cluster, const Vector3 & pos)
+{
+    ValidateUnlocked();
+    LootRegion & r = ValidRegion(region);
+    // Make sure the cluster exists
+    if (cluster < 0 || static_cast< size_t >(cluster) >= r.mClusters.size())
+    {
+        STHROWF("Invalid loot cluster ({})", cluster);
+    }
+    LootCluster & c = r.mClusters[static_cast< size_t >(cluster)];
+    // Is there room for another spawn?
+    if (c.mSpawns.size() > LOOT_SPAWN_MASK)
+    {
+        STHROWF("Reached the maximum number of spawns in loot cluster ({})", LOOT_SPAWN_MASK + 1);
+    }
+    // Create the spawn
+    c.mSpawns.emplace_back(pos);
+    // Generate the key of the spawn
+    const SQInteger key = MakeKey(static_cast< size_t >(region), static_cast< size_t >(cluster), c.mSpawns.size() - 1);
+    // Fill the spawn on the next frame
+    Schedule(key, c.mSpawns.back(), 0);
+    // Return the key of the spawn
+    return key;
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Schedule(SQInteger key, LootSpawn & spawn, int64_t deadline)
+{
+    spawn.mWaiting = true;
+    spawn.mDue = false;
+    // Insert the timer into the heap
+    mTimers.push_back(Timer{deadline, key});
+    std::push_heap(mTimers.begin(), mTimers.end(), std::greater< Timer >());
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Materialize(SQInteger key)
+{
+    LootSpawn * spawn = FindSpawn(key);
+    // Is there anything to create?
+    if (spawn == nullptr || spawn->mFactory < 0 || !spawn->mItem.IsNull())
+    {
+        return;
+    }
+    LootFactory & f = mFactories[static_cast< size_t >(spawn->mFactory)];
+    // Anyone willing to create the item?
+    if (f.mCreate.IsNull())
+    {
+        return;
+    }
+    const Vector3 pos = spawn->mPos;
+    LightObj item;
+    // Prevent layout changes while the callback runs
+    const bool locked = mLocked;
+    mLocked = true;
+    try
+    {
+        item = f.mCreate.Eval(key, f.mID, pos);
+    }
+    catch (const std::exception & e)
+    {
+        LogErr("Failed to create loot item (%" PRINT_INT_FMT ") at spawn (%" PRINT_INT_FMT "): %s", f.mID, key, e.what());
+    }
+    mLocked = locked;
+    // Store the item into the spawn
+    spawn = FindSpawn(key);
+    // Was the spawn emptied or cleared by the callback?
+    if (spawn != nullptr && spawn->mFactory >= 0)
+    {
+        spawn->mItem = std::move(item);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Dematerialize(SQInteger key)
+{
+    LootSpawn * spawn = FindSpawn(key);
+    // Is there anything to delete?
+    if (spawn == nullptr || spawn->mFactory < 0)
+    {
+        return;
+    }
+    // Take ownership of the item
+    LightObj item(std::move(spawn->mItem));
+    spawn->mItem.Release();
+    LootFactory & f = mFactories[static_cast< size_t >(spawn->mFactory)];
+    // Was the item created and is anyone willing to delete it?
+    if (item.IsNull() || f.mDelete.IsNull())
+    {
+        return;
+    }
+    // Prevent layout changes while the callback runs
+    const bool locked = mLocked;
+    mLocked = true;
+    try
+    {
+        f.mDelete.Execute(key, f.mID, item);
+    }
+    catch (const std::exception & e)
+    {
+        LogErr("Failed to delete loot item (%" PRINT_INT_FMT ") at spawn (%" PRINT_INT_FMT "): %s", f.mID, key, e.what());
+    }
+    mLocked = locked;
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Fill(SQInteger key, int64_t now)
+{
+    const auto k = static_cast< uint64_t >(key);
+    LootRegion & r = mRegions[(k >> (LOOT_CLUSTER_BITS + LOOT_SPAWN_BITS)) & LOOT_REGION_MASK];
+    LootCluster & c = r.mClusters[(k >> LOOT_SPAWN_BITS) & LOOT_CLUSTER_MASK];
+    LootSpawn & s = c.mSpawns[k & LOOT_SPAWN_MASK];
+    // Is the spawn already occupied?
+    if (s.mFactory >= 0)
+    {
+        return;
+    }
+    // Is the cluster saturated? Try again later
+    if (!c.Available())
+    {
+        Schedule(key, s, now + r.mRespawn);
+        return;
+    }
+    // Pick an item for this spawn
+    const int32_t factory = r.Roll(mRng);
+    // Is there anything to spawn in this region? Try again later
+    if (factory < 0)
+    {
+        Schedule(key, s, now + r.mRespawn);
+        return;
+    }
+    // Occupy the spawn
+    s.mFactory = factory;
+    ++c.mOccupied;
+    ++mSpawned;
+    // Create the item
+    Materialize(key);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool LootManager::Empty(SQInteger key, bool notify)
+{
+    LootSpawn & s = ValidSpawn(key);
+    // Is the spawn occupied?
+    if (s.mFactory < 0)
+    {
+        return false;
+    }
+    // Delete the item, if requested
+    if (notify)
+    {
+        Dematerialize(key);
+    }
+    // Did the callback clear the manager?
+    LootSpawn * spawn = FindSpawn(key);
+    // Is the spawn still occupied?
+    if (spawn == nullptr || spawn->mFactory < 0)
+    {
+        return false;
+    }
+    const auto k = static_cast< uint64_t >(key);
+    LootRegion & r = mRegions[(k >> (LOOT_CLUSTER_BITS + LOOT_SPAWN_BITS)) & LOOT_REGION_MASK];
+    LootCluster & c = r.mClusters[(k >> LOOT_SPAWN_BITS) & LOOT_CLUSTER_MASK];
+    // Free the spawn
+    spawn->mItem.Release();
+    spawn->mFactory = -1;
+    --c.mOccupied;
+    --mSpawned;
+    // Start the respawn timer
+    Schedule(key, *spawn, Now() + r.mRespawn);
+    // The spawn was emptied
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::UpdateActivation(int64_t now)
+{
+    mNextActivation = now + mActivation;
+    mPlayers.clear();
+    mWorlds.clear();
+    // Gather player positions once for all regions
+    ForeachActivePlayer([this](const PlayerInst & p) {
+        Vector3 pos;
+        _Func->GetPlayerPosition(p.mID, &pos.x, &pos.y, &pos.z);
+        mPlayers.push_back(pos);
+        mWorlds.push_back(_Func->GetPlayerWorld(p.mID));
+    });
+    // Check each region
+    for (size_t r = 0; r < mRegions.size(); ++r)
+    {
+        bool active = false;
+        {
+            const LootRegion & region = mRegions[r];
+            const Vector3::Value range = region.mRadius * region.mRadius;
+            // Is there any player close enough?
+            for (size_t p = 0; p < mPlayers.size() && !active; ++p)
+            {
+                active = (region.mWorld < 0 || region.mWorld == mWorlds[p]) &&
+                         region.mCenter.GetSquaredDistanceTo(mPlayers[p]) <= range;
+            }
+            // Did the state change?
+            if (active == region.mActive)
+            {
+                continue;
+            }
+        }
+        mRegions[r].mActive = active;
+        // Go over each spawn in the region (callbacks cannot change the layout)
+        for (size_t c = 0; c < mRegions[r].mClusters.size(); ++c)
+        {
+            for (size_t s = 0; s < mRegions[r].mClusters[c].mSpawns.size(); ++s)
+            {
+                const SQInteger key = MakeKey(r, c, s);
+                // Was the region activated?
+                if (active)
+                {
+                    LootSpawn & spawn = mRegions[r].mClusters[c].mSpawns[s];
+                    // Did the respawn timer expire while the region was inactive?
+                    if (spawn.mDue)
+                    {
+                        spawn.mDue = false;
+                        Fill(key, now);
+                    }
+                    // Restore the item that was there before
+                    else
+                    {
+                        Materialize(key);
+                    }
+                }
+                // Remove the item but remember what was there
+                else
+                {
+                    Dematerialize(key);
+                }
+                // Did a callback clear the manager?
+                if (r >= mRegions.size())
+                {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Process()
+{
+    // Ignore managers without regions
+    if (mRegions.empty())
+    {
+        return;
+    }
+    const int64_t now = Now();
+    // Is it time to check which regions should be active?
+    if (now >= mNextActivation)
+    {
+        UpdateActivation(now);
+    }
+    // Process expired timers
+    while (!mTimers.empty() && mTimers.front().mDeadline <= now)
+    {
+        const SQInteger key = mTimers.front().mKey;
+        // Remove the timer from the heap
+        std::pop_heap(mTimers.begin(), mTimers.end(), std::greater< Timer >());
+        mTimers.pop_back();
+        LootSpawn * spawn = FindSpawn(key);
+        // Does the spawn still exist?
+        if (spawn == nullptr || !spawn->mWaiting)
+        {
+            continue;
+        }
+        spawn->mWaiting = false;
+        const auto region = (static_cast< uint64_t >(key) >> (LOOT_CLUSTER_BITS + LOOT_SPAWN_BITS)) & LOOT_REGION_MASK;
+        // Fill the spawn now only if someone is around to see it
+        if (mRegions[region].mActive)
+        {
+            Fill(key, now);
+        }
+        else
+        {
+            spawn->mDue = true;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void LootManager::Clear()
+{
+    ValidateUnlocked();
+    // Delete all items that exist in the world
+    for (size_t r = 0; r < mRegions.size(); ++r)
+    {
+        // Only active regions have items in the world
+        if (!mRegions[r].mActive)
+        {
+            continue;
+        }
+        for (size_t c = 0; c < mRegions[r].mClusters.size(); ++c)
+        {
+            for (size_t s = 0; s < mRegions[r].mClusters[c].mSpawns.size(); ++s)
+            {
+                Dematerialize(MakeKey(r, c, s));
+            }
+        }
+    }
+    // Release everything
+    for (auto & factory : mFactories)
+    {
+        factory.Release();
+    }
+    mFactories.clear();
+    mRegions.clear();
+    mTimers.clear();
+    mSpawned = 0;
+}
 
 // ================================================================================================
 void Register_Loot(HSQUIRRELVM vm)
 {
+    Table ns(vm);
+
+    // --------------------------------------------------------------------------------------------
+    ns.Bind(_SC("Manager"),
+        Class< LootManager, NoCopy< LootManager > >(vm, LootManagerTn::Str)
+        // Constructors
+        .Ctor()
+        // Meta-methods
+        .SquirrelFunc(_SC("_typename"), &LootManagerTn::Fn)
+        // Core Properties
+        .Prop(_SC("Tag"), &LootManager::GetTag, &LootManager::SetTag)
+        .Prop(_SC("Data"), &LootManager::GetData, &LootManager::SetData)
+        // Member Properties
+        .Prop(_SC("ActivationInterval"), &LootManager::GetActivationInterval, &LootManager::SetActivationInterval)
+        .Prop(_SC("Factories"), &LootManager::GetFactories)
+        .Prop(_SC("Regions"), &LootManager::GetRegions)
+        .Prop(_SC("Active"), &LootManager::GetActive)
+        .Prop(_SC("Spawned"), &LootManager::GetSpawned)
+        .Prop(_SC("Pending"), &LootManager::GetPending)
+        // Member Methods
+        .Func(_SC("SetSeed"), &LootManager::SetSeed)
+        .CbFunc(_SC("AddFactory"), &LootManager::AddFactory)
+        .Func(_SC("FactoryID"), &LootManager::GetFactoryID)
+        .Func(_SC("GetFactoryData"), &LootManager::GetFactoryData)
+        .Func(_SC("SetFactoryData"), &LootManager::SetFactoryData)
+        .Func(_SC("AddRegion"), &LootManager::AddRegion)
+        .Func(_SC("RegionRespawn"), &LootManager::SetRegionRespawn)
+        .Func(_SC("RegionItem"), &LootManager::SetRegionItem)
+        .Func(_SC("RegionActive"), &LootManager::IsRegionActive)
+        .Func(_SC("AddCluster"), &LootManager::AddCluster)
+        .Func(_SC("AddSpawn"), &LootManager::AddSpawn)
+        .Func(_SC("GetItem"), &LootManager::GetItem)
+        .Func(_SC("ItemFactory"), &LootManager::GetItemFactory)
+        .Func(_SC("SpawnPosition"), &LootManager::GetSpawnPosition)
+        .Func(_SC("Take"), &LootManager::Take)
+        .Func(_SC("Remove"), &LootManager::Remove)
+        .Func(_SC("Clear"), &LootManager::Clear)
+    );
 
+    RootTable(vm).Bind(_SC("SqLoot"), ns);
 }
 
 } // Namespace:: SqMod
@@ -14,6 +14,13 @@
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
+/* ------------------------------------------------------------------------------------------------
+ * Number of bits used by each component of a loot spawn key.
+*/
+static constexpr uint32_t LOOT_REGION_BITS = 20;
+static constexpr uint32_t LOOT_CLUSTER_BITS = 20;
+static constexpr uint32_t LOOT_SPAWN_BITS = 24;
+
 /* ------------------------------------------------------------------------------------------------
  * Defines the type of loot and is responsible for creating and destroying the associated item.
 */
@@ -61,6 +68,16 @@ struct LootFactory
      * Copy assignment operator. (disabled)
     */
     LootFactory & operator = (LootFactory && o) noexcept = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Release script resources.
+    */
+    void Release()
+    {
+        mData.Release();
+        mCreate.Release();
+        mDelete.Release();
+    }
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -69,12 +86,24 @@ struct LootFactory
 struct LootSpawn
 {
     Vector3     mPos; // Spawn position
+    LightObj    mItem{}; // Object returned by the factory when the item was created.
+    int32_t     mFactory{-1}; // Factory of the item that occupies this spawn, if any.
+    bool        mWaiting{false}; // Whether a respawn timer is pending.
+    bool        mDue{false}; // Whether the respawn timer expired while the region was inactive.
 
     /* --------------------------------------------------------------------------------------------
      * Default constructor.
     */
     LootSpawn() = default;
 
+    /* --------------------------------------------------------------------------------------------
+     * Base constructor.
+    */
+    explicit LootSpawn(const Vector3 & pos)
+        : mPos(pos)
+    {
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Copy constructor. (disabled)
     */
@@ -104,16 +133,26 @@ struct LootSpawn
 /* ------------------------------------------------------------------------------------------------
  * Defines a cluster of loot spawns with little space in between where associated items can be spawned.
 */
-class LootCluster
+struct LootCluster
 {
     // --------------------------------------------------------------------------------------------
-    LightObj    mData; // User data associated with this instance.
+    std::vector< LootSpawn >    mSpawns{}; // Spawns from this cluster.
+    uint32_t                    mLimit{0}; // Maximum number of occupied spawns. Zero means no limit.
+    uint32_t                    mOccupied{0}; // Number of occupied spawns.
 
     /* --------------------------------------------------------------------------------------------
      * Default constructor.
     */
     LootCluster() = default;
 
+    /* --------------------------------------------------------------------------------------------
+     * Base constructor.
+    */
+    explicit LootCluster(uint32_t limit)
+        : mLimit(limit)
+    {
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Copy constructor. (disabled)
     */
@@ -138,22 +177,54 @@ class LootCluster
      * Copy assignment operator. (disabled)
     */
     LootCluster & operator = (LootCluster && o) noexcept = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * See if another spawn from this cluster can be occupied.
+    */
+    SQMOD_NODISCARD bool Available() const
+    {
+        return mLimit == 0 || mOccupied < mLimit;
+    }
 };
 
 /* ------------------------------------------------------------------------------------------------
  * Defines a region of loot clusters where various attributes can be influenced globally.
 */
-class LootRegion
+struct LootRegion
 {
     // --------------------------------------------------------------------------------------------
     String      mTag; // User tag associated with this instance.
     LightObj    mData; // User data associated with this instance.
 
+    // --------------------------------------------------------------------------------------------
+    Vector3     mCenter{}; // Center of the activation area.
+    Vector3::Value mRadius{0}; // Radius of the activation area.
+    int32_t     mWorld{-1}; // World in which players activate this region. Negative means any.
+    int64_t     mRespawn{60000}; // Milliseconds before an emptied spawn receives a new item.
+    bool        mActive{false}; // Whether there are players near this region.
+
+    // --------------------------------------------------------------------------------------------
+    std::vector< LootCluster >  mClusters{}; // Clusters from this region.
+
+    // --------------------------------------------------------------------------------------------
+    std::vector< std::pair< uint32_t, double > >    mWeights{}; // Factory and weight of each item.
+    std::vector< double >                           mProb{}; // Alias table probabilities.
+    std::vector< uint32_t >                         mAlias{}; // Alias table aliases.
+    bool                                            mDirty{false}; // Whether the alias table must be rebuilt.
+
     /* --------------------------------------------------------------------------------------------
      * Default constructor.
     */
     LootRegion() = default;
 
+    /* --------------------------------------------------------------------------------------------
+     * Base constructor.
+    */
+    LootRegion(const Vector3 & center, Vector3::Value radius, int32_t world)
+        : mTag(), mData(), mCenter(center), mRadius(radius), mWorld(world)
+    {
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Copy constructor. (disabled)
     */
@@ -178,19 +249,34 @@ class LootRegion
      * Copy assignment operator. (disabled)
     */
     LootRegion & operator = (LootRegion && o) noexcept = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the weight of a factory in this region. A weight of zero removes the factory.
+    */
+    void SetWeight(uint32_t factory, double weight);
+
+    /* --------------------------------------------------------------------------------------------
+     * Rebuild the alias table from the current weights (Vose's method).
+    */
+    void Build();
+
+    /* --------------------------------------------------------------------------------------------
+     * Pick a factory according to the weights. Returns -1 if there are no weights.
+    */
+    SQMOD_NODISCARD int32_t Roll(std::mt19937 & rng);
 };
 
 /* ------------------------------------------------------------------------------------------------
  * Loot distribution utility.
 */
-class LootManager
+class LootManager : public SqChainedInstances< LootManager >
 {
 public:
 
     /* --------------------------------------------------------------------------------------------
      * Default constructor.
     */
-    LootManager() = default;
+    LootManager();
 
     /* --------------------------------------------------------------------------------------------
      * Copy constructor. (disabled)
@@ -205,7 +291,7 @@ public:
     /* --------------------------------------------------------------------------------------------
      * Destructor.
     */
-    ~LootManager() = default;
+    ~LootManager();
 
     /* --------------------------------------------------------------------------------------------
      * Copy assignment operator. (disabled)
@@ -217,8 +303,328 @@ public:
     */
     LootManager & operator = (LootManager && o) = delete;
 
+    /* --------------------------------------------------------------------------------------------
+     * Release all script resources without invoking the delete callbacks.
+    */
+    void Terminate();
+
+    /* --------------------------------------------------------------------------------------------
+     * Update region activation and process expired respawn timers.
+    */
+    void Process();
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the associated user tag.
+    */
+    SQMOD_NODISCARD const String & GetTag() const
+    {
+        return mTag;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the associated user tag.
+    */
+    void SetTag(StackStrF & tag)
+    {
+        mTag.assign(tag.mPtr, static_cast< size_t >(ClampMin(tag.mLen, SQInteger(0))));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the associated user data.
+    */
+    SQMOD_NODISCARD LightObj & GetData()
+    {
+        return mData;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the associated user data.
+    */
+    void SetData(LightObj & data)
+    {
+        mData = data;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of milliseconds between region activation checks.
+    */
+    SQMOD_NODISCARD SQInteger GetActivationInterval() const
+    {
+        return static_cast< SQInteger >(mActivation);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the number of milliseconds between region activation checks.
+    */
+    void SetActivationInterval(SQInteger ms)
+    {
+        mActivation = ClampMin(static_cast< int64_t >(ms), int64_t(0));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the seed of the random number generator.
+    */
+    void SetSeed(SQInteger seed)
+    {
+        mRng.seed(static_cast< std::mt19937::result_type >(seed));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of factories.
+    */
+    SQMOD_NODISCARD SQInteger GetFactories() const
+    {
+        return static_cast< SQInteger >(mFactories.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of regions.
+    */
+    SQMOD_NODISCARD SQInteger GetRegions() const
+    {
+        return static_cast< SQInteger >(mRegions.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of active regions.
+    */
+    SQMOD_NODISCARD SQInteger GetActive() const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of items that currently exist in the world.
+    */
+    SQMOD_NODISCARD SQInteger GetSpawned() const
+    {
+        return static_cast< SQInteger >(mSpawned);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of pending respawn timers.
+    */
+    SQMOD_NODISCARD SQInteger GetPending() const
+    {
+        return static_cast< SQInteger >(mTimers.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Create a factory and return its index.
+    */
+    SQInteger AddFactory(SQInteger id, SQInteger type, SQInteger cls, Function & create, Function & destroy);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the user identifier of a factory.
+    */
+    SQMOD_NODISCARD SQInteger GetFactoryID(SQInteger factory) const
+    {
+        return ValidFactory(factory).mID;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the user data of a factory.
+    */
+    SQMOD_NODISCARD LightObj & GetFactoryData(SQInteger factory)
+    {
+        return ValidFactory(factory).mData;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the user data of a factory.
+    */
+    void SetFactoryData(SQInteger factory, LightObj & data)
+    {
+        ValidFactory(factory).mData = data;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Create a region and return its index.
+    */
+    SQInteger AddRegion(const Vector3 & center, SQFloat radius, SQInteger world);
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the number of milliseconds before an emptied spawn from a region receives a new item.
+    */
+    void SetRegionRespawn(SQInteger region, SQInteger ms)
+    {
+        ValidRegion(region).mRespawn = ClampMin(static_cast< int64_t >(ms), int64_t(0));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the weight of a factory in a region.
+    */
+    void SetRegionItem(SQInteger region, SQInteger factory, SQFloat weight);
+
+    /* --------------------------------------------------------------------------------------------
+     * See if a region is currently active.
+    */
+    SQMOD_NODISCARD bool IsRegionActive(SQInteger region) const
+    {
+        return ValidRegion(region).mActive;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Create a cluster inside a region and return its index.
+    */
+    SQInteger AddCluster(SQInteger region, SQInteger limit);
+
+    /* --------------------------------------------------------------------------------------------
+     * Create a spawn inside a cluster and return its key.
+    */
+    SQInteger AddSpawn(SQInteger region, SQInteger cluster, const Vector3 & pos);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the object returned by the factory for the item occupying a spawn.
+    */
+    SQMOD_NODISCARD LightObj & GetItem(SQInteger key)
+    {
+        return ValidSpawn(key).mItem;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the factory of the item occupying a spawn. Returns -1 if the spawn is empty.
+    */
+    SQMOD_NODISCARD SQInteger GetItemFactory(SQInteger key)
+    {
+        return ValidSpawn(key).mFactory;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the position of a spawn.
+    */
+    SQMOD_NODISCARD const Vector3 & GetSpawnPosition(SQInteger key)
+    {
+        return ValidSpawn(key).mPos;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Mark a spawn as empty because the script already took care of the item.
+    */
+    bool Take(SQInteger key)
+    {
+        return Empty(key, false);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Delete the item occupying a spawn and mark the spawn as empty.
+    */
+    bool Remove(SQInteger key)
+    {
+        return Empty(key, true);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Delete all items and forget about all factories, regions, clusters and spawns.
+    */
+    void Clear();
+
 private:
 
+    /* --------------------------------------------------------------------------------------------
+     * Shared respawn timer.
+    */
+    struct Timer
+    {
+        int64_t     mDeadline; // When the timer expires.
+        SQInteger   mKey; // Key of the associated spawn.
+
+        // Used to keep the earliest deadline at the top of the heap
+        bool operator > (const Timer & o) const { return mDeadline > o.mDeadline; }
+    };
+
+    // --------------------------------------------------------------------------------------------
+    std::vector< LootFactory >  mFactories{}; // Loot factories.
+    std::vector< LootRegion >   mRegions{}; // Loot regions.
+    std::vector< Timer >        mTimers{}; // Respawn timers (min-heap).
+    std::vector< Vector3 >      mPlayers{}; // Player positions from the last activation check.
+    std::vector< int32_t >      mWorlds{}; // Player worlds from the last activation check.
+    std::mt19937                mRng; // Random number generator.
+    int64_t                     mActivation{1000}; // Milliseconds between activation checks.
+    int64_t                     mNextActivation{0}; // When the next activation check happens.
+    uint32_t                    mSpawned{0}; // Number of items that currently exist in the world.
+    bool                        mLocked{false}; // Whether callbacks are being invoked.
+
+    // --------------------------------------------------------------------------------------------
+    String                      mTag{}; // User tag associated with this instance.
+    LightObj                    mData{}; // User data associated with this instance.
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the current time in milliseconds.
+    */
+    SQMOD_NODISCARD static int64_t Now()
+    {
+        return std::chrono::duration_cast< std::chrono::milliseconds >(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Compose the key of a spawn.
+    */
+    SQMOD_NODISCARD static SQInteger MakeKey(size_t region, size_t cluster, size_t spawn)
+    {
+        return static_cast< SQInteger >((static_cast< uint64_t >(region) << (LOOT_CLUSTER_BITS + LOOT_SPAWN_BITS)) |
+                                        (static_cast< uint64_t >(cluster) << LOOT_SPAWN_BITS) | static_cast< uint64_t >(spawn));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Make sure layout changes don't happen while callbacks are invoked.
+    */
+    void ValidateUnlocked() const
+    {
+        if (mLocked)
+        {
+            STHROWF("Cannot change the loot layout from a loot callback");
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve a factory or throw an exception if it doesn't exist.
+    */
+    SQMOD_NODISCARD LootFactory & ValidFactory(SQInteger factory);
+    SQMOD_NODISCARD const LootFactory & ValidFactory(SQInteger factory) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve a region or throw an exception if it doesn't exist.
+    */
+    SQMOD_NODISCARD LootRegion & ValidRegion(SQInteger region);
+    SQMOD_NODISCARD const LootRegion & ValidRegion(SQInteger region) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve a spawn or throw an exception if it doesn't exist.
+    */
+    SQMOD_NODISCARD LootSpawn & ValidSpawn(SQInteger key);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve a spawn or null if it doesn't exist.
+    */
+    SQMOD_NODISCARD LootSpawn * FindSpawn(SQInteger key);
+
+    /* --------------------------------------------------------------------------------------------
+     * Start the respawn timer of a spawn.
+    */
+    void Schedule(SQInteger key, LootSpawn & spawn, int64_t deadline);
+
+    /* --------------------------------------------------------------------------------------------
+     * Pick an item for an empty spawn and create it.
+    */
+    void Fill(SQInteger key, int64_t now);
+
+    /* --------------------------------------------------------------------------------------------
+     * Invoke the factory to create the item that occupies a spawn.
+    */
+    void Materialize(SQInteger key);
+
+    /* --------------------------------------------------------------------------------------------
+     * Invoke the factory to delete the item that occupies a spawn. The spawn stays occupied.
+    */
+    void Dematerialize(SQInteger key);
+
+    /* --------------------------------------------------------------------------------------------
+     * Empty a spawn and start its respawn timer.
+    */
+    bool Empty(SQInteger key, bool notify);
+
+    /* --------------------------------------------------------------------------------------------
+     * Activate or deactivate regions according to the nearby players.
+    */
+    void UpdateActivation(int64_t now);
 };
 
 } // Namespace:: SqMod
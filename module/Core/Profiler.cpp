@@ -0,0 +1,815 @@
+// ------------------------------------------------------------------------------------------------
+#include "Core/Profiler.hpp"
+#include "Core/Utility.hpp"
+#include "Core.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+#include <unordered_map>
+
+// ------------------------------------------------------------------------------------------------
+namespace SqMod {
+
+// ------------------------------------------------------------------------------------------------
+bool g_Profiling = false;
+bool g_Watching = false;
+uint32_t g_ProfileGeneration = 0;
+
+/* ------------------------------------------------------------------------------------------------
+ * Measurements of a callback identified by its source, line and name. Closures created from the
+ * same function definition share them.
+*/
+struct ProfileFunc
+{
+    // --------------------------------------------------------------------------------------------
+    ProfileStats    mStats{}; // Accumulated measurements.
+    String          mSource{}; // Source file where the callback was compiled.
+    String          mName{}; // Name of the callback.
+    SQInteger       mLine{-1}; // Line where the callback was defined.
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Remembers which measurements a closure contributes to without keeping the closure alive.
+*/
+struct ProfileLink
+{
+    // --------------------------------------------------------------------------------------------
+    LightObj        mRef{}; // Weak reference to the closure. Dies with it so a reused address is noticed.
+    ProfileFunc *   mFunc{nullptr}; // Measurements the closure contributes to.
+};
+
+// ------------------------------------------------------------------------------------------------
+static const SQChar * const g_ProfileKindName[] = {_SC("Signal"), _SC("Routine"), _SC("Task")};
+
+// ------------------------------------------------------------------------------------------------
+static std::unordered_map< String, ProfileStats > g_ProfileGroups[PK_MAX]; // Node based, pointers stay valid.
+static std::unordered_map< String, ProfileFunc > g_ProfileFuncs; // Node based, pointers stay valid.
+static std::unordered_map< const void *, ProfileLink > g_ProfileLinks; // Closures seen so far.
+static size_t g_ProfileLinksPurge = 64; // Number of links at which dead closures are forgotten.
+
+// ------------------------------------------------------------------------------------------------
+static String g_ProfileDumpPath{}; // Where to write the periodic dump. Empty to disable.
+static std::chrono::milliseconds g_ProfileDumpInterval{0};
+static std::chrono::steady_clock::time_point g_ProfileDumpLast{};
+
+// ------------------------------------------------------------------------------------------------
+ProfileStats * ProfileGroup(ProfileKind kind, const SQChar * name)
+{
+    return &g_ProfileGroups[kind][name];
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Retrieve the source, line and name of a callback.
+*/
+static void FunctionInfo(const HSQOBJECT & func, String & source, SQInteger & line, String & name)
+{
+    // Grab the virtual machine once
+    HSQUIRRELVM vm = SqVM();
+    // Remember the current stack size
+    const StackGuard sg(vm);
+    // Push the function on the stack
+    sq_pushobject(vm, func);
+    // Only script closures have a source and line
+    line = sq_getclosureline(vm, -1);
+    if (SQ_SUCCEEDED(sq_getclosuresource(vm, -1)))
+    {
+        const SQChar * str = nullptr;
+        SQInteger len = 0;
+        if (SQ_SUCCEEDED(sq_getstringandsize(vm, -1, &str, &len)))
+        {
+            source.assign(str, static_cast< size_t >(len));
+        }
+        sq_poptop(vm);
+    }
+    // Anonymous functions have a null name
+    if (SQ_SUCCEEDED(sq_getclosurename(vm, -1)))
+    {
+        const SQChar * str = nullptr;
+        SQInteger len = 0;
+        if (SQ_SUCCEEDED(sq_getstringandsize(vm, -1, &str, &len)))
+        {
+            name.assign(str, static_cast< size_t >(len));
+        }
+    }
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Forget the closures that no longer exist.
+*/
+static void PurgeProfileLinks()
+{
+    for (auto itr = g_ProfileLinks.begin(); itr != g_ProfileLinks.end();)
+    {
+        if (sq_isweakrefalive(&itr->second.mRef.GetObj()))
+        {
+            ++itr;
+        }
+        else
+        {
+            itr = g_ProfileLinks.erase(itr);
+        }
+    }
+    // Don't scan again until the links have doubled
+    g_ProfileLinksPurge = std::max(g_ProfileLinks.size() * 2, size_t(64));
+}
+
+// ------------------------------------------------------------------------------------------------
+ProfileStats * ProfileFunction(const HSQOBJECT & func)
+{
+    ProfileLink & link = g_ProfileLinks[func._unVal.pRefCounted];
+    // Have we seen this closure before and is it still the same one?
+    if (link.mFunc != nullptr && sq_isweakrefalive(&link.mRef.GetObj()))
+    {
+        return &link.mFunc->mStats;
+    }
+    String source, name;
+    SQInteger line = -1;
+    FunctionInfo(func, source, line, name);
+    // Closures created from the same definition share the measurements
+    auto res = g_ProfileFuncs.emplace(fmt::format("{}:{} {}", source, line, name), ProfileFunc{});
+    ProfileFunc & f = res.first->second;
+    if (res.second)
+    {
+        f.mSource = std::move(source);
+        f.mName = std::move(name);
+        f.mLine = line;
+    }
+    // Reference the closure weakly so that it can go away
+    HSQUIRRELVM vm = SqVM();
+    const StackGuard sg(vm);
+    sq_pushobject(vm, func);
+    sq_weakref(vm, -1);
+    link.mRef = LightObj(-1, vm);
+    link.mFunc = &f;
+    // Closures that went away leave their links behind
+    if (g_ProfileLinks.size() >= g_ProfileLinksPurge)
+    {
+        PurgeProfileLinks();
+    }
+    return &f.mStats;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ProfileSample::Finish() noexcept
+{
+    const auto time = static_cast< uint64_t >(std::chrono::duration_cast< std::chrono::nanoseconds >(
+                                                std::chrono::steady_clock::now() - mStart).count());
+    // Samples started before the profiles were discarded have nowhere to go
+    if (mStats != nullptr && mGeneration == g_ProfileGeneration)
+    {
+        mStats->Record(time, static_cast< uint64_t >(sq_getallocationcount() - mAllocs),
+                       static_cast< int64_t >(sq_getallocatedbytes() - mBytes));
+    }
+    // Is the frame watchdog interested in this callback?
+    if (g_Watching && mKind != PK_MAX)
+    {
+        WatchCall(mKind, mFunc, time);
+    }
+    mActive = false;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Store the accumulated measurements into a script table.
+*/
+static void StatsToTable(const ProfileStats & s, Table & tbl)
+{
+    tbl.SetValue(_SC("Calls"), static_cast< SQInteger >(s.mCalls));
+    tbl.SetValue(_SC("Total"), static_cast< SQInteger >(s.mTotal));
+    tbl.SetValue(_SC("Max"), static_cast< SQInteger >(s.mMax));
+    tbl.SetValue(_SC("Allocs"), static_cast< SQInteger >(s.mAllocs));
+    tbl.SetValue(_SC("Bytes"), static_cast< SQInteger >(s.mBytes));
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Write the collected profiles to a file, sorted by total time. Returns false on failure.
+*/
+static bool WriteProfile(const String & path)
+{
+    std::FILE * file = std::fopen(path.c_str(), "w");
+    // Was the file opened?
+    if (file == nullptr)
+    {
+        return false;
+    }
+    // Group profiles first
+    std::vector< std::pair< String, const ProfileStats * > > rows;
+    for (int kind = 0; kind < PK_MAX; ++kind)
+    {
+        for (const auto & g : g_ProfileGroups[kind])
+        {
+            rows.emplace_back(fmt::format("{}\t{}", g_ProfileKindName[kind], g.first), &g.second);
+        }
+    }
+    // Function profiles next
+    for (const auto & f : g_ProfileFuncs)
+    {
+        rows.emplace_back(fmt::format("Function\t{}:{} {}", f.second.mSource, f.second.mLine,
+                                      f.second.mName.empty() ? _SC("@anonymous") : f.second.mName.c_str()),
+                          &f.second.mStats);
+    }
+    // Most expensive first
+    std::sort(rows.begin(), rows.end(), [](const auto & a, const auto & b) {
+        return a.second->mTotal > b.second->mTotal;
+    });
+    std::fputs("# kind\tname\tcalls\ttotal_ns\tmax_ns\tallocs\tbytes\n", file);
+    for (const auto & r : rows)
+    {
+        const ProfileStats & s = *r.second;
+        const String line = fmt::format("{}\t{}\t{}\t{}\t{}\t{}\n", r.first, s.mCalls, s.mTotal, s.mMax, s.mAllocs, s.mBytes);
+        std::fputs(line.c_str(), file);
+    }
+    return std::fclose(file) == 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ProcessProfiler()
+{
+    // Is there a periodic dump?
+    if (g_ProfileDumpPath.empty())
+    {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    // Is it time for another dump?
+    if ((now - g_ProfileDumpLast) >= g_ProfileDumpInterval)
+    {
+        g_ProfileDumpLast = now;
+        if (!WriteProfile(g_ProfileDumpPath))
+        {
+            LogErr("Unable to write profiler dump to '%s'", g_ProfileDumpPath.c_str());
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+static bool g_Sampling = false; // Whether the call stack is being sampled.
+static std::chrono::microseconds g_SampleInterval{1000}; // Minimum time between samples.
+static std::chrono::steady_clock::time_point g_SampleNext{}; // When to take the next sample.
+static std::unordered_map< String, uint64_t > g_SampleStacks; // Collapsed call stacks and their hits.
+static std::vector< SQStackInfos > g_SampleFrames; // Frames of the call stack being sampled.
+static String g_SampleKey{}; // Collapsed call stack being sampled.
+static uint64_t g_SampleCount = 0; // Number of samples taken.
+
+/* ------------------------------------------------------------------------------------------------
+ * Record the call stack of the virtual machine, from the outermost to the innermost call.
+*/
+static void SampleCallStack(HSQUIRRELVM vm)
+{
+    SQStackInfos si;
+    // Level zero is the innermost call
+    g_SampleFrames.clear();
+    for (SQInteger level = 0; SQ_SUCCEEDED(sq_stackinfos(vm, level, &si)); ++level)
+    {
+        g_SampleFrames.push_back(si);
+    }
+    // Collapsed stacks are semicolon separated frames
+    g_SampleKey.clear();
+    for (auto itr = g_SampleFrames.rbegin(); itr != g_SampleFrames.rend(); ++itr)
+    {
+        if (!g_SampleKey.empty())
+        {
+            g_SampleKey.push_back(';');
+        }
+        g_SampleKey.append(itr->funcname != nullptr ? itr->funcname : _SC("@anonymous"));
+        g_SampleKey.append(itr->line < 0 ? fmt::format(" ({})", itr->source != nullptr ? itr->source : _SC("?"))
+                                         : fmt::format(" ({}:{})", itr->source != nullptr ? itr->source : _SC("?"), itr->line));
+    }
+    ++g_SampleStacks[g_SampleKey];
+    ++g_SampleCount;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Debug hook invoked by the virtual machine on calls, returns and (with debug information) lines.
+*/
+static void SampleHook(HSQUIRRELVM vm, SQInteger SQ_UNUSED_ARG(type), const SQChar * SQ_UNUSED_ARG(source),
+                       SQInteger SQ_UNUSED_ARG(line), const SQChar * SQ_UNUSED_ARG(func))
+{
+    const auto now = std::chrono::steady_clock::now();
+    // Is it time for another sample?
+    if (now >= g_SampleNext)
+    {
+        g_SampleNext = now + g_SampleInterval;
+        SampleCallStack(vm);
+    }
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Start or stop sampling the call stack of the virtual machine. Returns false if there's no virtual
+ * machine to sample, in which case sampling is left stopped.
+*/
+static bool SetSampling(bool toggle)
+{
+    HSQUIRRELVM vm = Core::Get().GetVM();
+    // The hook went away with the virtual machine, if there was one
+    if (vm == nullptr)
+    {
+        g_Sampling = false;
+        return !toggle;
+    }
+    g_Sampling = toggle;
+    g_SampleNext = std::chrono::steady_clock::now();
+    sq_setnativedebughook(vm, toggle ? &SampleHook : nullptr);
+    return true;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Write the sampled call stacks to a file in the collapsed format used by flame graph tools.
+*/
+static bool WriteSamples(const String & path)
+{
+    std::FILE * file = std::fopen(path.c_str(), "w");
+    // Was the file opened?
+    if (file == nullptr)
+    {
+        return false;
+    }
+    for (const auto & e : g_SampleStacks)
+    {
+        const String line = fmt::format("{} {}\n", e.first, e.second);
+        std::fputs(line.c_str(), file);
+    }
+    return std::fclose(file) == 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SamplerCommand(const char * message)
+{
+    const String msg(message != nullptr ? message : "");
+    const size_t sep = msg.find(' ');
+    const String cmd = msg.substr(0, sep), arg = sep == String::npos ? String() : msg.substr(sep + 1);
+    // Commands are: start [interval in microseconds], stop, reset, dump <path>
+    if (cmd == "start")
+    {
+        if (!arg.empty())
+        {
+            g_SampleInterval = std::chrono::microseconds(std::max(std::strtoll(arg.c_str(), nullptr, 10), 0LL));
+        }
+        if (!SetSampling(true))
+        {
+            LogWrn("Script sampler cannot start without a virtual machine");
+            return;
+        }
+        LogInf("Script sampler started (%lld us)", static_cast< long long >(g_SampleInterval.count()));
+    }
+    else if (cmd == "stop")
+    {
+        static_cast< void >(SetSampling(false));
+        LogInf("Script sampler stopped (%llu samples)", static_cast< unsigned long long >(g_SampleCount));
+    }
+    else if (cmd == "reset")
+    {
+        g_SampleStacks.clear();
+        g_SampleCount = 0;
+    }
+    else if (cmd == "dump" && !arg.empty())
+    {
+        if (!WriteSamples(arg))
+        {
+            LogErr("Unable to write sampled call stacks to '%s'", arg.c_str());
+        }
+    }
+    else
+    {
+        LogWrn("Unknown script sampler command '%s'", msg.c_str());
+    }
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Timings of a server frame stage.
+*/
+struct FrameStageStats
+{
+    // --------------------------------------------------------------------------------------------
+    uint32_t    mWindow[SQMOD_FRAME_WINDOW]{}; // Most recent durations (microseconds).
+    uint64_t    mHistogram[SQMOD_FRAME_BUCKETS]{}; // Durations by power of two buckets (microseconds).
+    uint64_t    mSamples{0}; // Number of timed frames.
+    uint64_t    mOverruns{0}; // Number of times the budget was exceeded.
+    uint64_t    mReported{0}; // Number of overruns at the time of the last report.
+    uint32_t    mBudget{0}; // Time allowed for this stage (microseconds). Zero for none.
+    // --------------------------------------------------------------------------------------------
+    std::chrono::steady_clock::time_point mLastReport{}; // When the last overrun was reported.
+
+    /* --------------------------------------------------------------------------------------------
+     * Include the duration of a frame.
+    */
+    void Record(uint32_t time)
+    {
+        mWindow[mSamples % SQMOD_FRAME_WINDOW] = time;
+        ++mSamples;
+        // Find the highest bit to select the bucket
+        uint32_t bucket = 0;
+        while ((time >> (bucket + 1)) != 0 && bucket < (SQMOD_FRAME_BUCKETS - 1))
+        {
+            ++bucket;
+        }
+        ++mHistogram[bucket];
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Discard the timings but keep the budget.
+    */
+    void Reset()
+    {
+        std::fill(std::begin(mWindow), std::end(mWindow), 0u);
+        std::fill(std::begin(mHistogram), std::end(mHistogram), 0u);
+        mSamples = mOverruns = mReported = 0;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+static const SQChar * const g_FrameStageName[] = {
+    _SC("Event"), _SC("Routines"), _SC("Tasks"), _SC("Loot"), _SC("Threads"), _SC("Net"),
+    _SC("DPP"), _SC("Logger"), _SC("Reload"), _SC("Entities"), _SC("Frame")
+};
+
+// ------------------------------------------------------------------------------------------------
+static FrameStageStats g_FrameStages[FS_MAX];
+static std::chrono::steady_clock::time_point g_FrameStart{}; // When the current frame began.
+static std::chrono::steady_clock::time_point g_FrameMark{}; // When the current stage began.
+
+// ------------------------------------------------------------------------------------------------
+static uint64_t g_SlowestTime = 0; // Duration of the slowest callback in the current stage (nanoseconds).
+static ProfileKind g_SlowestKind = PK_MAX; // Kind of the slowest callback in the current stage.
+static LightObj g_SlowestFunc{}; // The slowest callback in the current stage.
+
+// ------------------------------------------------------------------------------------------------
+void WatchCall(ProfileKind kind, const HSQOBJECT & func, uint64_t time)
+{
+    if (time > g_SlowestTime)
+    {
+        g_SlowestTime = time;
+        g_SlowestKind = kind;
+        g_SlowestFunc = LightObj(func);
+    }
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Forget the slowest callback of the current stage.
+*/
+static void ForgetSlowest()
+{
+    g_SlowestTime = 0;
+    g_SlowestKind = PK_MAX;
+    if (!g_SlowestFunc.IsNull())
+    {
+        g_SlowestFunc.Release();
+    }
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Include the duration of a stage and report it if it exceeded the budget.
+*/
+static void FrameStageDone(FrameStage stage, std::chrono::steady_clock::duration time,
+                           std::chrono::steady_clock::time_point now)
+{
+    FrameStageStats & fs = g_FrameStages[stage];
+    const auto us = static_cast< uint32_t >(std::min< int64_t >(
+                        std::chrono::duration_cast< std::chrono::microseconds >(time).count(), UINT32_MAX));
+    fs.Record(us);
+    // Was the budget exceeded?
+    if (fs.mBudget == 0 || us <= fs.mBudget)
+    {
+        return;
+    }
+    ++fs.mOverruns;
+    // Report at most once per second to avoid flooding the log when the server is struggling
+    if ((now - fs.mLastReport) < std::chrono::seconds(1))
+    {
+        return;
+    }
+    fs.mLastReport = now;
+    // Identify the slowest callback, if known
+    String slowest;
+    if (g_SlowestKind != PK_MAX && !g_SlowestFunc.IsNull())
+    {
+        String source, name;
+        SQInteger line = -1;
+        FunctionInfo(g_SlowestFunc.GetObj(), source, line, name);
+        slowest = fmt::format(", slowest {} callback {} ({}:{}) took {} us", g_ProfileKindName[g_SlowestKind],
+                              name.empty() ? _SC("@anonymous") : name.c_str(), source, line, g_SlowestTime / 1000);
+    }
+    LogWrn("Frame stage '%s' took %u us of %u us budget (%llu overruns since last report)%s",
+           g_FrameStageName[stage], us, fs.mBudget, static_cast< unsigned long long >(fs.mOverruns - fs.mReported),
+           slowest.c_str());
+    fs.mReported = fs.mOverruns;
+}
+
+// ------------------------------------------------------------------------------------------------
+void FrameTimingBegin()
+{
+    g_FrameStart = g_FrameMark = std::chrono::steady_clock::now();
+    // Callbacks from outside the frame don't belong to the first stage
+    ForgetSlowest();
+}
+
+// ------------------------------------------------------------------------------------------------
+void FrameTimingStage(FrameStage stage)
+{
+    const auto now = std::chrono::steady_clock::now();
+    FrameStageDone(stage, now - g_FrameMark, now);
+    g_FrameMark = now;
+    ForgetSlowest();
+}
+
+// ------------------------------------------------------------------------------------------------
+void FrameTimingEnd()
+{
+    const auto now = std::chrono::steady_clock::now();
+    FrameStageDone(FS_FRAME, now - g_FrameStart, now);
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Discard the collected profiles.
+*/
+static void ClearProfiles()
+{
+    for (auto & g : g_ProfileGroups)
+    {
+        g.clear();
+    }
+    g_ProfileFuncs.clear();
+    g_ProfileLinks.clear();
+    g_ProfileLinksPurge = 64;
+    // Let any active samples know
+    ++g_ProfileGeneration;
+}
+
+// ------------------------------------------------------------------------------------------------
+void TerminateProfiler()
+{
+    g_Profiling = false;
+    g_ProfileDumpPath.clear();
+    ClearProfiles();
+    // Stop sampling the call stack
+    if (g_Sampling)
+    {
+        static_cast< void >(SetSampling(false));
+    }
+    g_SampleStacks.clear();
+    g_SampleCount = 0;
+    // Budgets are set by the scripts
+    for (auto & fs : g_FrameStages)
+    {
+        fs.mBudget = 0;
+        fs.Reset();
+    }
+    g_Watching = false;
+    ForgetSlowest();
+}
+
+// ------------------------------------------------------------------------------------------------
+static bool SqGetProfiling()
+{
+    return g_Profiling;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqSetProfiling(bool toggle)
+{
+    g_Profiling = toggle;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqResetProfiles()
+{
+    ClearProfiles();
+}
+
+// ------------------------------------------------------------------------------------------------
+static Array SqGetGroupProfiles()
+{
+    HSQUIRRELVM vm = SqVM();
+    Array arr(vm);
+    for (int kind = 0; kind < PK_MAX; ++kind)
+    {
+        for (const auto & g : g_ProfileGroups[kind])
+        {
+            Table tbl(vm);
+            tbl.SetValue(_SC("Kind"), g_ProfileKindName[kind]);
+            tbl.SetValue(_SC("Name"), g.first);
+            StatsToTable(g.second, tbl);
+            arr.Append(tbl);
+        }
+    }
+    return arr;
+}
+
+// ------------------------------------------------------------------------------------------------
+static Array SqGetFunctionProfiles()
+{
+    HSQUIRRELVM vm = SqVM();
+    Array arr(vm);
+    for (const auto & f : g_ProfileFuncs)
+    {
+        Table tbl(vm);
+        tbl.SetValue(_SC("Source"), f.second.mSource);
+        tbl.SetValue(_SC("Line"), f.second.mLine);
+        tbl.SetValue(_SC("Name"), f.second.mName);
+        StatsToTable(f.second.mStats, tbl);
+        arr.Append(tbl);
+    }
+    return arr;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqSetProfileDump(SQInteger interval, StackStrF & path)
+{
+    g_ProfileDumpPath.assign(path.mPtr, static_cast< size_t >(ClampMin(path.mLen, SQInteger(0))));
+    g_ProfileDumpInterval = std::chrono::milliseconds(ClampMin(interval, SQInteger(0)));
+    g_ProfileDumpLast = std::chrono::steady_clock::now();
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqWriteProfile(StackStrF & path)
+{
+    if (!WriteProfile(String(path.mPtr, static_cast< size_t >(ClampMin(path.mLen, SQInteger(0))))))
+    {
+        STHROWF("Unable to write profiler dump to '{}'", path.mPtr);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+static bool SqGetSampling()
+{
+    return g_Sampling;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqSetSampling(bool toggle)
+{
+    if (!SetSampling(toggle))
+    {
+        STHROWF("Cannot sample without a virtual machine");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqGetSampleInterval()
+{
+    return static_cast< SQInteger >(g_SampleInterval.count());
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqSetSampleInterval(SQInteger interval)
+{
+    g_SampleInterval = std::chrono::microseconds(ClampMin(interval, SQInteger(0)));
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqSetSampleLines(bool toggle)
+{
+    sq_enabledebuginfo(SqVM(), static_cast< SQBool >(toggle));
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqGetSampleCount()
+{
+    return static_cast< SQInteger >(g_SampleCount);
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqResetSamples()
+{
+    g_SampleStacks.clear();
+    g_SampleCount = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+static Table SqGetSamples()
+{
+    HSQUIRRELVM vm = SqVM();
+    Table tbl(vm);
+    for (const auto & e : g_SampleStacks)
+    {
+        tbl.SetValue(e.first.c_str(), static_cast< SQInteger >(e.second));
+    }
+    return tbl;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqWriteSamples(StackStrF & path)
+{
+    if (!WriteSamples(String(path.mPtr, static_cast< size_t >(ClampMin(path.mLen, SQInteger(0))))))
+    {
+        STHROWF("Unable to write sampled call stacks to '{}'", path.mPtr);
+    }
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Validate a frame stage identifier.
+*/
+static FrameStageStats & GetFrameStage(SQInteger stage)
+{
+    if (stage < 0 || stage >= FS_MAX)
+    {
+        STHROWF("Invalid frame stage ({})", stage);
+    }
+    return g_FrameStages[stage];
+}
+
+// ------------------------------------------------------------------------------------------------
+static Array SqGetFrameStats()
+{
+    HSQUIRRELVM vm = SqVM();
+    Array arr(vm);
+    std::vector< uint32_t > window;
+    for (int stage = 0; stage < FS_MAX; ++stage)
+    {
+        const FrameStageStats & fs = g_FrameStages[stage];
+        // Only the most recent frames are considered
+        window.assign(fs.mWindow, fs.mWindow + std::min< uint64_t >(fs.mSamples, SQMOD_FRAME_WINDOW));
+        uint32_t p50 = 0, p99 = 0, max = 0;
+        if (!window.empty())
+        {
+            std::sort(window.begin(), window.end());
+            p50 = window[(window.size() - 1) * 50 / 100];
+            p99 = window[(window.size() - 1) * 99 / 100];
+            max = window.back();
+        }
+        Table tbl(vm);
+        tbl.SetValue(_SC("Stage"), g_FrameStageName[stage]);
+        tbl.SetValue(_SC("Samples"), static_cast< SQInteger >(fs.mSamples));
+        tbl.SetValue(_SC("P50"), static_cast< SQInteger >(p50));
+        tbl.SetValue(_SC("P99"), static_cast< SQInteger >(p99));
+        tbl.SetValue(_SC("Max"), static_cast< SQInteger >(max));
+        tbl.SetValue(_SC("Budget"), static_cast< SQInteger >(fs.mBudget));
+        tbl.SetValue(_SC("Overruns"), static_cast< SQInteger >(fs.mOverruns));
+        arr.Append(tbl);
+    }
+    return arr;
+}
+
+// ------------------------------------------------------------------------------------------------
+static Array SqGetFrameHistogram(SQInteger stage)
+{
+    const FrameStageStats & fs = GetFrameStage(stage);
+    Array arr(SqVM());
+    for (uint64_t n : fs.mHistogram)
+    {
+        arr.Append(static_cast< SQInteger >(n));
+    }
+    return arr;
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqGetFrameBudget(SQInteger stage)
+{
+    return static_cast< SQInteger >(GetFrameStage(stage).mBudget);
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqSetFrameBudget(SQInteger stage, SQInteger budget)
+{
+    GetFrameStage(stage).mBudget = static_cast< uint32_t >(Clamp(budget, SQInteger(0), SQInteger(UINT32_MAX)));
+    // Callbacks are only tracked while there's a budget
+    g_Watching = std::any_of(std::begin(g_FrameStages), std::end(g_FrameStages),
+                             [](const FrameStageStats & fs) { return fs.mBudget != 0; });
+    if (!g_Watching)
+    {
+        ForgetSlowest();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+static void SqResetFrameStats()
+{
+    for (auto & fs : g_FrameStages)
+    {
+        fs.Reset();
+    }
+}
+
+// ================================================================================================
+void Register_Profiler(HSQUIRRELVM vm)
+{
+    Table ns(vm);
+
+    ns.Func(_SC("Enabled"), &SqGetProfiling);
+    ns.Func(_SC("SetEnabled"), &SqSetProfiling);
+    ns.Func(_SC("Reset"), &SqResetProfiles);
+    ns.Func(_SC("Groups"), &SqGetGroupProfiles);
+    ns.Func(_SC("Functions"), &SqGetFunctionProfiles);
+    ns.FmtFunc(_SC("SetDump"), &SqSetProfileDump);
+    ns.FmtFunc(_SC("Dump"), &SqWriteProfile);
+    ns.Func(_SC("Sampling"), &SqGetSampling);
+    ns.Func(_SC("SetSampling"), &SqSetSampling);
+    ns.Func(_SC("SampleInterval"), &SqGetSampleInterval);
+    ns.Func(_SC("SetSampleInterval"), &SqSetSampleInterval);
+    ns.Func(_SC("SetSampleLines"), &SqSetSampleLines);
+    ns.Func(_SC("SampleCount"), &SqGetSampleCount);
+    ns.Func(_SC("ResetSamples"), &SqResetSamples);
+    ns.Func(_SC("Samples"), &SqGetSamples);
+    ns.FmtFunc(_SC("DumpSamples"), &SqWriteSamples);
+    ns.Func(_SC("FrameStats"), &SqGetFrameStats);
+    ns.Func(_SC("FrameHistogram"), &SqGetFrameHistogram);
+    ns.Func(_SC("FrameBudget"), &SqGetFrameBudget);
+    ns.Func(_SC("SetFrameBudget"), &SqSetFrameBudget);
+    ns.Func(_SC("ResetFrameStats"), &SqResetFrameStats);
+
+    RootTable(vm).Bind(_SC("SqProfiler"), ns);
+}
+
+} // Namespace:: SqMod
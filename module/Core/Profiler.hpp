@@ -0,0 +1,181 @@
+#pragma once
+
+// ------------------------------------------------------------------------------------------------
+#include "Core/Common.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <chrono>
+#include <algorithm>
+
+// ------------------------------------------------------------------------------------------------
+namespace SqMod {
+
+/* ------------------------------------------------------------------------------------------------
+ * Kinds of callback groups that can be profiled.
+*/
+enum ProfileKind
+{
+    PK_SIGNAL = 0,
+    PK_ROUTINE,
+    PK_TASK,
+    PK_MAX
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Whether script callbacks are currently being profiled.
+*/
+extern bool g_Profiling;
+
+/* ------------------------------------------------------------------------------------------------
+ * Whether frame stage budgets are set, in which case the slowest callback of each stage is tracked.
+*/
+extern bool g_Watching;
+
+/* ------------------------------------------------------------------------------------------------
+ * Incremented whenever collected profiles are discarded so that active samples know to drop theirs.
+*/
+extern uint32_t g_ProfileGeneration;
+
+/* ------------------------------------------------------------------------------------------------
+ * Measurements accumulated for a group of callbacks or for a single callback.
+*/
+struct ProfileStats
+{
+    // --------------------------------------------------------------------------------------------
+    uint64_t    mCalls{0}; // Number of calls.
+    uint64_t    mTotal{0}; // Time spent in calls (nanoseconds). Includes nested calls.
+    uint64_t    mMax{0}; // Longest call (nanoseconds).
+    uint64_t    mAllocs{0}; // Allocations made by the virtual machine during calls.
+    int64_t     mBytes{0}; // Net change in memory allocated by the virtual machine during calls.
+
+    /* --------------------------------------------------------------------------------------------
+     * Include the measurements of a call.
+    */
+    void Record(uint64_t time, uint64_t allocs, int64_t bytes) noexcept
+    {
+        ++mCalls;
+        mTotal += time;
+        mMax = std::max(mMax, time);
+        mAllocs += allocs;
+        mBytes += bytes;
+    }
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Retrieve the measurements of a named group of callbacks. Created if it doesn't exist.
+*/
+SQMOD_NODISCARD ProfileStats * ProfileGroup(ProfileKind kind, const SQChar * name);
+
+/* ------------------------------------------------------------------------------------------------
+ * Retrieve the measurements of a callback. Created if it doesn't exist.
+*/
+SQMOD_NODISCARD ProfileStats * ProfileFunction(const HSQOBJECT & func);
+
+/* ------------------------------------------------------------------------------------------------
+ * Let the frame watchdog know how long a callback took. The callback must still be alive.
+*/
+void WatchCall(ProfileKind kind, const HSQOBJECT & func, uint64_t time);
+
+/* ------------------------------------------------------------------------------------------------
+ * Measure the time and virtual machine allocations of a call. Does nothing unless profiling or the
+ * frame watchdog is enabled when constructed. Measurements are recorded when stopped or destroyed.
+*/
+class ProfileSample
+{
+public:
+
+    /* --------------------------------------------------------------------------------------------
+     * Measure a call made on behalf of a named group of callbacks.
+    */
+    ProfileSample(ProfileKind kind, const SQChar * name)
+    {
+        if (g_Profiling)
+        {
+            Start(ProfileGroup(kind, name));
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Measure a call to the specified callback. Must be stopped while the callback is still alive.
+    */
+    ProfileSample(ProfileKind kind, const HSQOBJECT & func)
+    {
+        if (g_Profiling || g_Watching)
+        {
+            mKind = kind;
+            mFunc = func;
+            Start(g_Profiling ? ProfileFunction(func) : nullptr);
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy constructor (disabled).
+    */
+    ProfileSample(const ProfileSample & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move constructor (disabled).
+    */
+    ProfileSample(ProfileSample && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Destructor.
+    */
+    ~ProfileSample()
+    {
+        Stop();
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy assignment operator (disabled).
+    */
+    ProfileSample & operator = (const ProfileSample & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move assignment operator (disabled).
+    */
+    ProfileSample & operator = (ProfileSample && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Record the measurements now instead of when destroyed.
+    */
+    void Stop() noexcept
+    {
+        if (mActive)
+        {
+            Finish();
+        }
+    }
+
+private:
+
+    /* --------------------------------------------------------------------------------------------
+     * Begin measuring on behalf of the specified measurements.
+    */
+    void Start(ProfileStats * stats) noexcept
+    {
+        mActive = true;
+        mStats = stats;
+        mGeneration = g_ProfileGeneration;
+        mAllocs = sq_getallocationcount();
+        mBytes = sq_getallocatedbytes();
+        mStart = std::chrono::steady_clock::now();
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Record the measurements taken since the sample was started.
+    */
+    void Finish() noexcept;
+
+    // --------------------------------------------------------------------------------------------
+    bool                                    mActive{false}; // Whether measurements are being taken.
+    ProfileKind                             mKind{PK_MAX}; // What kind of callback is measured, if any.
+    HSQOBJECT                               mFunc{}; // The measured callback, if any.
+    ProfileStats *                          mStats{nullptr}; // Where to record the measurements, if anywhere.
+    uint32_t                                mGeneration{0}; // Profiles at the time of starting.
+    SQUnsignedInteger                       mAllocs{0}; // Allocation count at the time of starting.
+    SQInteger                               mBytes{0}; // Allocated memory at the time of starting.
+    std::chrono::steady_clock::time_point   mStart{}; // Time of starting.
+};
+
+} // Namespace:: SqMod
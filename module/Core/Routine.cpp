@@ -502,6 +502,26 @@ bool Routine::TerminateWithTag(StackStrF & tag)
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+SQInteger Routine::TerminateSource(const String & source)
+{
+    SQInteger count = 0;
+    // Iterate routine list
+    for (auto & r : s_Instances)
+    {
+        if (!r.mInst.IsNull() && IsFunctionFromSource(r.mFunc.mObj, source))
+        {
+            r.Terminate();
+            // Also disable the timer
+            s_Intervals[&r - s_Instances] = 0;
+            // Count this routine
+            ++count;
+        }
+    }
+    // Return the number of terminated routines
+    return count;
+}
+
 /* ------------------------------------------------------------------------------------------------
  * Forward the call to process routines.
 */
@@ -2,6 +2,7 @@
 
 // ------------------------------------------------------------------------------------------------
 #include "Core/Utility.hpp"
+#include "Core/Profiler.hpp"
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
@@ -170,10 +171,15 @@ private:
                 {
                     sq_pushobject(vm, mArgv[n].mObj);
                 }
+                // Measure the call, if profiling
+                ProfileSample ps(PK_ROUTINE, mTag.c_str()), fps(PK_ROUTINE, mFunc.mObj);
                 // This routine is currently executing
                 mExecuting = true;
                 // Make the function call and store the result
                 const SQRESULT res = sq_call(vm, mArgc + 1, static_cast< SQBool >(mYields), static_cast< SQBool >(!mQuiet));
+                // Only the call itself is measured
+                fps.Stop();
+                ps.Stop();
                 // This routine has finished executing
                 mExecuting = false;
                 // Should we look for a yielded value?
@@ -430,6 +436,11 @@ public:
     */
     static bool TerminateWithTag(StackStrF & tag);
 
+    /* --------------------------------------------------------------------------------------------
+     * Terminate the routines whose callback was compiled from the specified source.
+    */
+    static SQInteger TerminateSource(const String & source);
+
     /* --------------------------------------------------------------------------------------------
      * Process all active routines and update elapsed time.
     */
@@ -6,6 +6,10 @@
 #include <algorithm>
 #include <stdexcept>
 
+// ------------------------------------------------------------------------------------------------
+#include <sys/types.h>
+#include <sys/stat.h>
+
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
@@ -157,6 +161,7 @@ ScriptSrc::ScriptSrc(const String & path, Function & cb, LightObj & ctx, bool de
     , mLine()
     , mInfo(info)
     , mDelay(delay)
+    , mTime(GetModifiedTime(path))
 {
     // Is the specified path empty?
     if (mPath.empty())
@@ -191,4 +196,26 @@ String ScriptSrc::FetchLine(size_t line, bool trim) const
     return code;
 }
 
+// ------------------------------------------------------------------------------------------------
+int64_t ScriptSrc::GetModifiedTime(const String & path)
+{
+#ifdef SQMOD_OS_WINDOWS
+    struct _stat64 st{};
+    // Attempt to inspect the file
+    if (_stat64(path.c_str(), &st) != 0)
+    {
+        return 0;
+    }
+#else
+    struct stat st{};
+    // Attempt to inspect the file
+    if (stat(path.c_str(), &st) != 0)
+    {
+        return 0;
+    }
+#endif
+    // Return the modification time
+    return static_cast< int64_t >(st.st_mtime);
+}
+
 } // Namespace::  SqMod
@@ -33,6 +33,7 @@ struct ScriptSrc
     Line        mLine{}; // List of lines of code in the data.
     bool        mInfo{false}; // Whether this script contains line information.
     bool        mDelay{false}; // Don't execute immediately after compilation.
+    int64_t     mTime{0}; // Modification time of the script file when it was compiled.
 
     /* --------------------------------------------------------------------------------------------
      * Read file contents and calculate information about the lines of code.
@@ -68,6 +69,19 @@ struct ScriptSrc
      * Fetches a line from the code. Can also trim whitespace at the beginning.
     */
     SQMOD_NODISCARD String FetchLine(size_t line, bool trim = true) const;
+
+    /* --------------------------------------------------------------------------------------------
+     * See if the script file was modified since it was compiled.
+    */
+    SQMOD_NODISCARD bool Modified() const
+    {
+        return GetModifiedTime(mPath) != mTime;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the modification time of a file. Returns 0 if the file cannot be inspected.
+    */
+    SQMOD_NODISCARD static int64_t GetModifiedTime(const String & path);
 };
 
 
@@ -569,6 +569,7 @@ Signal::Signal()
     , m_Slots(m_SMB)
     , m_Scope(nullptr)
     , m_Name()
+    , m_Label(nullptr)
     , m_Data()
 {
     s_FreeSignals.push_back(this);
@@ -581,6 +582,7 @@ Signal::Signal(String && name)
     , m_Slots(m_SMB)
     , m_Scope(nullptr)
     , m_Name(std::forward< String >(name))
+    , m_Label(nullptr)
     , m_Data()
 {
     if (m_Name.empty())
@@ -972,6 +974,8 @@ SQInteger Signal::Emit(HSQUIRRELVM vm, SQInteger top)
 {
     // Are there any slots connected?
     if (!m_Used) return 0;
+    // Measure the emission, if profiling
+    const ProfileSample ps(PK_SIGNAL, GetProfileName());
     // Enter a new execution scope
     Scope scope(m_Scope, m_Slots, m_Slots + m_Used);
     // Activate the current scope and create a guard to restore it
@@ -983,6 +987,8 @@ SQInteger Signal::Emit(HSQUIRRELVM vm, SQInteger top)
     {
         // Grab a reference to the current slot
         const Slot & slot = *(scope.mItr++);
+        // Measure the slot, if profiling
+        ProfileSample sps(PK_SIGNAL, slot.mFuncRef);
         // Push the callback object
         sq_pushobject(vm, slot.mFuncRef);
         // Is there an explicit environment?
@@ -1004,6 +1010,8 @@ SQInteger Signal::Emit(HSQUIRRELVM vm, SQInteger top)
         }
         // Make the function call and store the result
         res = sq_call(vm, top, static_cast< SQBool >(false), static_cast< SQBool >(ErrorHandling::IsEnabled()));
+        // The slot may release the callback once it is popped
+        sps.Stop();
         // Pop the callback object from the stack
         sq_pop(vm, 1);
         // Validate the result
@@ -1021,6 +1029,8 @@ SQInteger Signal::Query(HSQUIRRELVM vm, SQInteger top)
 {
     // Are there any slots connected?
     if (!m_Used) return 0;
+    // Measure the emission, if profiling
+    const ProfileSample ps(PK_SIGNAL, GetProfileName());
     // The collector and the specified environment
     HSQOBJECT cthis, cfunc;
     // Attempt to grab the collector environment
@@ -1066,6 +1076,8 @@ SQInteger Signal::Query(HSQUIRRELVM vm, SQInteger top)
     {
         // Grab a reference to the current slot
         const Slot & slot = *(scope.mItr++);
+        // Measure the slot, if profiling
+        ProfileSample sps(PK_SIGNAL, slot.mFuncRef);
         // Push the callback object
         sq_pushobject(vm, slot.mFuncRef);
         // Is there an explicit environment?
@@ -1087,6 +1099,8 @@ SQInteger Signal::Query(HSQUIRRELVM vm, SQInteger top)
         }
         // Make the function call and store the result
         res = sq_call(vm, top-2, static_cast< SQBool >(true), static_cast< SQBool >(ErrorHandling::IsEnabled()));
+        // The collector is not part of the slot measurements and the slot may release the callback
+        sps.Stop();
         // Validate the result
         if (SQ_FAILED(res))
         {
@@ -1119,6 +1133,8 @@ SQInteger Signal::Consume(HSQUIRRELVM vm, SQInteger top)
 {
     // Are there any slots connected?
     if (!m_Used) return 0;
+    // Measure the emission, if profiling
+    const ProfileSample ps(PK_SIGNAL, GetProfileName());
     // Enter a new execution scope
     Scope scope(m_Scope, m_Slots, m_Slots + m_Used);
     // Activate the current scope and create a guard to restore it
@@ -1132,6 +1148,8 @@ SQInteger Signal::Consume(HSQUIRRELVM vm, SQInteger top)
     {
         // Grab a reference to the current slot
         const Slot & slot = *(scope.mItr++);
+        // Measure the slot, if profiling
+        ProfileSample sps(PK_SIGNAL, slot.mFuncRef);
         // Push the callback object
         sq_pushobject(vm, slot.mFuncRef);
         // Is there an explicit environment?
@@ -1153,6 +1171,8 @@ SQInteger Signal::Consume(HSQUIRRELVM vm, SQInteger top)
         }
         // Make the function call and store the result
         res = sq_call(vm, top, static_cast< SQBool >(true), static_cast< SQBool >(ErrorHandling::IsEnabled()));
+        // The slot may release the callback once it is popped
+        sps.Stop();
         // Validate the result
         if (SQ_FAILED(res))
         {
@@ -1194,6 +1214,8 @@ SQInteger Signal::Approve(HSQUIRRELVM vm, SQInteger top)
 {
     // Are there any slots connected?
     if (!m_Used) return 0;
+    // Measure the emission, if profiling
+    const ProfileSample ps(PK_SIGNAL, GetProfileName());
     // Enter a new execution scope
     Scope scope(m_Scope, m_Slots, m_Slots + m_Used);
     // Activate the current scope and create a guard to restore it
@@ -1207,6 +1229,8 @@ SQInteger Signal::Approve(HSQUIRRELVM vm, SQInteger top)
     {
         // Grab a reference to the current slot
         const Slot & slot = *(scope.mItr++);
+        // Measure the slot, if profiling
+        ProfileSample sps(PK_SIGNAL, slot.mFuncRef);
         // Push the callback object
         sq_pushobject(vm, slot.mFuncRef);
         // Is there an explicit environment?
@@ -1228,6 +1252,8 @@ SQInteger Signal::Approve(HSQUIRRELVM vm, SQInteger top)
         }
         // Make the function call and store the result
         res = sq_call(vm, top, static_cast< SQBool >(true), static_cast< SQBool >(ErrorHandling::IsEnabled()));
+        // The slot may release the callback once it is popped
+        sps.Stop();
         // Validate the result
         if (SQ_FAILED(res))
         {
@@ -1269,6 +1295,8 @@ SQInteger Signal::Request(HSQUIRRELVM vm, SQInteger top)
 {
     // Are there any slots connected?
     if (!m_Used) return 0;
+    // Measure the emission, if profiling
+    const ProfileSample ps(PK_SIGNAL, GetProfileName());
     // Enter a new execution scope
     Scope scope(m_Scope, m_Slots, m_Slots + m_Used);
     // Activate the current scope and create a guard to restore it
@@ -1280,6 +1308,8 @@ SQInteger Signal::Request(HSQUIRRELVM vm, SQInteger top)
     {
         // Grab a reference to the current slot
         const Slot & slot = *(scope.mItr++);
+        // Measure the slot, if profiling
+        ProfileSample sps(PK_SIGNAL, slot.mFuncRef);
         // Push the callback object
         sq_pushobject(vm, slot.mFuncRef);
         // Is there an explicit environment?
@@ -1301,6 +1331,8 @@ SQInteger Signal::Request(HSQUIRRELVM vm, SQInteger top)
         }
         // Make the function call and store the result
         res = sq_call(vm, top, static_cast< SQBool >(true), static_cast< SQBool >(ErrorHandling::IsEnabled()));
+        // The slot may release the callback once it is popped
+        sps.Stop();
         // Validate the result
         if (SQ_FAILED(res))
         {
@@ -1535,6 +1567,56 @@ void Signal::Terminate()
     s_FreeSignals.clear();
 }
 
+// ------------------------------------------------------------------------------------------------
+SQInteger Signal::DropSource(const String & source)
+{
+    // Grab the virtual machine once
+    HSQUIRRELVM vm = SqVM();
+    // Remember the current stack size
+    const StackGuard sg(vm);
+    // Hold strong references to the script objects because released slots can destroy other signals
+    std::vector< std::pair< Signal *, LightObj > > sigs;
+    sigs.reserve(s_FreeSignals.size() + s_Signals.size());
+    for (Signal * s : s_FreeSignals)
+    {
+        // Signals without a script object are not owned by the script and can't be destroyed by it
+        ClassType< Signal >::PushInstance(vm, s, nullptr);
+        sigs.emplace_back(s, Var< LightObj >(vm, -1).value);
+        sq_poptop(vm);
+    }
+    // Include named signals as well
+    for (const auto & s : s_Signals)
+    {
+        sigs.emplace_back(s.second.first, s.second.second);
+    }
+    // Number of disconnected slots
+    SQInteger count = 0;
+    // Disconnect the slots from each signal
+    for (auto & s : sigs)
+    {
+        count += static_cast< SQInteger >(s.first->EliminateSource(source));
+    }
+    // Return the number of disconnected slots
+    return count;
+}
+
+// ------------------------------------------------------------------------------------------------
+Signal::SizeType Signal::EliminateSource(const String & source)
+{
+    // Make sure that there's at least one slot connected
+    if (m_Used == 0)
+    {
+        return 0;
+    }
+    // Backup the current number of used slots
+    const SizeType count = m_Used;
+    // Remove the slots with a callback from the specified source
+    m_Used -= RemoveIf([&source](const Slot & slot) { return IsFunctionFromSource(slot.mFuncRef, source); },
+                        m_Slots, m_Slots + m_Used, m_Scope);
+    // Return the number of removed slots
+    return count - m_Used;
+}
+
 // ------------------------------------------------------------------------------------------------
 LightObj Signal::CreateFree()
 {
@@ -1561,11 +1643,11 @@ LightObj Signal::Create(StackStrF & name)
     // Create a copy of the name
     String sname(name.mPtr, static_cast< size_t >(name.mLen));
     // Compute the hash of the specified name
-    const std::size_t hash = std::hash< String >{}(sname);
+    const std::size_t hash = HashName(sname);
     // See if the signal already exists
     for (const auto & e : s_Signals)
     {
-        if (e.first == hash)
+        if (e.first == hash && e.second.first->m_Name == sname)
         {
             return LightObj{e.second.second.mObj}; // Found a match so let's return it
         }
@@ -1597,13 +1679,13 @@ void Signal::Remove(StackStrF & name)
     // Create a copy of the name
     const String sname(name.mPtr, static_cast< size_t >(name.mLen));
     // Compute the hash of the specified name
-    const std::size_t hash = std::hash< String >{}(sname);
+    const std::size_t hash = HashName(sname);
     // Iterator to the existing signal, if any
     auto itr = s_Signals.cbegin();
     // Search for a signal with this name
     for (; itr != s_Signals.cend(); ++itr)
     {
-        if (itr->first == hash)
+        if (itr->first == hash && itr->second.first->m_Name == sname)
         {
             break;
         }
@@ -1631,11 +1713,11 @@ const LightObj & Signal::Fetch(StackStrF & name)
     // Create a copy of the name
     const String sname(name.mPtr, static_cast< size_t >(name.mLen));
     // Compute the hash of the specified name
-    const std::size_t hash = std::hash< String >{}(sname);
+    const std::size_t hash = HashName(sname);
     // Search for a signal with this name
     for (const auto & e : s_Signals)
     {
-        if (e.first == hash)
+        if (e.first == hash && e.second.first->m_Name == sname)
         {
             return e.second.second; // Found a match so let's return it
         }
@@ -1672,6 +1754,8 @@ void InitSignalPair(SignalPair & sp, LightObj & et, const char * name)
     if (name != nullptr)
     {
         et.Bind(name, sp.second); // Bind the signal to the specified object
+        // Profile the signal under the name of the event
+        sp.first->SetLabel(name);
     }
 }
 
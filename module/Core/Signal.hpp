@@ -2,6 +2,7 @@
 
 // ------------------------------------------------------------------------------------------------
 #include "Core/Utility.hpp"
+#include "Core/Profiler.hpp"
 
 // ------------------------------------------------------------------------------------------------
 #include <vector>
@@ -367,6 +368,7 @@ private:
     Scope *         m_Scope; // Current execution state.
     // --------------------------------------------------------------------------------------------
     String          m_Name; // The name that identifies this signal.
+    const SQChar *  m_Label; // The name of the event emitted by an unnamed signal. Used by the profiler.
     LightObj        m_Data; // User data associated with this instance.
     // --------------------------------------------------------------------------------------------
     ValueType       m_SMB[SMB_SIZE]{}; // Small buffer optimization.
@@ -381,6 +383,22 @@ public:
         return m_Name;
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the name under which emissions of this signal are profiled.
+    */
+    SQMOD_NODISCARD const SQChar * GetProfileName() const
+    {
+        return m_Name.empty() ? (m_Label != nullptr ? m_Label : _SC("<free>")) : m_Name.c_str();
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the name of the event emitted by this signal. Must have static storage duration.
+    */
+    void SetLabel(const SQChar * label)
+    {
+        m_Label = label;
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Retrieve the associated user data.
     */
@@ -718,6 +736,16 @@ public:
     */
     SQMOD_NODISCARD static const LightObj & Fetch(StackStrF & name);
 
+    /* --------------------------------------------------------------------------------------------
+     * Disconnect the slots of all signals whose callback was compiled from the specified source.
+    */
+    static SQInteger DropSource(const String & source);
+
+    /* --------------------------------------------------------------------------------------------
+     * Disconnect the slots whose callback was compiled from the specified source.
+    */
+    SizeType EliminateSource(const String & source);
+
     /* --------------------------------------------------------------------------------------------
      * Emit a signal from the module.
     */
@@ -725,6 +753,8 @@ public:
     {
         // Are there any slots connected?
         if (!m_Used) return;
+        // Measure the emission, if profiling
+        const ProfileSample ps(PK_SIGNAL, GetProfileName());
         // Enter a new execution scope
         Scope scope(m_Scope, m_Slots, m_Slots + m_Used);
         // Activate the current scope and create a guard to restore it
@@ -736,6 +766,8 @@ public:
         {
             // Grab a reference to the current slot
             const Slot & slot = *(scope.mItr++);
+            // Measure the slot, if profiling
+            ProfileSample sps(PK_SIGNAL, slot.mFuncRef);
             // Push the callback object
             sq_pushobject(vm, slot.mFuncRef);
             // Is there an explicit environment?
@@ -751,6 +783,8 @@ public:
             PushParameters(args...);
             // Make the function call and store the result
             const SQRESULT res = sq_call(vm, 1 + sizeof...(Args), static_cast< SQBool >(false), static_cast< SQBool >(ErrorHandling::IsEnabled()));
+            // The slot may release the callback once it is popped
+            sps.Stop();
             // Pop the callback object from the stack
             sq_pop(vm, 1);
             // Validate the result
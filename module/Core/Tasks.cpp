@@ -1,10 +1,12 @@
 // ------------------------------------------------------------------------------------------------
 #include "Core/Tasks.hpp"
+#include "Core/Profiler.hpp"
 #include "Core.hpp"
 #include "Library/Chrono.hpp"
 
 // ------------------------------------------------------------------------------------------------
 #include <cstring>
+#include <algorithm>
 
 // ------------------------------------------------------------------------------------------------
 
@@ -19,6 +21,28 @@ Tasks::Time         Tasks::s_Last = 0;
 Tasks::Time         Tasks::s_Prev = 0;
 Tasks::Interval     Tasks::s_Intervals[SQMOD_MAX_TASKS];
 Tasks::Task         Tasks::s_Tasks[SQMOD_MAX_TASKS];
+int32_t             Tasks::s_Free = -1;
+int32_t             Tasks::s_Used = 0;
+
+/* ------------------------------------------------------------------------------------------------
+ * Offset of each entity type in the list of task heads.
+*/
+static constexpr int32_t g_TaskHeadOffset[] = {
+    0, // ENT_UNKNOWN
+    0, // ENT_BLIP
+    SQMOD_BLIP_POOL, // ENT_CHECKPOINT
+    SQMOD_BLIP_POOL + SQMOD_CHECKPOINT_POOL, // ENT_KEYBIND
+    SQMOD_BLIP_POOL + SQMOD_CHECKPOINT_POOL + SQMOD_KEYBIND_POOL, // ENT_OBJECT
+    SQMOD_BLIP_POOL + SQMOD_CHECKPOINT_POOL + SQMOD_KEYBIND_POOL + SQMOD_OBJECT_POOL, // ENT_PICKUP
+    SQMOD_BLIP_POOL + SQMOD_CHECKPOINT_POOL + SQMOD_KEYBIND_POOL + SQMOD_OBJECT_POOL + SQMOD_PICKUP_POOL, // ENT_PLAYER
+    SQMOD_BLIP_POOL + SQMOD_CHECKPOINT_POOL + SQMOD_KEYBIND_POOL + SQMOD_OBJECT_POOL + SQMOD_PICKUP_POOL +
+        SQMOD_PLAYER_POOL, // ENT_VEHICLE
+    SQMOD_BLIP_POOL + SQMOD_CHECKPOINT_POOL + SQMOD_KEYBIND_POOL + SQMOD_OBJECT_POOL + SQMOD_PICKUP_POOL +
+        SQMOD_PLAYER_POOL + SQMOD_VEHICLE_POOL, // End
+};
+
+// ------------------------------------------------------------------------------------------------
+int32_t             Tasks::s_Heads[g_TaskHeadOffset[ENT_VEHICLE + 1]];
 
 // ------------------------------------------------------------------------------------------------
 void Tasks::Task::Init(HSQOBJECT & func, HSQOBJECT & inst, Interval intrv, Iterator itr, int32_t id, int32_t type)
@@ -81,8 +105,13 @@ Tasks::Interval Tasks::Task::Execute()
     {
         sq_pushobject(vm, mArgv[n].mObj);
     }
+    // Measure the call, if profiling
+    ProfileSample ps(PK_TASK, mTag.c_str()), fps(PK_TASK, mFunc.mObj);
     // Make the function call and store the result
     const SQRESULT res = sq_call(vm, mArgc + 1, static_cast< SQBool >(false), static_cast< SQBool >(ErrorHandling::IsEnabled()));
+    // Only the call itself is measured
+    fps.Stop();
+    ps.Stop();
     // Pop the callback object from the stack
     sq_pop(vm, 1);
     // Validate the result
@@ -137,6 +166,17 @@ void Tasks::Process()
 void Tasks::Initialize()
 {
     std::memset(s_Intervals, 0, sizeof(s_Intervals));
+    // No entity owns any tasks yet
+    std::fill(std::begin(s_Heads), std::end(s_Heads), -1);
+    // Link all slots into the unused list
+    for (int32_t i = 0; i < SQMOD_MAX_TASKS; ++i)
+    {
+        s_Tasks[i].mPrev = -1;
+        s_Tasks[i].mNext = (i + 1) < SQMOD_MAX_TASKS ? (i + 1) : -1;
+    }
+    // Start with the first slot
+    s_Free = 0;
+    s_Used = 0;
     // Transform all task instances to script objects
     for (auto & t : s_Tasks)
     {
@@ -198,18 +238,71 @@ LightObj & Tasks::FindEntity(int32_t id, int32_t type)
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+int32_t * Tasks::FindHead(int32_t id, int32_t type)
+{
+    // Is the entity type and identifier within range?
+    if (type <= ENT_UNKNOWN || type > ENT_VEHICLE || id < 0 || id >= (g_TaskHeadOffset[type + 1] - g_TaskHeadOffset[type]))
+    {
+        return nullptr;
+    }
+    // Return the head of this entity
+    return &s_Heads[g_TaskHeadOffset[type] + id];
+}
+
 // ------------------------------------------------------------------------------------------------
 SQInteger Tasks::FindUnused()
 {
-    for (const auto & t : s_Tasks)
+    return static_cast< SQInteger >(s_Free); // The unused list is empty when this is negative
+}
+
+// ------------------------------------------------------------------------------------------------
+void Tasks::Attach(int32_t slot)
+{
+    Task & task = s_Tasks[slot];
+    int32_t * head = FindHead(task.mEntity, task.mType);
+    // Only the first unused slot is ever attached
+    assert(slot == s_Free && head != nullptr);
+    // Take the slot from the unused list
+    s_Free = task.mNext;
+    // Link it at the front of the entity list
+    task.mPrev = -1;
+    task.mNext = *head;
+    if (*head >= 0)
     {
-        if (INVALID_ENTITY(t.mEntity))
-        {
-            return (&t - s_Tasks); // Return the index of this element
-        }
+        s_Tasks[*head].mPrev = slot;
     }
-    // No available slot
-    return -1;
+    *head = slot;
+    // One more slot is in use
+    ++s_Used;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Tasks::Detach(int32_t slot)
+{
+    Task & task = s_Tasks[slot];
+    int32_t * head = FindHead(task.mEntity, task.mType);
+    // Unlink the slot from the entity list
+    if (task.mPrev >= 0)
+    {
+        s_Tasks[task.mPrev].mNext = task.mNext;
+    }
+    else if (head != nullptr)
+    {
+        *head = task.mNext;
+    }
+    if (task.mNext >= 0)
+    {
+        s_Tasks[task.mNext].mPrev = task.mPrev;
+    }
+    // Put the slot back in the unused list
+    task.mPrev = -1;
+    task.mNext = s_Free;
+    s_Free = slot;
+    // Also disable the timer
+    s_Intervals[slot] = 0;
+    // One less slot is in use
+    --s_Used;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -222,6 +315,11 @@ SQInteger Tasks::Create(int32_t id, int32_t type, HSQUIRRELVM vm)
     {
         return sq_throwerror(vm, "Reached the maximum number of tasks");
     }
+    // See if the entity can own tasks
+    else if (FindHead(id, type) == nullptr)
+    {
+        return sq_throwerror(vm, "Invalid task entity");
+    }
     // Grab the top of the stack
     const SQInteger top = sq_gettop(vm);
     // See if too many arguments were specified
@@ -315,6 +413,8 @@ SQInteger Tasks::Create(int32_t id, int32_t type, HSQUIRRELVM vm)
 
     // Alright, at this point we can initialize the slot
     task.Init(func, inst, intrv, static_cast< Iterator >(itr), id, type);
+    // Link the slot to the entity
+    Attach(static_cast< int32_t >(slot));
     // Now initialize the timer
     s_Intervals[slot] = intrv;
     // Push the tag instance on the stack
@@ -337,10 +437,11 @@ SQInteger Tasks::Find(int32_t id, int32_t type, SQInteger & pos, HSQUIRRELVM vm)
     SQRESULT res = SQ_OK;
     // Grab the hash of the callback object
     const SQHash chash = sq_gethash(vm, 2);
-    // Should we include the iterations in the criteria?
-    if (top > 3)
+    // The interval and iterations to include in the criteria, if any
+    SQInteger intrv = 0, sqitr = 0;
+    // Should we include the interval in the criteria?
+    if (top > 2)
     {
-        SQInteger intrv = 0;
         // Grab the interval from the stack
         res = sq_getinteger(vm, 3, &intrv);
         // Validate the result
@@ -348,26 +449,10 @@ SQInteger Tasks::Find(int32_t id, int32_t type, SQInteger & pos, HSQUIRRELVM vm)
         {
             return res; // Propagate the error
         }
-        // Attempt to find the requested task
-        for (const auto & t : s_Tasks)
-        {
-            if (t.mHash == chash && t.mEntity == id && t.mType == type && t.mInterval == intrv)
-            {
-                pos = static_cast< SQInteger >(&t - s_Tasks); // Store the index of this element
-            }
-        }
     }
-    // Should we include the interval in the criteria?
-    else if (top > 2)
+    // Should we include the iterations in the criteria?
+    if (top > 3)
     {
-        SQInteger intrv = 0, sqitr = 0;
-        // Grab the interval from the stack
-        res = sq_getinteger(vm, 3, &intrv);
-        // Validate the result
-        if (SQ_FAILED(res))
-        {
-            return res; // Propagate the error
-        }
         // Grab the iterations from the stack
         res = sq_getinteger(vm, 4, &sqitr);
         // Validate the result
@@ -375,26 +460,20 @@ SQInteger Tasks::Find(int32_t id, int32_t type, SQInteger & pos, HSQUIRRELVM vm)
         {
             return res; // Propagate the error
         }
-        // Cast iterations to the right type
-        const Iterator itr = ConvTo< Iterator >::From(sqitr);
-        // Attempt to find the requested task
-        for (const auto & t : s_Tasks)
-        {
-            if (t.mHash == chash && t.mEntity == id && t.mType == type && t.mInterval == intrv && t.mIterations == itr)
-            {
-                pos = static_cast< SQInteger >(&t - s_Tasks); // Store the index of this element
-            }
-        }
     }
-    else
+    // Cast iterations to the right type
+    const Iterator itr = ConvTo< Iterator >::From(sqitr);
+    // Grab the first task of this entity
+    const int32_t * head = FindHead(id, type);
+    // Attempt to find the requested task among the tasks of this entity
+    for (int32_t i = head ? *head : -1; i >= 0; i = s_Tasks[i].mNext)
     {
-        // Attempt to find the requested task
-        for (const auto & t : s_Tasks)
+        const Task & t = s_Tasks[i];
+        // Does this task match the criteria?
+        if (t.mHash == chash && (top <= 2 || t.mInterval == intrv) && (top <= 3 || t.mIterations == itr))
         {
-            if (t.mHash == chash && t.mEntity == id && t.mType == type)
-            {
-                pos = static_cast< SQInteger >(&t - s_Tasks); // Store the index of this element
-            }
+            pos = static_cast< SQInteger >(i); // Store the index of this element
+            break;
         }
     }
     // We could not find such task
@@ -420,10 +499,8 @@ SQInteger Tasks::Remove(int32_t id, int32_t type, HSQUIRRELVM vm)
     }
     else
     {
-        // Release task resources
+        // Release task resources (also resets the timer)
         s_Tasks[pos].Terminate();
-        // Reset the timer
-        s_Intervals[pos] = 0;
     }
     // Specify that we don't return anything
     return 0;
@@ -450,12 +527,14 @@ SQInteger Tasks::Exists(int32_t id, int32_t type, HSQUIRRELVM vm)
 // ------------------------------------------------------------------------------------------------
 const Tasks::Task & Tasks::FindByTag(int32_t id, int32_t type, StackStrF & tag)
 {
-    // Attempt to find the requested task
-    for (const auto & t : s_Tasks)
+    // Grab the first task of this entity
+    const int32_t * head = FindHead(id, type);
+    // Attempt to find the requested task among the tasks of this entity
+    for (int32_t i = head ? *head : -1; i >= 0; i = s_Tasks[i].mNext)
     {
-        if (t.mEntity == id && t.mType == type && t.mTag == tag.mPtr)
+        if (s_Tasks[i].mTag == tag.mPtr)
         {
-            return t; // Return this task instance
+            return s_Tasks[i]; // Return this task instance
         }
     }
     // Unable to find such task
@@ -467,15 +546,34 @@ const Tasks::Task & Tasks::FindByTag(int32_t id, int32_t type, StackStrF & tag)
 // ------------------------------------------------------------------------------------------------
 void Tasks::Cleanup(int32_t id, int32_t type)
 {
+    int32_t * head = FindHead(id, type);
+    // Does this entity own any tasks?
+    if (head == nullptr)
+    {
+        return;
+    }
+    // Terminate the tasks of this entity (each one unlinks itself and disables the timer)
+    while (*head >= 0)
+    {
+        s_Tasks[*head].Terminate();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger Tasks::TerminateSource(const String & source)
+{
+    SQInteger count = 0;
+    // Iterate task list
     for (auto & t : s_Tasks)
     {
-        if (t.mEntity == id && t.mType == type)
+        if (VALID_ENTITY(t.mEntity) && IsFunctionFromSource(t.mFunc.mObj, source))
         {
-            t.Terminate();
-            // Also disable the timer
-            s_Intervals[&t - s_Tasks] = 0;
+            t.Terminate(); // Also disables the timer
+            ++count;
         }
     }
+    // Return the number of terminated tasks
+    return count;
 }
 
 /* ------------------------------------------------------------------------------------------------
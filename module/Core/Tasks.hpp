@@ -41,6 +41,8 @@ private:
         uint8_t       mType; // The type of the entity to which is belongs.
         uint8_t       mArgc; // The number of arguments that the task must forward.
         Argument    mArgv[8]; // The arguments that the task must forward.
+        int32_t     mPrev; // Previous task slot of the same entity.
+        int32_t     mNext; // Next task slot of the same entity or the next unused slot.
 
         /* ----------------------------------------------------------------------------------------
          * Default constructor.
@@ -58,6 +60,8 @@ private:
             , mType(0)
             , mArgc(0)
             , mArgv()
+            , mPrev(-1)
+            , mNext(-1)
         {
             /* ... */
         }
@@ -132,6 +136,11 @@ private:
         */
         void Terminate()
         {
+            // Give the slot back if it was in use
+            if (VALID_ENTITY(mEntity))
+            {
+                Tasks::Detach(static_cast< int32_t >(this - s_Tasks));
+            }
             Release();
             Clear();
         }
@@ -269,6 +278,9 @@ private:
     static Time         s_Prev; // Previous time point.
     static Interval     s_Intervals[SQMOD_MAX_TASKS]; // List of intervals to be processed.
     static Task         s_Tasks[SQMOD_MAX_TASKS]; // List of tasks to be executed.
+    static int32_t      s_Free; // First unused task slot.
+    static int32_t      s_Used; // Number of used task slots.
+    static int32_t      s_Heads[]; // First task slot of each entity.
 
 public:
 
@@ -329,11 +341,26 @@ protected:
     */
     static LightObj & FindEntity(int32_t id, int32_t type);
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the first task slot of the specified entity. Null if the entity is out of range.
+    */
+    static int32_t * FindHead(int32_t id, int32_t type);
+
     /* --------------------------------------------------------------------------------------------
      * Find an unoccupied task slot.
     */
     static SQInteger FindUnused();
 
+    /* --------------------------------------------------------------------------------------------
+     * Take the specified slot from the unused list and link it to the task entity.
+    */
+    static void Attach(int32_t slot);
+
+    /* --------------------------------------------------------------------------------------------
+     * Unlink the specified slot from the task entity and put it back in the unused list.
+    */
+    static void Detach(int32_t slot);
+
     /* --------------------------------------------------------------------------------------------
      * Locate the first task with the specified parameters.
     */
@@ -366,17 +393,7 @@ public:
     */
     SQMOD_NODISCARD static SQInteger GetUsed()
     {
-        SQInteger n = 0;
-        // Iterate task list
-        for (const auto & t : s_Tasks)
-        {
-            if (VALID_ENTITY(t.mEntity))
-            {
-                ++n;
-            }
-        }
-        // Return the final count
-        return n;
+        return static_cast< SQInteger >(s_Used);
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -384,6 +401,11 @@ public:
     */
     static void Cleanup(int32_t id, int32_t type);
 
+    /* --------------------------------------------------------------------------------------------
+     * Terminate the tasks whose callback was compiled from the specified source.
+    */
+    static SQInteger TerminateSource(const String & source);
+
     /* --------------------------------------------------------------------------------------------
      * Forwards calls to create tasks.
     */
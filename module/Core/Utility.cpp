@@ -2,6 +2,9 @@
 #include "Core/Buffer.hpp"
 #include "Core/Utility.hpp"
 
+// ------------------------------------------------------------------------------------------------
+#include <xxhash.h>
+
 // ------------------------------------------------------------------------------------------------
 #ifdef SQMOD_OS_WINDOWS
     #include <windows.h>
@@ -420,4 +423,94 @@ bool NameFilterCheckInsensitive(const SQChar * filter, const SQChar * name)
     return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+bool NameFilterCheckLowered(const SQChar * filter, const SQChar * name)
+{
+    // If only one of them is null then they don't match
+    if ((!filter && name) || (filter && !name))
+    {
+        return false;
+    }
+    // If they're both null or the filter is empty then there's nothing to check for
+    else if ((!filter && !name) || (*filter == '\0'))
+    {
+        return true;
+    }
+
+    SQChar ch;
+    // Start comparing the strings
+    while (true)
+    {
+        // Grab the current character from filter
+        ch = *(filter++);
+        // See if the filter or name was completed
+        if (ch == '\0' || *name == '\0')
+        {
+            break; // They matched so far
+        }
+        // Are we supposed to perform a wild-card search?
+        else if (ch == '*')
+        {
+            // Grab the next character from filter
+            ch = *(filter++);
+            // Start comparing characters until the first match
+            while (*name != '\0')
+            {
+                if (static_cast< SQChar >(std::tolower(*(name++))) == ch)
+                {
+                    break;
+                }
+            }
+        }
+        // See if the character matches doesn't have to match
+        else if (ch != '?' && static_cast< SQChar >(std::tolower(*name)) != ch)
+        {
+            return false; // The character had to match and failed
+        }
+        else
+        {
+            ++name;
+        }
+    }
+
+    // At this point the name satisfied the filter
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool IsFunctionFromSource(const HSQOBJECT & func, const String & source)
+{
+    // Only script closures have a source
+    if (!sq_isclosure(func))
+    {
+        return false;
+    }
+    // Grab the virtual machine once
+    HSQUIRRELVM vm = SqVM();
+    // Remember the current stack size
+    const StackGuard sg(vm);
+    // Push the function on the stack
+    sq_pushobject(vm, func);
+    // Attempt to retrieve the source name
+    if (SQ_FAILED(sq_getclosuresource(vm, -1)))
+    {
+        return false;
+    }
+    const SQChar * str = nullptr;
+    SQInteger len = 0;
+    // Attempt to retrieve the source name as a string
+    if (SQ_FAILED(sq_getstringandsize(vm, -1, &str, &len)))
+    {
+        return false;
+    }
+    // Compare the source names
+    return source.compare(0, String::npos, str, static_cast< size_t >(len)) == 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t HashName(const SQChar * str, size_t len)
+{
+    return static_cast< size_t >(XXH3_64bits(str, len * sizeof(SQChar)));
+}
+
 } // Namespace:: SqMod
@@ -1346,4 +1346,28 @@ SQMOD_NODISCARD bool NameFilterCheck(const SQChar * filter, const SQChar * name)
 */
 SQMOD_NODISCARD bool NameFilterCheckInsensitive(const SQChar * filter, const SQChar * name);
 
+/* ------------------------------------------------------------------------------------------------
+ * A simple implementation of name filtering without case sensitivity where the filter is already
+ * in lower case. Avoids converting the filter again when it's checked against many names.
+*/
+SQMOD_NODISCARD bool NameFilterCheckLowered(const SQChar * filter, const SQChar * name);
+
+/* ------------------------------------------------------------------------------------------------
+ * See if a script function was compiled from the specified source file.
+*/
+SQMOD_NODISCARD bool IsFunctionFromSource(const HSQOBJECT & func, const String & source);
+
+/* ------------------------------------------------------------------------------------------------
+ * Compute the hash used to identify things by name (XXH3). Lookups must still compare the full name.
+*/
+SQMOD_NODISCARD size_t HashName(const SQChar * str, size_t len);
+
+/* ------------------------------------------------------------------------------------------------
+ * Compute the hash used to identify things by name (XXH3). Lookups must still compare the full name.
+*/
+SQMOD_NODISCARD inline size_t HashName(const String & str)
+{
+    return HashName(str.data(), str.size());
+}
+
 } // Namespace:: SqMod
@@ -12,6 +12,42 @@ namespace SqMod {
 // ------------------------------------------------------------------------------------------------
 SQMOD_DECL_TYPENAME(Typename, _SC("SqObject"))
 
+// ------------------------------------------------------------------------------------------------
+static Vector3 PositionOf(int32_t id)
+{
+    const ObjectInst & inst = Core::Get().GetObj(id);
+    // Is there a position write that was not sent yet?
+    if (inst.mSnapshot.mPending & ESF_POSITION)
+    {
+        return inst.mSnapPosition;
+    }
+    Vector3 vec;
+    // Query the server for the values
+    _Func->GetObjectPosition(id, &vec.x, &vec.y, &vec.z);
+    return vec;
+}
+
+// ------------------------------------------------------------------------------------------------
+static ObjectInst * DeferredOf(int32_t id, uint32_t field)
+{
+    // Are setters applied immediately?
+    if (!g_EntityDeferred)
+    {
+        return nullptr;
+    }
+    ObjectInst & inst = Core::Get().GetObj(id);
+    // The caller stores the value which is sent at the end of the frame
+    inst.mSnapshot.Defer(ENT_OBJECT, id, field);
+    return &inst;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void FlushPending(int32_t id, uint32_t fields)
+{
+    // Pending writes must reach the server before the operation that follows
+    Core::Get().GetObj(id).FlushPending(fields);
+}
+
 // ------------------------------------------------------------------------------------------------
 const int32_t CObject::Max = SQMOD_OBJECT_POOL;
 
@@ -219,6 +255,8 @@ void CObject::MoveTo(const Vector3 & pos, uint32_t time) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending position writes must reach the server before this operation
+    FlushPending(m_ID, ESF_POSITION);
     // Perform the requested operation
     _Func->MoveObjectTo(m_ID, pos.x, pos.y, pos.z, time);
 }
@@ -228,6 +266,8 @@ void CObject::MoveToEx(float x, float y, float z, uint32_t time) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending position writes must reach the server before this operation
+    FlushPending(m_ID, ESF_POSITION);
     // Perform the requested operation
     _Func->MoveObjectTo(m_ID, x, y, z, time);
 }
@@ -237,6 +277,8 @@ void CObject::MoveBy(const Vector3 & pos, uint32_t time) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending position writes must reach the server before this operation
+    FlushPending(m_ID, ESF_POSITION);
     // Perform the requested operation
     _Func->MoveObjectBy(m_ID, pos.x, pos.y, pos.z, time);
 }
@@ -246,6 +288,8 @@ void CObject::MoveByEx(float x, float y, float z, uint32_t time) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending position writes must reach the server before this operation
+    FlushPending(m_ID, ESF_POSITION);
     // Perform the requested operation
     _Func->MoveObjectBy(m_ID, x, y, z, time);
 }
@@ -255,12 +299,8 @@ Vector3 CObject::GetPosition() const
 {
     // Validate the managed identifier
     Validate();
-    // Create a default vector instance
-    Vector3 vec;
-    // Query the server for the values
-    _Func->GetObjectPosition(m_ID, &vec.x, &vec.y, &vec.z);
     // Return the requested information
-    return vec;
+    return PositionOf(m_ID);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -268,6 +308,14 @@ void CObject::SetPosition(const Vector3 & pos) const
 {
     // Validate the managed identifier
     Validate();
+    // Should the write be deferred until the end of the frame?
+    if (ObjectInst * inst = DeferredOf(m_ID, ESF_POSITION))
+    {
+        inst->mSnapPosition = pos;
+        return;
+    }
+    // Pending position writes must reach the server before this operation
+    FlushPending(m_ID, ESF_POSITION);
     // Perform the requested operation
     _Func->SetObjectPosition(m_ID, pos.x, pos.y, pos.z);
 }
@@ -277,6 +325,14 @@ void CObject::SetPositionEx(float x, float y, float z) const
 {
     // Validate the managed identifier
     Validate();
+    // Should the write be deferred until the end of the frame?
+    if (ObjectInst * inst = DeferredOf(m_ID, ESF_POSITION))
+    {
+        inst->mSnapPosition.SetVector3Ex(x, y, z);
+        return;
+    }
+    // Pending position writes must reach the server before this operation
+    FlushPending(m_ID, ESF_POSITION);
     // Perform the requested operation
     _Func->SetObjectPosition(m_ID, x, y, z);
 }
@@ -450,12 +506,8 @@ float CObject::GetPositionX() const
 {
     // Validate the managed identifier
     Validate();
-    // Clear previous information, if any
-    float x = 0.0f, dummy;
-    // Query the server for the requested component value
-    _Func->GetObjectPosition(m_ID, &x, &dummy, &dummy);
     // Return the requested information
-    return x;
+    return PositionOf(m_ID).x;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -463,12 +515,8 @@ float CObject::GetPositionY() const
 {
     // Validate the managed identifier
     Validate();
-    // Clear previous information, if any
-    float y = 0.0f, dummy;
-    // Query the server for the requested component value
-    _Func->GetObjectPosition(m_ID, &dummy, &y, &dummy);
     // Return the requested information
-    return y;
+    return PositionOf(m_ID).y;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -476,12 +524,8 @@ float CObject::GetPositionZ() const
 {
     // Validate the managed identifier
     Validate();
-    // Clear previous information, if any
-    float z = 0.0f, dummy;
-    // Query the server for the requested component value
-    _Func->GetObjectPosition(m_ID, &dummy, &dummy, &z);
     // Return the requested information
-    return z;
+    return PositionOf(m_ID).z;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -489,12 +533,10 @@ void CObject::SetPositionX(float x) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float y, z, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetObjectPosition(m_ID, &dummy, &y, &z);
+    // Retrieve the current values for unchanged components (pending values included)
+    const Vector3 pos = PositionOf(m_ID);
     // Perform the requested operation
-    _Func->SetObjectPosition(m_ID, x, y, z);
+    SetPositionEx(x, pos.y, pos.z);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -502,12 +544,10 @@ void CObject::SetPositionY(float y) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float x, z, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetObjectPosition(m_ID, &x, &dummy, &z);
+    // Retrieve the current values for unchanged components (pending values included)
+    const Vector3 pos = PositionOf(m_ID);
     // Perform the requested operation
-    _Func->SetObjectPosition(m_ID, x, y, z);
+    SetPositionEx(pos.x, y, pos.z);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -515,12 +555,10 @@ void CObject::SetPositionZ(float z) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float x, y, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetObjectPosition(m_ID, &x, &y, &dummy);
+    // Retrieve the current values for unchanged components (pending values included)
+    const Vector3 pos = PositionOf(m_ID);
     // Perform the requested operation
-    _Func->SetObjectPosition(m_ID, x, y, z);
+    SetPositionEx(pos.x, pos.y, z);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -619,6 +657,8 @@ void CObject::MoveToX(float x) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending position writes must reach the server before this operation
+    FlushPending(m_ID, ESF_POSITION);
     // Reserve some temporary floats to retrieve the missing components
     float y, z, dummy;
     // Retrieve the current values for unchanged components
@@ -632,6 +672,8 @@ void CObject::MoveToY(float y) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending position writes must reach the server before this operation
+    FlushPending(m_ID, ESF_POSITION);
     // Reserve some temporary floats to retrieve the missing components
     float x, z, dummy;
     // Retrieve the current values for unchanged components
@@ -645,6 +687,8 @@ void CObject::MoveToZ(float z) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending position writes must reach the server before this operation
+    FlushPending(m_ID, ESF_POSITION);
     // Reserve some temporary floats to retrieve the missing components
     float x, y, dummy;
     // Retrieve the current values for unchanged components
@@ -658,6 +702,8 @@ void CObject::MoveByX(float x) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending position writes must reach the server before this operation
+    FlushPending(m_ID, ESF_POSITION);
     // Perform the requested operation
     _Func->MoveObjectBy(m_ID, x, 0.0f, 0.0f, mMoveByDuration);
 }
@@ -667,6 +713,8 @@ void CObject::MoveByY(float y) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending position writes must reach the server before this operation
+    FlushPending(m_ID, ESF_POSITION);
     // Perform the requested operation
     _Func->MoveObjectBy(m_ID, 0.0f, y, 0.0f, mMoveByDuration);
 }
@@ -676,6 +724,8 @@ void CObject::MoveByZ(float z) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending position writes must reach the server before this operation
+    FlushPending(m_ID, ESF_POSITION);
     // Perform the requested operation
     _Func->MoveObjectBy(m_ID, 0.0f, 0.0f, z, mMoveByDuration);
 }
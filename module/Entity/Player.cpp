@@ -18,6 +18,52 @@ extern SQRESULT SqGrabPlayerMessageColor(HSQUIRRELVM vm, int32_t idx, uint32_t &
 // ------------------------------------------------------------------------------------------------
 SQMOD_DECL_TYPENAME(Typename, _SC("SqPlayer"))
 
+// ------------------------------------------------------------------------------------------------
+static PlayerInst & SnapshotOf(int32_t id, uint32_t field)
+{
+    PlayerInst & inst = Core::Get().GetPlayer(id);
+    // Query the server only if the field was not cached during this frame
+    if (!inst.mSnapshot.Has(field))
+    {
+        switch (field)
+        {
+            case ESF_POSITION:
+                _Func->GetPlayerPosition(id, &inst.mSnapPosition.x, &inst.mSnapPosition.y, &inst.mSnapPosition.z);
+                break;
+            case ESF_HEADING: inst.mSnapHeading = _Func->GetPlayerHeading(id); break;
+            case ESF_HEALTH: inst.mSnapHealth = _Func->GetPlayerHealth(id); break;
+            case ESF_ARMOUR: inst.mSnapArmour = _Func->GetPlayerArmour(id); break;
+            case ESF_WEAPON: inst.mSnapWeapon = _Func->GetPlayerWeapon(id); break;
+            default: STHROWF("Unknown player snapshot field: {}", field);
+        }
+        inst.mSnapshot.Store(field);
+    }
+    return inst;
+}
+
+// ------------------------------------------------------------------------------------------------
+static PlayerInst * DeferredOf(int32_t id, uint32_t field)
+{
+    // Are setters applied immediately?
+    if (!g_EntityDeferred)
+    {
+        return nullptr;
+    }
+    PlayerInst & inst = Core::Get().GetPlayer(id);
+    // The caller stores the value which is sent at the end of the frame
+    inst.mSnapshot.Defer(ENT_PLAYER, id, field);
+    return &inst;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void InvalidateSnapshot(int32_t id, uint32_t fields)
+{
+    PlayerInst & inst = Core::Get().GetPlayer(id);
+    // Pending writes must reach the server before this operation
+    inst.FlushPending(fields);
+    inst.mSnapshot.Invalidate(fields);
+}
+
 // ------------------------------------------------------------------------------------------------
 SQChar  CPlayer::s_Buffer[SQMOD_PLAYER_TMP_BUFFER];
 
@@ -233,6 +279,8 @@ void CPlayer::Kill() const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_HEALTH);
     // Perform the requested operation
     _Func->KillPlayer(m_ID);
 }
@@ -622,6 +670,8 @@ void CPlayer::ForceSpawn() const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_ALL);
     // Perform the requested operation
     _Func->ForcePlayerSpawn(m_ID);
 }
@@ -631,6 +681,8 @@ void CPlayer::ForceSelect() const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_ALL);
     // Perform the requested operation
     _Func->ForcePlayerSelect(m_ID);
 }
@@ -786,7 +838,7 @@ float CPlayer::GetHealth() const
     // Validate the managed identifier
     Validate();
     // Return the requested information
-    return _Func->GetPlayerHealth(m_ID);
+    return SnapshotOf(m_ID, ESF_HEALTH).mSnapHealth;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -794,6 +846,14 @@ void CPlayer::SetHealth(float amount) const
 {
     // Validate the managed identifier
     Validate();
+    // Should the write be deferred until the end of the frame?
+    if (PlayerInst * inst = DeferredOf(m_ID, ESF_HEALTH))
+    {
+        inst->mSnapHealth = amount;
+        return;
+    }
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_HEALTH);
     // Perform the requested operation
     _Func->SetPlayerHealth(m_ID, amount);
 }
@@ -804,7 +864,7 @@ float CPlayer::GetArmor() const
     // Validate the managed identifier
     Validate();
     // Return the requested information
-    return _Func->GetPlayerArmour(m_ID);
+    return SnapshotOf(m_ID, ESF_ARMOUR).mSnapArmour;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -812,6 +872,14 @@ void CPlayer::SetArmor(float amount) const
 {
     // Validate the managed identifier
     Validate();
+    // Should the write be deferred until the end of the frame?
+    if (PlayerInst * inst = DeferredOf(m_ID, ESF_ARMOUR))
+    {
+        inst->mSnapArmour = amount;
+        return;
+    }
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_ARMOUR);
     // Perform the requested operation
     _Func->SetPlayerArmour(m_ID, amount);
 }
@@ -849,12 +917,8 @@ Vector3 CPlayer::GetPosition() const
 {
     // Validate the managed identifier
     Validate();
-    // Create a default vector instance
-    Vector3 vec;
-    // Query the server for the values
-    _Func->GetPlayerPosition(m_ID, &vec.x, &vec.y, &vec.z);
     // Return the requested information
-    return vec;
+    return SnapshotOf(m_ID, ESF_POSITION).mSnapPosition;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -862,6 +926,14 @@ void CPlayer::SetPosition(const Vector3 & pos) const
 {
     // Validate the managed identifier
     Validate();
+    // Should the write be deferred until the end of the frame?
+    if (PlayerInst * inst = DeferredOf(m_ID, ESF_POSITION))
+    {
+        inst->mSnapPosition = pos;
+        return;
+    }
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_POSITION);
     // Perform the requested operation
     _Func->SetPlayerPosition(m_ID, pos.x, pos.y, pos.z);
 }
@@ -871,6 +943,14 @@ void CPlayer::SetPositionEx(float x, float y, float z) const
 {
     // Validate the managed identifier
     Validate();
+    // Should the write be deferred until the end of the frame?
+    if (PlayerInst * inst = DeferredOf(m_ID, ESF_POSITION))
+    {
+        inst->mSnapPosition.SetVector3Ex(x, y, z);
+        return;
+    }
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_POSITION);
     // Perform the requested operation
     _Func->SetPlayerPosition(m_ID, x, y, z);
 }
@@ -930,7 +1010,7 @@ float CPlayer::GetHeading() const
     // Validate the managed identifier
     Validate();
     // Return the requested information
-    return _Func->GetPlayerHeading(m_ID);
+    return SnapshotOf(m_ID, ESF_HEADING).mSnapHeading;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -938,6 +1018,14 @@ void CPlayer::SetHeading(float angle) const
 {
     // Validate the managed identifier
     Validate();
+    // Should the write be deferred until the end of the frame?
+    if (PlayerInst * inst = DeferredOf(m_ID, ESF_HEADING))
+    {
+        inst->mSnapHeading = angle;
+        return;
+    }
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_HEADING);
     // Perform the requested operation
     _Func->SetPlayerHeading(m_ID, angle);
 }
@@ -1066,6 +1154,8 @@ bool CPlayer::Embark(CVehicle & vehicle)
         // Now forward the event call
         Core::Get().EmitPlayerEmbarking(m_ID, vehicle.GetID(), 0);
     }
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_POSITION | ESF_HEADING);
     // Perform the requested operation
     return (_Func->PutPlayerInVehicle(m_ID, vehicle.GetID(), 0,
         static_cast< uint8_t >(true), static_cast< uint8_t >(true)) != vcmpErrorRequestDenied);
@@ -1094,6 +1184,8 @@ bool CPlayer::EmbarkEx(CVehicle & vehicle, int32_t slot, bool allocate, bool war
         // Now forward the event call
         Core::Get().EmitPlayerEmbarking(m_ID, vehicle.GetID(), slot);
     }
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_POSITION | ESF_HEADING);
     // Perform the requested operation
     return (_Func->PutPlayerInVehicle(m_ID, vehicle.GetID(), slot,
         static_cast< uint8_t >(allocate), static_cast< uint8_t >(warp)) != vcmpErrorRequestDenied);
@@ -1104,6 +1196,8 @@ void CPlayer::Disembark() const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_POSITION | ESF_HEADING);
     // Perform the requested operation
     _Func->RemovePlayerFromVehicle(m_ID);
 }
@@ -1158,7 +1252,7 @@ int32_t CPlayer::GetWeapon() const
     // Validate the managed identifier
     Validate();
     // Return the requested information
-    return _Func->GetPlayerWeapon(m_ID);
+    return SnapshotOf(m_ID, ESF_WEAPON).mSnapWeapon;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1166,6 +1260,8 @@ void CPlayer::SetWeapon(int32_t wep) const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_WEAPON);
     // Perform the requested operation
     if (_Func->SetPlayerWeapon(m_ID, wep, mDefaultAmmo) == vcmpErrorArgumentOutOfBounds)
     {
@@ -1178,6 +1274,8 @@ void CPlayer::SetWeaponEx(int32_t wep, int32_t ammo) const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_WEAPON);
     // Perform the requested operation
     if (_Func->SetPlayerWeapon(m_ID, wep, ammo) == vcmpErrorArgumentOutOfBounds)
     {
@@ -1190,6 +1288,8 @@ void CPlayer::GiveWeapon(int32_t wep, int32_t ammo) const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_WEAPON);
     // Perform the requested operation
     if (_Func->GivePlayerWeapon(m_ID, wep, ammo) == vcmpErrorArgumentOutOfBounds)
     {
@@ -1220,6 +1320,8 @@ void CPlayer::SetWeaponSlot(int32_t slot) const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_WEAPON);
     // Perform the requested operation
     if (_Func->SetPlayerWeaponSlot(m_ID, slot) == vcmpErrorArgumentOutOfBounds)
     {
@@ -1260,6 +1362,8 @@ void CPlayer::RemoveWeapon(int32_t wep) const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_WEAPON);
     // Perform the requested operation
     _Func->RemovePlayerWeapon(m_ID, wep);
 }
@@ -1269,6 +1373,8 @@ void CPlayer::StripWeapons() const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_WEAPON);
     // Perform the requested operation
     _Func->RemoveAllWeapons(m_ID);
 }
@@ -2005,12 +2111,8 @@ float CPlayer::GetPositionX() const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve a temporary float to retrieve the requested component
-    float x = 0.0f, dummy;
-    // Query the server for the requested component value
-    _Func->GetPlayerPosition(m_ID, &x, &dummy, &dummy);
     // Return the requested information
-    return x;
+    return SnapshotOf(m_ID, ESF_POSITION).mSnapPosition.x;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -2018,12 +2120,8 @@ float CPlayer::GetPositionY() const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve a temporary float to retrieve the requested component
-    float y = 0.0f, dummy;
-    // Query the server for the requested component value
-    _Func->GetPlayerPosition(m_ID, &dummy, &y, &dummy);
     // Return the requested information
-    return y;
+    return SnapshotOf(m_ID, ESF_POSITION).mSnapPosition.y;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -2031,12 +2129,8 @@ float CPlayer::GetPositionZ() const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve a temporary float to retrieve the requested component
-    float z = 0.0f, dummy;
-    // Query the server for the requested component value
-    _Func->GetPlayerPosition(m_ID, &dummy, &dummy, &z);
     // Return the requested information
-    return z;
+    return SnapshotOf(m_ID, ESF_POSITION).mSnapPosition.z;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -2044,12 +2138,10 @@ void CPlayer::SetPositionX(float x) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float y, z, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetPlayerPosition(m_ID, &dummy, &y, &z);
+    // Retrieve the current values for unchanged components (pending values included)
+    const Vector3 & pos = SnapshotOf(m_ID, ESF_POSITION).mSnapPosition;
     // Perform the requested operation
-    _Func->SetPlayerPosition(m_ID, x, y, z);
+    SetPositionEx(x, pos.y, pos.z);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -2057,12 +2149,10 @@ void CPlayer::SetPositionY(float y) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float x, z, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetPlayerPosition(m_ID, &x, &dummy, &z);
+    // Retrieve the current values for unchanged components (pending values included)
+    const Vector3 & pos = SnapshotOf(m_ID, ESF_POSITION).mSnapPosition;
     // Perform the requested operation
-    _Func->SetPlayerPosition(m_ID, x, y, z);
+    SetPositionEx(pos.x, y, pos.z);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -2070,12 +2160,10 @@ void CPlayer::SetPositionZ(float z) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float x, y, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetPlayerPosition(m_ID, &x, &y, &dummy);
+    // Retrieve the current values for unchanged components (pending values included)
+    const Vector3 & pos = SnapshotOf(m_ID, ESF_POSITION).mSnapPosition;
     // Perform the requested operation
-    _Func->SetPlayerPosition(m_ID, x, y, z);
+    SetPositionEx(pos.x, pos.y, z);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -14,6 +14,60 @@ namespace SqMod {
 // ------------------------------------------------------------------------------------------------
 SQMOD_DECL_TYPENAME(Typename, _SC("SqVehicle"))
 
+// ------------------------------------------------------------------------------------------------
+static VehicleInst & SnapshotOf(int32_t id, uint32_t field)
+{
+    VehicleInst & inst = Core::Get().GetVehicle(id);
+    // Query the server only if the field was not cached during this frame
+    if (!inst.mSnapshot.Has(field))
+    {
+        switch (field)
+        {
+            case ESF_POSITION:
+                _Func->GetVehiclePosition(id, &inst.mSnapPosition.x, &inst.mSnapPosition.y, &inst.mSnapPosition.z);
+                break;
+            case ESF_ROTATION:
+                _Func->GetVehicleRotation(id, &inst.mSnapRotation.x, &inst.mSnapRotation.y,
+                                                &inst.mSnapRotation.z, &inst.mSnapRotation.w);
+                break;
+            case ESF_HEALTH: inst.mSnapHealth = _Func->GetVehicleHealth(id); break;
+            default: STHROWF("Unknown vehicle snapshot field: {}", field);
+        }
+        inst.mSnapshot.Store(field);
+    }
+    return inst;
+}
+
+// ------------------------------------------------------------------------------------------------
+static VehicleInst * DeferredOf(int32_t id, uint32_t field)
+{
+    // Are setters applied immediately?
+    if (!g_EntityDeferred)
+    {
+        return nullptr;
+    }
+    VehicleInst & inst = Core::Get().GetVehicle(id);
+    // The caller stores the value which is sent at the end of the frame
+    inst.mSnapshot.Defer(ENT_VEHICLE, id, field);
+    return &inst;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void InvalidateSnapshot(int32_t id, uint32_t fields)
+{
+    VehicleInst & inst = Core::Get().GetVehicle(id);
+    // Pending writes must reach the server before this operation
+    inst.FlushPending(fields);
+    inst.mSnapshot.Invalidate(fields);
+}
+
+// ------------------------------------------------------------------------------------------------
+static void FlushPendingOf(int32_t id, uint32_t fields)
+{
+    // Pending writes must reach the server before it is queried
+    Core::Get().GetVehicle(id).FlushPending(fields);
+}
+
 // ------------------------------------------------------------------------------------------------
 const int32_t CVehicle::Max = SQMOD_VEHICLE_POOL;
 
@@ -303,6 +357,8 @@ void CVehicle::Respawn() const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_ALL);
     // Perform the requested operation
     _Func->RespawnVehicle(m_ID);
 }
@@ -340,6 +396,8 @@ void CVehicle::Explode() const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_HEALTH);
     // Perform the requested operation
     _Func->ExplodeVehicle(m_ID);
 }
@@ -380,12 +438,8 @@ Vector3 CVehicle::GetPosition() const
 {
     // Validate the managed identifier
     Validate();
-    // Create a default vector instance
-    Vector3 vec;
-    // Query the server for the values
-    _Func->GetVehiclePosition(m_ID, &vec.x, &vec.y, &vec.z);
     // Return the requested information
-    return vec;
+    return SnapshotOf(m_ID, ESF_POSITION).mSnapPosition;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -393,6 +447,14 @@ void CVehicle::SetPosition(const Vector3 & pos) const
 {
     // Validate the managed identifier
     Validate();
+    // Should the write be deferred until the end of the frame?
+    if (VehicleInst * inst = DeferredOf(m_ID, ESF_POSITION))
+    {
+        inst->mSnapPosition = pos;
+        return;
+    }
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_POSITION);
     // Perform the requested operation
     _Func->SetVehiclePosition(m_ID, pos.x, pos.y, pos.z, static_cast< uint8_t >(false));
 }
@@ -402,6 +464,8 @@ void CVehicle::SetPositionB(const Vector3 & pos, bool empty) const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_POSITION);
     // Perform the requested operation
     _Func->SetVehiclePosition(m_ID, pos.x, pos.y, pos.z, static_cast< uint8_t >(empty));
 }
@@ -411,6 +475,14 @@ void CVehicle::SetPositionEx(float x, float y, float z) const
 {
     // Validate the managed identifier
     Validate();
+    // Should the write be deferred until the end of the frame?
+    if (VehicleInst * inst = DeferredOf(m_ID, ESF_POSITION))
+    {
+        inst->mSnapPosition.SetVector3Ex(x, y, z);
+        return;
+    }
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_POSITION);
     // Perform the requested operation
     _Func->SetVehiclePosition(m_ID, x, y, z, static_cast< uint8_t >(false));
 }
@@ -420,6 +492,8 @@ void CVehicle::SetPositionExB(float x, float y, float z, bool empty) const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_POSITION);
     // Perform the requested operation
     _Func->SetVehiclePosition(m_ID, x, y, z, static_cast< uint8_t >(empty));
 }
@@ -429,12 +503,8 @@ Quaternion CVehicle::GetRotation() const
 {
     // Validate the managed identifier
     Validate();
-    // Create a default quaternion instance
-    Quaternion q;
-    // Query the server for the values
-    _Func->GetVehicleRotation(m_ID, &q.x, &q.y, &q.z, &q.w);
     // Return the requested information
-    return q;
+    return SnapshotOf(m_ID, ESF_ROTATION).mSnapRotation;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -442,6 +512,14 @@ void CVehicle::SetRotation(const Quaternion & rot) const
 {
     // Validate the managed identifier
     Validate();
+    // Should the write be deferred until the end of the frame?
+    if (VehicleInst * inst = DeferredOf(m_ID, ESF_ROTATION))
+    {
+        inst->mSnapRotation = rot;
+        return;
+    }
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_ROTATION);
     // Perform the requested operation
     _Func->SetVehicleRotation(m_ID, rot.x, rot.y, rot.z, rot.w);
 }
@@ -451,6 +529,14 @@ void CVehicle::SetRotationEx(float x, float y, float z, float w) const
 {
     // Validate the managed identifier
     Validate();
+    // Should the write be deferred until the end of the frame?
+    if (VehicleInst * inst = DeferredOf(m_ID, ESF_ROTATION))
+    {
+        inst->mSnapRotation.SetQuaternionEx(x, y, z, w);
+        return;
+    }
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_ROTATION);
     // Perform the requested operation
     _Func->SetVehicleRotation(m_ID, x, y, z, w);
 }
@@ -460,6 +546,8 @@ Vector3 CVehicle::GetRotationEuler() const
 {
     // Validate the managed identifier
     Validate();
+    // Euler angles can only be obtained from the server
+    FlushPendingOf(m_ID, ESF_ROTATION);
     // Create a default vector instance
     Vector3 vec;
     // Query the server for the values
@@ -473,6 +561,8 @@ void CVehicle::SetRotationEuler(const Vector3 & rot) const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_ROTATION);
     // Perform the requested operation
     _Func->SetVehicleRotationEuler(m_ID, rot.x, rot.y, rot.z);
 }
@@ -482,6 +572,8 @@ void CVehicle::SetRotationEulerEx(float x, float y, float z) const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_ROTATION);
     // Perform the requested operation
     _Func->SetVehicleRotationEuler(m_ID, x, y, z);
 }
@@ -491,6 +583,12 @@ Vector3 CVehicle::GetSpeed() const
 {
     // Validate the managed identifier
     Validate();
+    // Is there a speed write that was not sent yet?
+    const VehicleInst & inst = Core::Get().GetVehicle(m_ID);
+    if (inst.mSnapshot.mPending & ESF_SPEED)
+    {
+        return inst.mSnapSpeed;
+    }
     // Create a default vector instance
     Vector3 vec;
     // Query the server for the values
@@ -504,6 +602,14 @@ void CVehicle::SetSpeed(const Vector3 & vel) const
 {
     // Validate the managed identifier
     Validate();
+    // Should the write be deferred until the end of the frame?
+    if (VehicleInst * inst = DeferredOf(m_ID, ESF_SPEED))
+    {
+        inst->mSnapSpeed = vel;
+        return;
+    }
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_SPEED);
     // Perform the requested operation
     _Func->SetVehicleSpeed(m_ID, vel.x, vel.y, vel.z,
                            static_cast< uint8_t >(false), static_cast< uint8_t >(false));
@@ -514,6 +620,14 @@ void CVehicle::SetSpeedEx(float x, float y, float z) const
 {
     // Validate the managed identifier
     Validate();
+    // Should the write be deferred until the end of the frame?
+    if (VehicleInst * inst = DeferredOf(m_ID, ESF_SPEED))
+    {
+        inst->mSnapSpeed.SetVector3Ex(x, y, z);
+        return;
+    }
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_SPEED);
     // Perform the requested operation
     _Func->SetVehicleSpeed(m_ID, x, y, z, static_cast< uint8_t >(false), static_cast< uint8_t >(false));
 }
@@ -523,6 +637,8 @@ void CVehicle::AddSpeed(const Vector3 & vel) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending speed writes must reach the server before this operation
+    InvalidateSnapshot(m_ID, ESF_SPEED);
     // Perform the requested operation
     _Func->SetVehicleSpeed(m_ID, vel.x, vel.y, vel.z,
                            static_cast< uint8_t >(true), static_cast< uint8_t >(false));
@@ -533,6 +649,8 @@ void CVehicle::AddSpeedEx(float x, float y, float z) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending speed writes must reach the server before this operation
+    InvalidateSnapshot(m_ID, ESF_SPEED);
     // Perform the requested operation
     _Func->SetVehicleSpeed(m_ID, x, y, z, static_cast< uint8_t >(true), static_cast< uint8_t >(false));
 }
@@ -542,6 +660,8 @@ Vector3 CVehicle::GetRelativeSpeed() const
 {
     // Validate the managed identifier
     Validate();
+    // Pending speed writes must reach the server before this operation
+    InvalidateSnapshot(m_ID, ESF_SPEED);
     // Create a default vector instance
     Vector3 vec;
     // Query the server for the values
@@ -555,6 +675,8 @@ void CVehicle::SetRelativeSpeed(const Vector3 & vel) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending speed writes must reach the server before this operation
+    InvalidateSnapshot(m_ID, ESF_SPEED);
     // Perform the requested operation
     _Func->SetVehicleSpeed(m_ID, vel.x, vel.y, vel.z,
                            static_cast< uint8_t >(false), static_cast< uint8_t >(true));
@@ -565,6 +687,8 @@ void CVehicle::SetRelativeSpeedEx(float x, float y, float z) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending speed writes must reach the server before this operation
+    InvalidateSnapshot(m_ID, ESF_SPEED);
     // Perform the requested operation
     _Func->SetVehicleSpeed(m_ID, x, y, z, static_cast< uint8_t >(false), static_cast< uint8_t >(true));
 }
@@ -574,6 +698,8 @@ void CVehicle::AddRelativeSpeed(const Vector3 & vel) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending speed writes must reach the server before this operation
+    InvalidateSnapshot(m_ID, ESF_SPEED);
     // Perform the requested operation
     _Func->SetVehicleSpeed(m_ID, vel.x, vel.y, vel.z,
                            static_cast< uint8_t >(true), static_cast< uint8_t >(true));
@@ -584,6 +710,8 @@ void CVehicle::AddRelativeSpeedEx(float x, float y, float z) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending speed writes must reach the server before this operation
+    InvalidateSnapshot(m_ID, ESF_SPEED);
     // Perform the requested operation
     _Func->SetVehicleSpeed(m_ID, x, y, z, static_cast< uint8_t >(true), static_cast< uint8_t >(true));
 }
@@ -811,7 +939,7 @@ float CVehicle::GetHealth() const
     // Validate the managed identifier
     Validate();
     // Return the requested information
-    return _Func->GetVehicleHealth(m_ID);
+    return SnapshotOf(m_ID, ESF_HEALTH).mSnapHealth;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -819,6 +947,14 @@ void CVehicle::SetHealth(float amount) const
 {
     // Validate the managed identifier
     Validate();
+    // Should the write be deferred until the end of the frame?
+    if (VehicleInst * inst = DeferredOf(m_ID, ESF_HEALTH))
+    {
+        inst->mSnapHealth = amount;
+        return;
+    }
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_HEALTH);
     // Perform the requested operation
     _Func->SetVehicleHealth(m_ID, amount);
 }
@@ -828,6 +964,8 @@ void CVehicle::Fix() const
 {
     // Validate the managed identifier
     Validate();
+    // Discard the cached state that this operation modifies
+    InvalidateSnapshot(m_ID, ESF_HEALTH);
     // Perform the requested operation
     _Func->SetVehicleHealth(m_ID, 1000);
     _Func->SetVehicleDamageData(m_ID, 0);
@@ -1448,12 +1586,8 @@ float CVehicle::GetPositionX() const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve a temporary float to retrieve the requested component
-    float x = 0.0f, dummy;
-    // Query the server for the requested component value
-    _Func->GetVehiclePosition(m_ID, &x, &dummy, &dummy);
     // Return the requested information
-    return x;
+    return SnapshotOf(m_ID, ESF_POSITION).mSnapPosition.x;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1461,12 +1595,8 @@ float CVehicle::GetPositionY() const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve a temporary float to retrieve the requested component
-    float y = 0.0f, dummy;
-    // Query the server for the requested component value
-    _Func->GetVehiclePosition(m_ID, &dummy, &y, &dummy);
     // Return the requested information
-    return y;
+    return SnapshotOf(m_ID, ESF_POSITION).mSnapPosition.y;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1474,12 +1604,8 @@ float CVehicle::GetPositionZ() const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve a temporary float to retrieve the requested component
-    float z = 0.0f, dummy;
-    // Query the server for the requested component value
-    _Func->GetVehiclePosition(m_ID, &dummy, &dummy, &z);
     // Return the requested information
-    return z;
+    return SnapshotOf(m_ID, ESF_POSITION).mSnapPosition.z;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1487,12 +1613,10 @@ void CVehicle::SetPositionX(float x) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float y, z, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetVehiclePosition(m_ID, &dummy, &y, &z);
+    // Retrieve the current values for unchanged components (pending values included)
+    const Vector3 & pos = SnapshotOf(m_ID, ESF_POSITION).mSnapPosition;
     // Perform the requested operation
-    _Func->SetVehiclePosition(m_ID, x, y, z, static_cast< uint8_t >(false));
+    SetPositionEx(x, pos.y, pos.z);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1500,12 +1624,10 @@ void CVehicle::SetPositionY(float y) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float x, z, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetVehiclePosition(m_ID, &x, &dummy, &z);
+    // Retrieve the current values for unchanged components (pending values included)
+    const Vector3 & pos = SnapshotOf(m_ID, ESF_POSITION).mSnapPosition;
     // Perform the requested operation
-    _Func->SetVehiclePosition(m_ID, x, y, z, static_cast< uint8_t >(false));
+    SetPositionEx(pos.x, y, pos.z);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1513,12 +1635,10 @@ void CVehicle::SetPositionZ(float z) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float x, y, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetVehiclePosition(m_ID, &x, &y, &dummy);
+    // Retrieve the current values for unchanged components (pending values included)
+    const Vector3 & pos = SnapshotOf(m_ID, ESF_POSITION).mSnapPosition;
     // Perform the requested operation
-    _Func->SetVehiclePosition(m_ID, x, y, z, static_cast< uint8_t >(false));
+    SetPositionEx(pos.x, pos.y, z);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1526,12 +1646,8 @@ float CVehicle::GetRotationX() const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve a temporary float to retrieve the requested component
-    float x = 0.0f, dummy;
-    // Query the server for the requested component value
-    _Func->GetVehicleRotation(m_ID, &x, &dummy, &dummy, &dummy);
     // Return the requested information
-    return x;
+    return SnapshotOf(m_ID, ESF_ROTATION).mSnapRotation.x;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1539,12 +1655,8 @@ float CVehicle::GetRotationY() const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve a temporary float to retrieve the requested component
-    float y = 0.0f, dummy;
-    // Query the server for the requested component value
-    _Func->GetVehicleRotation(m_ID, &dummy, &y, &dummy, &dummy);
     // Return the requested information
-    return y;
+    return SnapshotOf(m_ID, ESF_ROTATION).mSnapRotation.y;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1552,12 +1664,8 @@ float CVehicle::GetRotationZ() const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve a temporary float to retrieve the requested component
-    float z = 0.0f, dummy;
-    // Query the server for the requested component value
-    _Func->GetVehicleRotation(m_ID, &dummy, &dummy, &z, &dummy);
     // Return the requested information
-    return z;
+    return SnapshotOf(m_ID, ESF_ROTATION).mSnapRotation.z;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1565,12 +1673,8 @@ float CVehicle::GetRotationW() const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve a temporary float to retrieve the requested component
-    float w = 0.0f, dummy;
-    // Query the server for the requested component value
-    _Func->GetVehicleRotation(m_ID, &dummy, &dummy, &dummy, &w);
     // Return the requested information
-    return w;
+    return SnapshotOf(m_ID, ESF_ROTATION).mSnapRotation.w;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1578,12 +1682,10 @@ void CVehicle::SetRotationX(float x) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float y, z, w, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetVehicleRotation(m_ID, &dummy, &y, &z, &w);
+    // Retrieve the current values for unchanged components (pending values included)
+    const Quaternion & rot = SnapshotOf(m_ID, ESF_ROTATION).mSnapRotation;
     // Perform the requested operation
-    _Func->SetVehicleRotation(m_ID, x, y, z, w);
+    SetRotationEx(x, rot.y, rot.z, rot.w);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1591,12 +1693,10 @@ void CVehicle::SetRotationY(float y) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float x, z, w, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetVehicleRotation(m_ID, &x, &dummy, &z, &w);
+    // Retrieve the current values for unchanged components (pending values included)
+    const Quaternion & rot = SnapshotOf(m_ID, ESF_ROTATION).mSnapRotation;
     // Perform the requested operation
-    _Func->SetVehicleRotation(m_ID, x, y, z, w);
+    SetRotationEx(rot.x, y, rot.z, rot.w);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1604,12 +1704,10 @@ void CVehicle::SetRotationZ(float z) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float x, y, w, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetVehicleRotation(m_ID, &x, &y, &dummy, &w);
+    // Retrieve the current values for unchanged components (pending values included)
+    const Quaternion & rot = SnapshotOf(m_ID, ESF_ROTATION).mSnapRotation;
     // Perform the requested operation
-    _Func->SetVehicleRotation(m_ID, x, y, z, w);
+    SetRotationEx(rot.x, rot.y, z, rot.w);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1617,12 +1715,10 @@ void CVehicle::SetRotationW(float w) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float x, y, z, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetVehicleRotation(m_ID, &x, &y, &z, &dummy);
+    // Retrieve the current values for unchanged components (pending values included)
+    const Quaternion & rot = SnapshotOf(m_ID, ESF_ROTATION).mSnapRotation;
     // Perform the requested operation
-    _Func->SetVehicleRotation(m_ID, x, y, z, w);
+    SetRotationEx(rot.x, rot.y, rot.z, w);
 }
 
 
@@ -1633,6 +1729,8 @@ float CVehicle::GetEulerRotationX() const
     Validate();
     // Reserve a temporary float to retrieve the requested component
     float x = 0.0f, dummy;
+    // Euler angles can only be obtained from the server
+    FlushPendingOf(m_ID, ESF_ROTATION);
     // Query the server for the requested component value
     _Func->GetVehicleRotationEuler(m_ID, &x, &dummy, &dummy);
     // Return the requested information
@@ -1646,6 +1744,8 @@ float CVehicle::GetEulerRotationY() const
     Validate();
     // Reserve a temporary float to retrieve the requested component
     float y = 0.0f, dummy;
+    // Euler angles can only be obtained from the server
+    FlushPendingOf(m_ID, ESF_ROTATION);
     // Query the server for the requested component value
     _Func->GetVehicleRotationEuler(m_ID, &dummy, &y, &dummy);
     // Return the requested information
@@ -1659,6 +1759,8 @@ float CVehicle::GetEulerRotationZ() const
     Validate();
     // Reserve a temporary float to retrieve the requested component
     float z = 0.0f, dummy;
+    // Euler angles can only be obtained from the server
+    FlushPendingOf(m_ID, ESF_ROTATION);
     // Query the server for the requested component value
     _Func->GetVehicleRotationEuler(m_ID, &dummy, &dummy, &z);
     // Return the requested information
@@ -1672,6 +1774,8 @@ void CVehicle::SetEulerRotationX(float x) const
     Validate();
     // Reserve some temporary floats to retrieve the missing components
     float y, z, dummy;
+    // Discard the cached state that this operation modifies (pending writes are sent first)
+    InvalidateSnapshot(m_ID, ESF_ROTATION);
     // Retrieve the current values for unchanged components
     _Func->GetVehicleRotationEuler(m_ID, &dummy, &y, &z);
     // Perform the requested operation
@@ -1685,6 +1789,8 @@ void CVehicle::SetEulerRotationY(float y) const
     Validate();
     // Reserve some temporary floats to retrieve the missing components
     float x, z, dummy;
+    // Discard the cached state that this operation modifies (pending writes are sent first)
+    InvalidateSnapshot(m_ID, ESF_ROTATION);
     // Retrieve the current values for unchanged components
     _Func->GetVehicleRotationEuler(m_ID, &x, &dummy, &z);
     // Perform the requested operation
@@ -1698,10 +1804,12 @@ void CVehicle::SetEulerRotationZ(float z) const
     Validate();
     // Reserve some temporary floats to retrieve the missing components
     float x, y, dummy;
+    // Discard the cached state that this operation modifies (pending writes are sent first)
+    InvalidateSnapshot(m_ID, ESF_ROTATION);
     // Retrieve the current values for unchanged components
     _Func->GetVehicleRotationEuler(m_ID, &x, &y, &dummy);
     // Perform the requested operation
-    _Func->SetVehicleRotationEuler(m_ID, z, y, z);
+    _Func->SetVehicleRotationEuler(m_ID, x, y, z);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1709,6 +1817,12 @@ float CVehicle::GetSpeedX() const
 {
     // Validate the managed identifier
     Validate();
+    // Is there a speed write that was not sent yet?
+    const VehicleInst & inst = Core::Get().GetVehicle(m_ID);
+    if (inst.mSnapshot.mPending & ESF_SPEED)
+    {
+        return inst.mSnapSpeed.x;
+    }
     // Clear previous information, if any
     float x = 0.0f, dummy;
     // Query the server for the requested component value
@@ -1722,6 +1836,12 @@ float CVehicle::GetSpeedY() const
 {
     // Validate the managed identifier
     Validate();
+    // Is there a speed write that was not sent yet?
+    const VehicleInst & inst = Core::Get().GetVehicle(m_ID);
+    if (inst.mSnapshot.mPending & ESF_SPEED)
+    {
+        return inst.mSnapSpeed.y;
+    }
     // Clear previous information, if any
     float y = 0.0f, dummy;
     // Query the server for the requested component value
@@ -1735,6 +1855,12 @@ float CVehicle::GetSpeedZ() const
 {
     // Validate the managed identifier
     Validate();
+    // Is there a speed write that was not sent yet?
+    const VehicleInst & inst = Core::Get().GetVehicle(m_ID);
+    if (inst.mSnapshot.mPending & ESF_SPEED)
+    {
+        return inst.mSnapSpeed.z;
+    }
     // Clear previous information, if any
     float z = 0.0f, dummy;
     // Query the server for the requested component value
@@ -1748,12 +1874,10 @@ void CVehicle::SetSpeedX(float x) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float y, z, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetVehicleSpeed(m_ID, &dummy, &y, &z, static_cast< uint8_t >(false));
+    // Retrieve the current values for unchanged components (pending values included)
+    const Vector3 vel = GetSpeed();
     // Perform the requested operation
-    _Func->SetVehicleSpeed(m_ID, x, y, z, static_cast< uint8_t >(false), static_cast< uint8_t >(false));
+    SetSpeedEx(x, vel.y, vel.z);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1761,12 +1885,10 @@ void CVehicle::SetSpeedY(float y) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float x, z, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetVehicleSpeed(m_ID, &x, &dummy, &z, static_cast< uint8_t >(false));
+    // Retrieve the current values for unchanged components (pending values included)
+    const Vector3 vel = GetSpeed();
     // Perform the requested operation
-    _Func->SetVehicleSpeed(m_ID, x, y, z, static_cast< uint8_t >(false), static_cast< uint8_t >(false));
+    SetSpeedEx(vel.x, y, vel.z);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1774,12 +1896,10 @@ void CVehicle::SetSpeedZ(float z) const
 {
     // Validate the managed identifier
     Validate();
-    // Reserve some temporary floats to retrieve the missing components
-    float x, y, dummy;
-    // Retrieve the current values for unchanged components
-    _Func->GetVehicleSpeed(m_ID, &x, &y, &dummy, static_cast< uint8_t >(false));
+    // Retrieve the current values for unchanged components (pending values included)
+    const Vector3 vel = GetSpeed();
     // Perform the requested operation
-    _Func->SetVehicleSpeed(m_ID, z, y, z, static_cast< uint8_t >(false), static_cast< uint8_t >(false));
+    SetSpeedEx(vel.x, vel.y, z);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1787,6 +1907,8 @@ float CVehicle::GetRelativeSpeedX() const
 {
     // Validate the managed identifier
     Validate();
+    // Pending speed writes must reach the server before this operation
+    InvalidateSnapshot(m_ID, ESF_SPEED);
     // Clear previous information, if any
     float x = 0.0f, dummy;
     // Query the server for the requested component value
@@ -1800,6 +1922,8 @@ float CVehicle::GetRelativeSpeedY() const
 {
     // Validate the managed identifier
     Validate();
+    // Pending speed writes must reach the server before this operation
+    InvalidateSnapshot(m_ID, ESF_SPEED);
     // Clear previous information, if any
     float y = 0.0f, dummy;
     // Query the server for the requested component value
@@ -1813,6 +1937,8 @@ float CVehicle::GetRelativeSpeedZ() const
 {
     // Validate the managed identifier
     Validate();
+    // Pending speed writes must reach the server before this operation
+    InvalidateSnapshot(m_ID, ESF_SPEED);
     // Clear previous information, if any
     float z = 0.0f, dummy;
     // Query the server for the requested component value
@@ -1826,6 +1952,8 @@ void CVehicle::SetRelativeSpeedX(float x) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending speed writes must reach the server before this operation
+    InvalidateSnapshot(m_ID, ESF_SPEED);
     // Reserve some temporary floats to retrieve the missing components
     float y, z, dummy;
     // Retrieve the current values for unchanged components
@@ -1839,6 +1967,8 @@ void CVehicle::SetRelativeSpeedY(float y) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending speed writes must reach the server before this operation
+    InvalidateSnapshot(m_ID, ESF_SPEED);
     // Reserve some temporary floats to retrieve the missing components
     float x, z, dummy;
     // Retrieve the current values for unchanged components
@@ -1852,6 +1982,8 @@ void CVehicle::SetRelativeSpeedZ(float z) const
 {
     // Validate the managed identifier
     Validate();
+    // Pending speed writes must reach the server before this operation
+    InvalidateSnapshot(m_ID, ESF_SPEED);
     // Reserve some temporary floats to retrieve the missing components
     float x, y, dummy;
     // Retrieve the current values for unchanged components
@@ -386,7 +386,7 @@ std::time_t Date::ToTimeT() const
 void Register_ChronoDate(HSQUIRRELVM vm, Table & /*cns*/)
 {
     RootTable(vm).Bind(Typename::Str,
-        Class< Date >(vm, Typename::Str)
+        Class< Date, PooledAllocator< Date > >(vm, Typename::Str)
         // Constructors
         .Ctor()
         .Ctor< uint16_t >()
@@ -775,7 +775,7 @@ std::time_t Datetime::ToTimeT() const
 void Register_ChronoDatetime(HSQUIRRELVM vm, Table & /*cns*/)
 {
     RootTable(vm).Bind(Typename::Str,
-        Class< Datetime >(vm, Typename::Str)
+        Class< Datetime, PooledAllocator< Datetime > >(vm, Typename::Str)
         // Constructors
         .Ctor()
         .Ctor< uint16_t >()
@@ -434,7 +434,7 @@ std::time_t Time::ToTimeT() const
 void Register_ChronoTime(HSQUIRRELVM vm, Table & /*cns*/)
 {
     RootTable(vm).Bind(Typename::Str,
-        Class< Time >(vm, Typename::Str)
+        Class< Time, PooledAllocator< Time > >(vm, Typename::Str)
         // Constructors
         .Ctor()
         .Ctor< uint8_t >()
@@ -250,7 +250,7 @@ static Timestamp SqGetYears(SQFloat amount)
 void Register_ChronoTimestamp(HSQUIRRELVM vm, Table & /*cns*/)
 {
     RootTable(vm).Bind(Typename::Str,
-        Class< Timestamp >(vm, Typename::Str)
+        Class< Timestamp, PooledAllocator< Timestamp > >(vm, Typename::Str)
         // Constructors
         .Ctor()
         .Ctor< const Timestamp & >()
@@ -2,6 +2,10 @@
 #include "Library/DPP/Cluster.hpp"
 #include "Library/DPP/Events.hpp"
 
+// ------------------------------------------------------------------------------------------------
+#include <tuple>
+#include <algorithm>
+
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
@@ -27,6 +31,15 @@ void Register_DPP_Cluster(HSQUIRRELVM vm, Table & ns)
         // Member Properties
         .Prop(_SC("On"), &DpCluster::GetEvents)
         .Prop(_SC("UpTime"), &DpCluster::UpTime)
+        .Prop(_SC("Pending"), &DpCluster::GetPending)
+        .Prop(_SC("PendingUrgent"), &DpCluster::GetPendingUrgent)
+        .Prop(_SC("PendingLazy"), &DpCluster::GetPendingLazy)
+        .Prop(_SC("MaxEvents"), &DpCluster::GetMaxEvents, &DpCluster::SetMaxEvents)
+        .Prop(_SC("MaxTime"), &DpCluster::GetMaxTime, &DpCluster::SetMaxTime)
+        .Prop(_SC("BacklogLimit"), &DpCluster::GetBacklogLimit, &DpCluster::SetBacklogLimit)
+        .Prop(_SC("Delivered"), &DpCluster::GetDelivered)
+        .Prop(_SC("Dropped"), &DpCluster::GetDropped)
+        .Prop(_SC("Coalesced"), &DpCluster::GetCoalesced)
         // Member Methods
         .Func(_SC("Start"), &DpCluster::Start)
         .Func(_SC("Log"), &DpCluster::Log)
@@ -35,6 +48,8 @@ void Register_DPP_Cluster(HSQUIRRELVM vm, Table & ns)
         .Func(_SC("SetPresence"), &DpCluster::SetPresence)
         .Func(_SC("EnableEvent"), &DpCluster::EnableEvent)
         .Func(_SC("DisableEvent"), &DpCluster::DisableEvent)
+        .Func(_SC("SetBudget"), &DpCluster::SetBudget)
+        .Func(_SC("ResetCounters"), &DpCluster::ResetCounters)
     );
 }
 
@@ -50,32 +65,119 @@ void DpCluster::Process(bool force)
     {
         return; // No point in going forward
     }
+    // Are we bound by a budget?
+    const bool limited = !force && (mMaxEvents != 0 || mMaxTime != 0);
+    // Point in time after which we stop delivering events
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(mMaxTime);
+    // Number of events delivered so far
+    uint32_t delivered = 0;
+    // See if the budget was exhausted
+    auto exhausted = [&]() -> bool {
+        return limited && ((mMaxEvents != 0 && delivered >= mMaxEvents) ||
+                            (mMaxTime != 0 && std::chrono::steady_clock::now() >= deadline));
+    };
     DpInternalEvent event;
-    // Retrieve each event individually and process it
-    for (size_t count = mQueue.size_approx(), n = 0; n <= count; ++n)
+    // Interactions must be acknowledged within a few seconds so they are never deferred
+    for (size_t count = mUrgent.size_approx(), n = 0; n <= count; ++n)
+    {
+        if (mUrgent.try_dequeue(event) && Dispatch(event))
+        {
+            ++delivered;
+        }
+    }
+    // Retrieve each regular event individually and process it while the budget allows it
+    for (size_t count = mQueue.size_approx(), n = 0; n <= count && !exhausted(); ++n)
+    {
+        if (mQueue.try_dequeue(event) && Dispatch(event))
+        {
+            ++delivered;
+        }
+    }
+    // Retrieve low priority events and discard the ones that became redundant
+    CollectLazy();
+    // Deliver low priority events with whatever budget is left
+    size_t n = 0;
+    for (; n < mBacklog.size() && !exhausted(); ++n)
+    {
+        if (Dispatch(mBacklog[n].mEvent))
+        {
+            ++delivered;
+        }
+    }
+    // Forget about the delivered events
+    mBacklog.erase(mBacklog.begin(), mBacklog.begin() + static_cast< ptrdiff_t >(n));
+    // Update the total number of delivered events
+    mDelivered += delivered;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DpCluster::Dispatch(DpInternalEvent & event)
+{
+    // Fetch the type of event
+    const auto type = event.GetType();
+    // Fetch the event itself
+    const auto data = event.GetData();
+    // Is this a valid event and is anyone listening to it?
+    if (event.mData == 0 || mEvents[type].first == nullptr || mEvents[type].first->IsEmpty())
+    {
+        event.Release();
+        return false; // Move on
+    }
+    // Transform the event instance into a script object
+    LightObj obj = EventToScriptObject(type, data);
+    // Allow the script to take ownership of the event instance now
+    event.Reset();
+    // Forward the call to the associated signal
+    (*mEvents[type].first)(obj);
+    // Allow the event instance to clean itself
+    EventInvokeCleanup(type, data);
+    // The event was delivered
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void DpCluster::CollectLazy()
+{
+    const size_t before = mBacklog.size();
+    // Move everything that arrived into the backlog
+    for (DpLazyEvent event; mLazy.try_dequeue(event);)
     {
-        // Try to get an event from the queue
-        if (mQueue.try_dequeue(event))
+        mBacklog.push_back(std::move(event));
+    }
+    // Did anything new arrive?
+    if (mBacklog.size() == before)
+    {
+        return; // Backlog was already coalesced
+    }
+    // Group the events by subject, oldest first within each group
+    mSubjects.clear();
+    for (size_t i = 0; i < mBacklog.size(); ++i)
+    {
+        const DpLazyEvent & e = mBacklog[i];
+        mSubjects.emplace_back(e.mEvent.GetType(), e.mSubject, e.mScope, i);
+    }
+    std::sort(mSubjects.begin(), mSubjects.end());
+    // Release every event that is followed by a newer one about the same subject
+    for (size_t i = 1; i < mSubjects.size(); ++i)
+    {
+        const auto & prev = mSubjects[i - 1], & next = mSubjects[i];
+        if (std::get< 0 >(prev) == std::get< 0 >(next) && std::get< 1 >(prev) == std::get< 1 >(next) &&
+            std::get< 2 >(prev) == std::get< 2 >(next))
         {
-            // Fetch the type of event
-            const auto type = event.GetType();
-            // Fetch the event itself
-            const auto data = event.GetData();
-            // Is this a valid event and is anyone listening to it?
-            if (event.mData == 0 || mEvents[type].first == nullptr || mEvents[type].first->IsEmpty())
-            {
-                continue; // Move on
-            }
-            // Transform the event instance into a script object
-            LightObj obj = EventToScriptObject(type, data);
-            // Allow the script to take ownership of the event instance now
-            event.Reset();
-            // Forward the call to the associated signal
-            (*mEvents[type].first)(obj);
-            // Allow the event instance to clean itself
-            EventInvokeCleanup(type, data);
+            mBacklog[std::get< 3 >(prev)].mEvent.Release();
+            ++mCoalesced;
         }
     }
+    // Remove released events while preserving the order of the remaining ones
+    mBacklog.erase(std::remove_if(mBacklog.begin(), mBacklog.end(),
+                                  [](const DpLazyEvent & e) { return e.mEvent.mData == 0; }), mBacklog.end());
+    // Drop the oldest events if the backlog grew too large
+    if (mBacklogLimit != 0 && mBacklog.size() > mBacklogLimit)
+    {
+        const size_t excess = mBacklog.size() - mBacklogLimit;
+        mBacklog.erase(mBacklog.begin(), mBacklog.begin() + static_cast< ptrdiff_t >(excess));
+        mDropped += excess;
+    }
 }
 
 /* ================================================================================================
@@ -98,17 +200,17 @@ void DpCluster::OnGuildJoinRequestDelete(const dpp::guild_join_request_delete_t
 // ------------------------------------------------------------------------------------------------
 void DpCluster::OnInteractionCreate(const dpp::interaction_create_t & ev)
 {
-    mQueue.enqueue(DpInternalEvent(DpEventID::InteractionCreate, new DpInteractionCreateEvent(ev)));
+    mUrgent.enqueue(DpInternalEvent(DpEventID::InteractionCreate, new DpInteractionCreateEvent(ev)));
 }
 // ------------------------------------------------------------------------------------------------
 void DpCluster::OnButtonClick(const dpp::button_click_t & ev)
 {
-    mQueue.enqueue(DpInternalEvent(DpEventID::ButtonClick, new DpButtonClickEvent(ev)));
+    mUrgent.enqueue(DpInternalEvent(DpEventID::ButtonClick, new DpButtonClickEvent(ev)));
 }
 // ------------------------------------------------------------------------------------------------
 void DpCluster::OnSelectClick(const dpp::select_click_t & ev)
 {
-    mQueue.enqueue(DpInternalEvent(DpEventID::SelectClick, new DpSelectClickEvent(ev)));
+    mUrgent.enqueue(DpInternalEvent(DpEventID::SelectClick, new DpSelectClickEvent(ev)));
 }
 // ------------------------------------------------------------------------------------------------
 void DpCluster::OnGuildDelete(const dpp::guild_delete_t & ev)
@@ -163,7 +265,9 @@ void DpCluster::OnGuildRoleCreate(const dpp::guild_role_create_t & ev)
 // ------------------------------------------------------------------------------------------------
 void DpCluster::OnTypingStart(const dpp::typing_start_t & ev)
 {
-    mQueue.enqueue(DpInternalEvent(DpEventID::TypingStart, new DpTypingStartEvent(ev)));
+    const uint64_t user = ev.typing_user != nullptr ? static_cast< uint64_t >(ev.typing_user->id) : 0;
+    const uint64_t channel = ev.typing_channel != nullptr ? static_cast< uint64_t >(ev.typing_channel->id) : 0;
+    mLazy.enqueue(DpLazyEvent(user, channel, DpInternalEvent(DpEventID::TypingStart, new DpTypingStartEvent(ev))));
 }
 // ------------------------------------------------------------------------------------------------
 void DpCluster::OnMessageReactionAdd(const dpp::message_reaction_add_t & ev)
@@ -238,7 +342,9 @@ void DpCluster::OnGuildStickersUpdate(const dpp::guild_stickers_update_t & ev)
 // ------------------------------------------------------------------------------------------------
 void DpCluster::OnPresenceUpdate(const dpp::presence_update_t & ev)
 {
-    mQueue.enqueue(DpInternalEvent(DpEventID::PresenceUpdate, new DpPresenceUpdateEvent(ev)));
+    const auto & p = ev.rich_presence;
+    mLazy.enqueue(DpLazyEvent(static_cast< uint64_t >(p.user_id), static_cast< uint64_t >(p.guild_id),
+                              DpInternalEvent(DpEventID::PresenceUpdate, new DpPresenceUpdateEvent(ev))));
 }
 // ------------------------------------------------------------------------------------------------
 void DpCluster::OnWebhooksUpdate(const dpp::webhooks_update_t & ev)
@@ -10,7 +10,9 @@
 
 // ------------------------------------------------------------------------------------------------
 #include <chrono>
+#include <tuple>
 #include <memory>
+#include <vector>
 #include <functional>
 
 // ------------------------------------------------------------------------------------------------
@@ -117,6 +119,61 @@ struct DpInternalEvent
     void Release();
 };
 
+/* ------------------------------------------------------------------------------------------------
+ * Low priority event together with the subject it refers to. Newer events about the same subject
+ * replace older ones that were not yet delivered.
+*/
+struct DpLazyEvent
+{
+    /* --------------------------------------------------------------------------------------------
+     * Primary subject of the event (usually the user).
+    */
+    uint64_t mSubject{0llu};
+
+    /* --------------------------------------------------------------------------------------------
+     * Scope of the event (usually the guild or channel).
+    */
+    uint64_t mScope{0llu};
+
+    /* --------------------------------------------------------------------------------------------
+     * Managed event.
+    */
+    DpInternalEvent mEvent{};
+
+    /* --------------------------------------------------------------------------------------------
+     * Default constructor.
+    */
+    DpLazyEvent() noexcept = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Explicit constructor.
+    */
+    DpLazyEvent(uint64_t subject, uint64_t scope, DpInternalEvent && event) noexcept
+        : mSubject(subject), mScope(scope), mEvent(std::move(event))
+    {
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy constructor (disabled).
+    */
+    DpLazyEvent(const DpLazyEvent & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move constructor.
+    */
+    DpLazyEvent(DpLazyEvent && o) noexcept = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy assignment operator (disabled).
+    */
+    DpLazyEvent & operator = (const DpLazyEvent & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move assignment operator.
+    */
+    DpLazyEvent & operator = (DpLazyEvent && o) noexcept = default;
+};
+
 /* ------------------------------------------------------------------------------------------------
  * The cluster class represents a group of shards and a command queue for sending and receiving
  * commands from discord via HTTP.
@@ -128,6 +185,11 @@ struct DpCluster : public SqChainedInstances< DpCluster >
     */
     using EventQueue = moodycamel::ConcurrentQueue< DpInternalEvent >;
 
+    /* --------------------------------------------------------------------------------------------
+     * Queue of low priority events generated from other threads.
+    */
+    using LazyQueue = moodycamel::ConcurrentQueue< DpLazyEvent >;
+
     /* --------------------------------------------------------------------------------------------
      * Managed cluster instance.
     */
@@ -138,6 +200,55 @@ struct DpCluster : public SqChainedInstances< DpCluster >
     */
     EventQueue mQueue{4096};
 
+    /* --------------------------------------------------------------------------------------------
+     * Queue of events that must be delivered as soon as possible (interactions).
+    */
+    EventQueue mUrgent{1024};
+
+    /* --------------------------------------------------------------------------------------------
+     * Queue of low priority events that can be coalesced (presence updates, typing).
+    */
+    LazyQueue mLazy{1024};
+
+    /* --------------------------------------------------------------------------------------------
+     * Low priority events that were retrieved but not yet delivered.
+    */
+    std::vector< DpLazyEvent > mBacklog{};
+
+    /* --------------------------------------------------------------------------------------------
+     * Subject of each backlog event and its position, sorted when coalescing. Kept to reuse memory.
+    */
+    std::vector< std::tuple< uint8_t, uint64_t, uint64_t, size_t > > mSubjects{};
+
+    /* --------------------------------------------------------------------------------------------
+     * Maximum number of events delivered by a single call to Process(). Zero means no limit.
+    */
+    uint32_t mMaxEvents{0};
+
+    /* --------------------------------------------------------------------------------------------
+     * Maximum number of microseconds spent by a single call to Process(). Zero means no limit.
+    */
+    uint32_t mMaxTime{0};
+
+    /* --------------------------------------------------------------------------------------------
+     * Maximum number of low priority events kept in the backlog. Zero means no limit.
+    */
+    uint32_t mBacklogLimit{4096};
+
+    /* --------------------------------------------------------------------------------------------
+     * Number of events delivered to the script.
+    */
+    uint64_t mDelivered{0};
+
+    /* --------------------------------------------------------------------------------------------
+     * Number of low priority events dropped because the backlog was full.
+    */
+    uint64_t mDropped{0};
+
+    /* --------------------------------------------------------------------------------------------
+     * Number of low priority events replaced by a newer event about the same subject.
+    */
+    uint64_t mCoalesced{0};
     /* --------------------------------------------------------------------------------------------
      * Explicit constructor.
     */
@@ -289,10 +400,125 @@ struct DpCluster : public SqChainedInstances< DpCluster >
     std::array< SignalPair, static_cast< size_t >(DpEventID::Max) > mEvents{};
 
     /* --------------------------------------------------------------------------------------------
-     * Process the cluster.
+     * Process the cluster. When forced, the configured budget is ignored.
     */
     void Process(bool force = false);
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of events waiting to be delivered.
+    */
+    SQMOD_NODISCARD SQInteger GetPending() const
+    {
+        return static_cast< SQInteger >(mUrgent.size_approx() + mQueue.size_approx() + mLazy.size_approx() + mBacklog.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of urgent events waiting to be delivered.
+    */
+    SQMOD_NODISCARD SQInteger GetPendingUrgent() const
+    {
+        return static_cast< SQInteger >(mUrgent.size_approx());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of low priority events waiting to be delivered.
+    */
+    SQMOD_NODISCARD SQInteger GetPendingLazy() const
+    {
+        return static_cast< SQInteger >(mLazy.size_approx() + mBacklog.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the maximum number of events delivered by a single call to Process().
+    */
+    SQMOD_NODISCARD SQInteger GetMaxEvents() const
+    {
+        return static_cast< SQInteger >(mMaxEvents);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the maximum number of events delivered by a single call to Process().
+    */
+    void SetMaxEvents(SQInteger n)
+    {
+        mMaxEvents = static_cast< uint32_t >(ClampMin(n, SQInteger(0)));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the maximum number of microseconds spent by a single call to Process().
+    */
+    SQMOD_NODISCARD SQInteger GetMaxTime() const
+    {
+        return static_cast< SQInteger >(mMaxTime);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the maximum number of microseconds spent by a single call to Process().
+    */
+    void SetMaxTime(SQInteger n)
+    {
+        mMaxTime = static_cast< uint32_t >(ClampMin(n, SQInteger(0)));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the maximum number of low priority events kept in the backlog.
+    */
+    SQMOD_NODISCARD SQInteger GetBacklogLimit() const
+    {
+        return static_cast< SQInteger >(mBacklogLimit);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the maximum number of low priority events kept in the backlog.
+    */
+    void SetBacklogLimit(SQInteger n)
+    {
+        mBacklogLimit = static_cast< uint32_t >(ClampMin(n, SQInteger(0)));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the event and time budget of a single call to Process().
+    */
+    DpCluster & SetBudget(SQInteger events, SQInteger time)
+    {
+        SetMaxEvents(events);
+        SetMaxTime(time);
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of events delivered to the script.
+    */
+    SQMOD_NODISCARD SQInteger GetDelivered() const
+    {
+        return static_cast< SQInteger >(mDelivered);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of low priority events dropped because the backlog was full.
+    */
+    SQMOD_NODISCARD SQInteger GetDropped() const
+    {
+        return static_cast< SQInteger >(mDropped);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of low priority events replaced by a newer one.
+    */
+    SQMOD_NODISCARD SQInteger GetCoalesced() const
+    {
+        return static_cast< SQInteger >(mCoalesced);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Reset the event counters.
+    */
+    DpCluster & ResetCounters()
+    {
+        mDelivered = mDropped = mCoalesced = 0;
+        return *this;
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Terminate the cluster.
     */
@@ -300,6 +526,21 @@ struct DpCluster : public SqChainedInstances< DpCluster >
     {
         // Delete the cluster instance
         mC.reset();
+        // Release the events that were not delivered
+        for (DpInternalEvent event; mQueue.try_dequeue(event);)
+        {
+            event.Release();
+        }
+        for (DpInternalEvent event; mUrgent.try_dequeue(event);)
+        {
+            event.Release();
+        }
+        for (DpLazyEvent event; mLazy.try_dequeue(event);)
+        {
+            event.mEvent.Release();
+        }
+        mBacklog.clear();
+        mSubjects.clear();
         // Release associated script objects
         mSqEvents.Release();
         // Release event signal objects
@@ -318,6 +559,16 @@ struct DpCluster : public SqChainedInstances< DpCluster >
 
 private:
 
+    /* --------------------------------------------------------------------------------------------
+     * Deliver an event to the associated signal. Returns true if anyone was listening.
+    */
+    bool Dispatch(DpInternalEvent & event);
+
+    /* --------------------------------------------------------------------------------------------
+     * Move pending low priority events into the backlog and discard the redundant ones.
+    */
+    void CollectLazy();
+
     /* --------------------------------------------------------------------------------------------
      * Initialize the cluster.
     */
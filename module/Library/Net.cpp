@@ -4,6 +4,9 @@
 // ------------------------------------------------------------------------------------------------
 #include <sqratConst.h>
 
+// ------------------------------------------------------------------------------------------------
+#include <cstring>
+
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
@@ -117,13 +120,172 @@ WebSocketClient & WebSocketClient::ConnectExt()
     return *this;
 }
 
+// ------------------------------------------------------------------------------------------------
+void WebSocketClient::Process(bool force)
+{
+    // Is there a valid connection?
+    if (mHandle == nullptr && !force)
+    {
+        return; // No point in going forward
+    }
+    FramePtr frame;
+    // See if connection is closing
+    const bool closing = mClosing.load();
+    // Is the connection closing?
+    if (closing)
+    {
+        mHandle = nullptr; // Prevent further use
+        force = true; // Everything must be delivered before the close callback
+    }
+    // Amount of bytes delivered so far
+    uint32_t delivered = 0;
+    // Retrieve each frame individually and process it
+    for (size_t count = mQueue.size_approx(), n = 0; n <= count; ++n)
+    {
+        // Was the budget exhausted? Remaining frames are delivered on the next call
+        if (!force && mBudget != 0 && delivered >= mBudget)
+        {
+            break;
+        }
+        // Try to get a frame from the queue
+        else if (!mQueue.try_dequeue(frame))
+        {
+            break; // Nothing left to process
+        }
+        // Is there someone listening for data?
+        if (!mOnData.IsNull())
+        {
+            // Backup the frame size before the memory changes hands
+            const uint32_t size = frame->Size();
+            // Count towards the budget
+            delivered += size;
+            // Should the memory be delivered through the reused buffer?
+            if (mRecycle)
+            {
+                // Create the reused buffer if necessary
+                if (mView.IsNull())
+                {
+                    mView = LightObj(SqTypeIdentity< SqBuffer >{}, SqVM());
+                }
+                // Obtain the buffer instance from the script object
+                Buffer & b = *(mView.CastI< SqBuffer >()->GetRef());
+                // Exchange memory with the frame. The previous memory goes back to the pool
+                b.Swap(frame->mData);
+                // Only expose the received data and place the cursor at the end of it
+                b.Limit(size);
+                b.Move(size);
+                // Forward the event to the callback
+                mOnData.Execute(mView, static_cast< SQInteger >(size), frame->mFlags);
+            }
+            else
+            {
+                // Give the script an exact copy of the data. The frame memory goes back to the pool
+                Buffer b(size != 0 ? new Buffer::Value[size] : nullptr, size, size, Buffer::OwnIt{});
+                if (size != 0)
+                {
+                    std::memcpy(b.Data(), frame->mData.Data(), size);
+                }
+                // Transform the buffer into a script object
+                LightObj obj(SqTypeIdentity< SqBuffer >{}, SqVM(), std::move(b));
+                // Forward the event to the callback
+                mOnData.Execute(obj, static_cast< SQInteger >(size), frame->mFlags);
+            }
+        }
+        // Allow the frame to be reused
+        RecycleFrame(std::move(frame));
+    }
+    // Is the server closing the connection?
+    if (closing && !mOnClose.IsNull())
+    {
+        mOnClose.Execute(); // Let the user know
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+WebSocketClient::FramePtr WebSocketClient::AcquireFrame(int flags)
+{
+    FramePtr frame;
+    // Is there a frame we can reuse?
+    if (mPool.try_dequeue(frame))
+    {
+        frame->Clear(flags);
+    }
+    else
+    {
+        frame = std::make_unique< Frame >();
+        frame->mFlags = flags;
+    }
+    return frame;
+}
+
+// ------------------------------------------------------------------------------------------------
+void WebSocketClient::RecycleFrame(FramePtr && frame)
+{
+    // Only keep as many frames as the pool was meant to hold. Let the rest be released
+    // Frames that received a large message are released too, so the pool doesn't pin that memory
+    if (mPool.size_approx() < FRAME_POOL_SIZE && frame->mData.Capacity() <= FRAME_POOL_MAX_CAPACITY)
+    {
+        mPool.enqueue(std::move(frame));
+    }
+    frame.reset();
+}
+
 // ------------------------------------------------------------------------------------------------
 int WebSocketClient::DataHandler(int flags, char * data, size_t data_len) noexcept
 {
     // Create a frame instance to store information and queue it
     try
     {
-        mQueue.enqueue(std::make_unique< Frame >(data, data_len, flags));
+        const int opcode = (flags & 0xF);
+        const bool reassemble = mReassemble.load();
+        // Was reassembly toggled? A message that was being joined can't be completed anymore
+        if (reassemble != mReassembling)
+        {
+            mReassembling = reassemble;
+            mPartial.reset();
+        }
+        // Are we supposed to join fragmented messages? Control frames can be interleaved
+        if (!reassemble || (opcode & 0x8))
+        {
+            FramePtr frame = AcquireFrame(flags);
+            frame->Append(data, data_len);
+            mQueue.enqueue(std::move(frame));
+        }
+        // Is this the continuation of a fragmented message?
+        else if (opcode == MG_WEBSOCKET_OPCODE_CONTINUATION && mPartial)
+        {
+            // Would the message grow too large?
+            if ((static_cast< uint64_t >(mPartial->Size()) + data_len) > mReassembleLimit.load())
+            {
+                LogWrn("Closing web-socket connection after a message exceeded the reassembly limit (%u)",
+                        mReassembleLimit.load());
+                mPartial.reset();
+                // Return 0 to close the connection
+                return 0;
+            }
+            mPartial->Append(data, data_len);
+            // Was this the final fragment?
+            if (flags & 0x80)
+            {
+                // Report the opcode of the first fragment and mark the message as final
+                mPartial->mFlags |= 0x80;
+                mQueue.enqueue(std::move(mPartial));
+            }
+        }
+        else
+        {
+            FramePtr frame = AcquireFrame(flags);
+            frame->Append(data, data_len);
+            // Is this a complete message or the beginning of a fragmented one?
+            if ((flags & 0x80) || opcode == MG_WEBSOCKET_OPCODE_CONTINUATION)
+            {
+                mQueue.enqueue(std::move(frame));
+            }
+            else
+            {
+                mPartial = std::move(frame);
+            }
+        }
     }
     catch(...)
     {
@@ -163,10 +325,15 @@ void Register_Net(HSQUIRRELVM vm)
         .Prop(_SC("Secure"), &WebSocketClient::GetSecure, &WebSocketClient::SetSecure)
         .Prop(_SC("Origin"), &WebSocketClient::GetOrigin, &WebSocketClient::SetOrigin)
         .Prop(_SC("Extensions"), &WebSocketClient::GetExtensions, &WebSocketClient::SetExtensions)
+        .Prop(_SC("Reassemble"), &WebSocketClient::GetReassemble, &WebSocketClient::SetReassemble)
+        .Prop(_SC("ReassembleLimit"), &WebSocketClient::GetReassembleLimit, &WebSocketClient::SetReassembleLimit)
+        .Prop(_SC("Recycle"), &WebSocketClient::GetRecycle, &WebSocketClient::SetRecycle)
+        .Prop(_SC("Budget"), &WebSocketClient::GetBudget, &WebSocketClient::SetBudget)
         .Prop(_SC("OnData"), &WebSocketClient::GetOnData, &WebSocketClient::SetOnData)
         .Prop(_SC("OnClose"), &WebSocketClient::GetOnClose, &WebSocketClient::SetOnClose)
         .Prop(_SC("Valid"), &WebSocketClient::IsValid)
         .Prop(_SC("Closing"), &WebSocketClient::IsClosing)
+        .Prop(_SC("Pending"), &WebSocketClient::GetPending)
         // Member Methods
         .FmtFunc(_SC("SetTag"), &WebSocketClient::ApplyTag)
         .FmtFunc(_SC("SetData"), &WebSocketClient::ApplyData)
@@ -176,6 +343,10 @@ void Register_Net(HSQUIRRELVM vm)
         .Func(_SC("SetSecure"), &WebSocketClient::ApplySecure)
         .FmtFunc(_SC("SetOrigin"), &WebSocketClient::ApplyOrigin)
         .FmtFunc(_SC("SetExtensions"), &WebSocketClient::ApplyExtensions)
+        .Func(_SC("SetReassemble"), &WebSocketClient::ApplyReassemble)
+        .Func(_SC("SetReassembleLimit"), &WebSocketClient::ApplyReassembleLimit)
+        .Func(_SC("SetRecycle"), &WebSocketClient::ApplyRecycle)
+        .Func(_SC("SetBudget"), &WebSocketClient::ApplyBudget)
         .CbFunc(_SC("BindOnData"), &WebSocketClient::BindOnData)
         .CbFunc(_SC("BindOnClose"), &WebSocketClient::BindOnClose)
         .Func(_SC("Connect"), &WebSocketClient::Connect)
@@ -26,14 +26,9 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
     struct Frame
     {
         /* ----------------------------------------------------------------------------------------
-         * Frame data.
+         * Frame data. The edit cursor marks the amount of valid data.
         */
-        char * mData{nullptr};
-
-        /* ----------------------------------------------------------------------------------------
-         * Frame data capacity.
-        */
-        uint32_t mSize{0};
+        Buffer mData{};
 
         /* ----------------------------------------------------------------------------------------
          * Frame flags.
@@ -48,17 +43,10 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
         /* ----------------------------------------------------------------------------------------
          * Explicit constructor.
         */
-        Frame(char * data, size_t size, int flags)
-            : mData(nullptr), mSize(static_cast< uint32_t >(size)), mFlags(flags)
+        Frame(const char * data, size_t size, int flags)
+            : mData(), mFlags(flags)
         {
-            // Do we need to allocate a buffer?
-            if (mSize != 0)
-            {
-                // Allocate the memory buffer.
-                mData = new char[mSize];
-                // Copy the data into the buffer we own
-                std::memcpy(mData, data, mSize);
-            }
+            Append(data, size);
         }
 
         /* ----------------------------------------------------------------------------------------
@@ -74,10 +62,7 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
         /* ----------------------------------------------------------------------------------------
          * Destructor.
         */
-        ~Frame()
-        {
-            delete[] mData;
-        }
+        ~Frame() = default;
 
         /* ----------------------------------------------------------------------------------------
          * Copy assignment operator (disabled).
@@ -90,12 +75,28 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
         Frame & operator = (Frame && o) noexcept = delete;
 
         /* ----------------------------------------------------------------------------------------
-         * Forget about the associated memory buffer.
+         * Retrieve the amount of valid data in the frame.
         */
-        void ForgetBuffer() noexcept
+        SQMOD_NODISCARD uint32_t Size() const noexcept
         {
-            mData = nullptr;
-            mSize = 0;
+            return mData.Position();
+        }
+
+        /* ----------------------------------------------------------------------------------------
+         * Discard the frame contents but keep the allocated memory for reuse.
+        */
+        void Clear(int flags) noexcept
+        {
+            mData.Move(0);
+            mFlags = flags;
+        }
+
+        /* ----------------------------------------------------------------------------------------
+         * Append data at the end of the frame.
+        */
+        void Append(const char * data, size_t size)
+        {
+            mData.Append(data, static_cast< Buffer::SzType >(size));
         }
     };
 
@@ -109,6 +110,16 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
     */
     using FrameQueue = moodycamel::ConcurrentQueue< FramePtr >;
 
+    /* --------------------------------------------------------------------------------------------
+     * Number of processed frames kept around for reuse.
+    */
+    static constexpr size_t FRAME_POOL_SIZE = 256;
+
+    /* --------------------------------------------------------------------------------------------
+     * Frames whose memory grew beyond this many bytes are released instead of pooled.
+    */
+    static constexpr uint32_t FRAME_POOL_MAX_CAPACITY = 65536;
+
     /* --------------------------------------------------------------------------------------------
      * Connection handle.
     */
@@ -119,6 +130,16 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
     */
     FrameQueue mQueue{1024};
 
+    /* --------------------------------------------------------------------------------------------
+     * Queue of processed frames that can be reused to receive data without allocating.
+    */
+    FrameQueue mPool{FRAME_POOL_SIZE};
+
+    /* --------------------------------------------------------------------------------------------
+     * Fragmented message being reassembled. Only accessed from the connection thread.
+    */
+    FramePtr mPartial{};
+
     /* --------------------------------------------------------------------------------------------
      * Callback to invoke when receiving data.
     */
@@ -139,6 +160,11 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
     */
     LightObj mData{};
 
+    /* --------------------------------------------------------------------------------------------
+     * Buffer instance reused to deliver frames to the data callback when recycling is enabled.
+    */
+    LightObj mView{};
+
     /* --------------------------------------------------------------------------------------------
      * Server port.
     */
@@ -154,6 +180,31 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
     */
     std::atomic< bool > mClosing{false};
 
+    /* --------------------------------------------------------------------------------------------
+     * Whether fragmented messages are joined into a single frame before being delivered.
+    */
+    std::atomic< bool > mReassemble{false};
+
+    /* --------------------------------------------------------------------------------------------
+     * Maximum size of a reassembled message. The connection is closed if a message grows beyond it.
+    */
+    std::atomic< uint32_t > mReassembleLimit{16777216};
+
+    /* --------------------------------------------------------------------------------------------
+     * Whether reassembly was enabled when the last frame was received. Only accessed from the connection thread.
+    */
+    bool mReassembling{false};
+
+    /* --------------------------------------------------------------------------------------------
+     * Whether frames are delivered through a reused buffer instead of a new one each time.
+    */
+    bool mRecycle{false};
+
+    /* --------------------------------------------------------------------------------------------
+     * Maximum amount of bytes to deliver on each call to Process(). Zero means unlimited.
+    */
+    uint32_t mBudget{0};
+
     /* --------------------------------------------------------------------------------------------
      * Server host to connect to, i.e. "echo.websocket.org" or "192.168.1.1" or "localhost".
     */
@@ -178,8 +229,9 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
      * Default constructor.
     */
     WebSocketClient()
-        : Base(), mHandle(nullptr), mQueue(1024), mOnData(), mOnClose(), mTag(), mData()
-        , mPort(0), mSecure(false), mClosing(false), mHost(), mPath(), mOrigin(), mExtensions()
+        : Base(), mHandle(nullptr), mQueue(1024), mPool(FRAME_POOL_SIZE), mPartial(), mOnData(), mOnClose(), mTag(), mData(), mView()
+        , mPort(0), mSecure(false), mClosing(false), mReassemble(false), mReassembleLimit(16777216), mReassembling(false), mRecycle(false), mBudget(0)
+        , mHost(), mPath(), mOrigin(), mExtensions()
     {
         ChainInstance(); // Remember this instance
     }
@@ -188,8 +240,8 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
      * Explicit constructor.
     */
     WebSocketClient(StackStrF & host, uint16_t port, StackStrF & path)
-        : Base(), mHandle(nullptr), mQueue(1024), mOnData(), mOnClose(), mTag(), mData()
-        , mPort(port), mSecure(false), mClosing(false)
+        : Base(), mHandle(nullptr), mQueue(1024), mPool(FRAME_POOL_SIZE), mPartial(), mOnData(), mOnClose(), mTag(), mData(), mView()
+        , mPort(port), mSecure(false), mClosing(false), mReassemble(false), mReassembleLimit(16777216), mReassembling(false), mRecycle(false), mBudget(0)
         , mHost(host.mPtr, host.GetSize())
         , mPath(path.mPtr, path.GetSize())
         , mOrigin(), mExtensions()
@@ -201,8 +253,8 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
      * Explicit constructor.
     */
     WebSocketClient(StackStrF & host, uint16_t port, StackStrF & path, bool secure)
-        : Base(), mHandle(nullptr), mQueue(1024), mOnData(), mOnClose(), mTag(), mData()
-        , mPort(port), mSecure(secure), mClosing(false)
+        : Base(), mHandle(nullptr), mQueue(1024), mPool(FRAME_POOL_SIZE), mPartial(), mOnData(), mOnClose(), mTag(), mData(), mView()
+        , mPort(port), mSecure(secure), mClosing(false), mReassemble(false), mReassembleLimit(16777216), mReassembling(false), mRecycle(false), mBudget(0)
         , mHost(host.mPtr, host.GetSize())
         , mPath(path.mPtr, path.GetSize())
         , mOrigin(), mExtensions()
@@ -214,8 +266,8 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
      * Explicit constructor.
     */
     WebSocketClient(StackStrF & host, uint16_t port, StackStrF & path, bool secure, StackStrF & origin)
-        : Base(), mHandle(nullptr), mQueue(1024), mOnData(), mOnClose(), mTag(), mData()
-        , mPort(port), mSecure(secure), mClosing(false)
+        : Base(), mHandle(nullptr), mQueue(1024), mPool(FRAME_POOL_SIZE), mPartial(), mOnData(), mOnClose(), mTag(), mData(), mView()
+        , mPort(port), mSecure(secure), mClosing(false), mReassemble(false), mReassembleLimit(16777216), mReassembling(false), mRecycle(false), mBudget(0)
         , mHost(host.mPtr, host.GetSize())
         , mPath(path.mPtr, path.GetSize())
         , mOrigin(origin.mPtr, origin.GetSize())
@@ -228,8 +280,8 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
      * Explicit constructor.
     */
     WebSocketClient(StackStrF & host, uint16_t port, StackStrF & path, bool secure, StackStrF & origin, StackStrF & ext)
-        : Base(), mHandle(nullptr), mQueue(1024), mOnData(), mOnClose(), mTag(), mData()
-        , mPort(port), mSecure(secure), mClosing(false)
+        : Base(), mHandle(nullptr), mQueue(1024), mPool(FRAME_POOL_SIZE), mPartial(), mOnData(), mOnClose(), mTag(), mData(), mView()
+        , mPort(port), mSecure(secure), mClosing(false), mReassemble(false), mReassembleLimit(16777216), mReassembling(false), mRecycle(false), mBudget(0)
         , mHost(host.mPtr, host.GetSize())
         , mPath(path.mPtr, path.GetSize())
         , mOrigin(origin.mPtr, origin.GetSize())
@@ -573,6 +625,124 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
         return *this;
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve whether fragmented messages are reassembled before being delivered.
+    */
+    SQMOD_NODISCARD bool GetReassemble() const
+    {
+        return mReassemble.load();
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify whether fragmented messages are reassembled before being delivered.
+    */
+    void SetReassemble(bool toggle)
+    {
+        mReassemble.store(toggle);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify whether fragmented messages are reassembled before being delivered.
+    */
+    WebSocketClient & ApplyReassemble(bool toggle)
+    {
+        SetReassemble(toggle);
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the maximum size of a reassembled message.
+    */
+    SQMOD_NODISCARD SQInteger GetReassembleLimit() const
+    {
+        return static_cast< SQInteger >(mReassembleLimit.load());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the maximum size of a reassembled message.
+    */
+    void SetReassembleLimit(SQInteger limit)
+    {
+        if (limit < 1 || limit > Buffer::Max())
+        {
+            STHROWF("Invalid reassembly limit ({})", limit);
+        }
+        mReassembleLimit.store(static_cast< uint32_t >(limit));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the maximum size of a reassembled message.
+    */
+    WebSocketClient & ApplyReassembleLimit(SQInteger limit)
+    {
+        SetReassembleLimit(limit);
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve whether frames are delivered through a reused buffer.
+    */
+    SQMOD_NODISCARD bool GetRecycle() const
+    {
+        return mRecycle;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify whether frames are delivered through a reused buffer.
+     * When enabled, the buffer given to the data callback is only valid until the callback returns.
+    */
+    void SetRecycle(bool toggle)
+    {
+        mRecycle = toggle;
+        // Drop the reused buffer if no longer needed
+        if (!toggle)
+        {
+            mView.Release();
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify whether frames are delivered through a reused buffer.
+    */
+    WebSocketClient & ApplyRecycle(bool toggle)
+    {
+        SetRecycle(toggle);
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the amount of bytes delivered on each call to Process().
+    */
+    SQMOD_NODISCARD SQInteger GetBudget() const
+    {
+        return static_cast< SQInteger >(mBudget);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the amount of bytes delivered on each call to Process().
+    */
+    void SetBudget(SQInteger budget)
+    {
+        mBudget = ConvTo< uint32_t >::From(budget < 0 ? 0 : budget);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the amount of bytes delivered on each call to Process().
+    */
+    WebSocketClient & ApplyBudget(SQInteger budget)
+    {
+        SetBudget(budget);
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the approximate number of frames waiting to be delivered.
+    */
+    SQMOD_NODISCARD SQInteger GetPending() const
+    {
+        return static_cast< SQInteger >(mQueue.size_approx());
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Retrieve the associated data callback.
     */
@@ -670,47 +840,9 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
     }
 
     /* --------------------------------------------------------------------------------------------
-     * Process received data.
+     * Process received data. Unless forced, stops once the byte budget was reached (if any).
     */
-    void Process(bool force = false)
-    {
-        // Is there a valid connection?
-        if (mHandle == nullptr && !force)
-        {
-            return; // No point in going forward
-        }
-        FramePtr frame;
-        // See if connection is closing
-        const bool closing = mClosing.load();
-        // Is the connection closing?
-        if (closing)
-        {
-            mHandle = nullptr; // Prevent further use
-        }
-        // Retrieve each frame individually and process it
-        for (size_t count = mQueue.size_approx(), n = 0; n <= count; ++n)
-        {
-            // Try to get a frame from the queue
-            if (mQueue.try_dequeue(frame) && !mOnData.IsNull())
-            {
-                // Obtain a buffer from the frame
-                Buffer b(frame->mData, frame->mSize, frame->mSize, Buffer::OwnIt{});
-                // Backup the frame size before forgetting about it
-                const SQInteger size = static_cast< SQInteger >(frame->mSize);
-                // Take ownership of the memory
-                frame->ForgetBuffer();
-                // Transform the buffer into a script object
-                LightObj obj(SqTypeIdentity< SqBuffer >{}, SqVM(), std::move(b));
-                // Forward the event to the callback
-                mOnData.Execute(obj, size, frame->mFlags);
-            }
-        }
-        // Is the server closing the connection?
-        if (closing && !mOnClose.IsNull())
-        {
-            mOnClose.Execute(); // Let the user know
-        }
-    }
+    void Process(bool force = false);
 
     /* --------------------------------------------------------------------------------------------
      * Used internally to release script resources, if any. The VM is about to be closed.
@@ -725,6 +857,8 @@ struct WebSocketClient : public SqChainedInstances< WebSocketClient >
         mOnClose.Release();
         // Release user data
         mData.Release();
+        // Release the reused buffer
+        mView.Release();
     }
 
 protected:
@@ -739,6 +873,16 @@ protected:
     */
     void CloseHandler() noexcept;
 
+    /* --------------------------------------------------------------------------------------------
+     * Obtain a frame from the pool or allocate a new one.
+    */
+    FramePtr AcquireFrame(int flags);
+
+    /* --------------------------------------------------------------------------------------------
+     * Return a frame to the pool so its memory can be reused.
+    */
+    void RecycleFrame(FramePtr && frame);
+
     /* --------------------------------------------------------------------------------------------
      * Proxy for DataHandler()
     */
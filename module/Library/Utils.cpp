@@ -86,6 +86,7 @@ static SQInteger SqExtractIPv4(HSQUIRRELVM vm)
 extern void Register_Vector(HSQUIRRELVM vm, Table & ns);
 extern void Register_Native_String(HSQUIRRELVM vm, Table & ns);
 extern void Register_ServerAnnouncer(HSQUIRRELVM vm, Table & ns);
+extern void Register_Hash(HSQUIRRELVM vm, Table & ns);
 
 // ================================================================================================
 void Register_Utils(HSQUIRRELVM vm)
@@ -95,6 +96,7 @@ void Register_Utils(HSQUIRRELVM vm)
     Register_Vector(vm, ns);
     Register_Native_String(vm, ns);
     Register_ServerAnnouncer(vm, ns);
+    Register_Hash(vm, ns);
 
     ns.SquirrelFunc(_SC("ExtractIPv4"), &SqExtractIPv4);
 
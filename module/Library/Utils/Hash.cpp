@@ -0,0 +1,199 @@
+// ------------------------------------------------------------------------------------------------
+#include "Library/Utils/Hash.hpp"
+
+// ------------------------------------------------------------------------------------------------
+namespace SqMod {
+
+// ------------------------------------------------------------------------------------------------
+SQMOD_DECL_TYPENAME(SqXXH3HasherTn, _SC("SqXXH3Hasher"))
+
+// ------------------------------------------------------------------------------------------------
+String XXH128ToHex(const XXH128_hash_t & h)
+{
+    static const SQChar digits[] = _SC("0123456789abcdef");
+    // Canonical representation is big endian regardless of the platform
+    XXH128_canonical_t c;
+    XXH128_canonicalFromHash(&c, h);
+    String s(sizeof(c.digest) * 2, '0');
+    for (size_t i = 0; i < sizeof(c.digest); ++i)
+    {
+        s[i * 2] = digits[c.digest[i] >> 4];
+        s[i * 2 + 1] = digits[c.digest[i] & 0xF];
+    }
+    return s;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::pair< const void *, size_t > XXH3BufferRange(const SqBuffer & b, SQInteger offset, SQInteger length)
+{
+    const Buffer & buf = b.Valid();
+    const auto cap = static_cast< SQInteger >(buf.Capacity());
+    // Default to the data written so far
+    if (length < 0 && offset >= 0)
+    {
+        length = static_cast< SQInteger >(buf.Position()) - offset;
+    }
+    // Make sure the range is within the buffer (written so the bounds themselves cannot overflow)
+    if (offset < 0 || length < 0 || offset > cap || length > cap - offset)
+    {
+        STHROWF("Range ({}:{}) is outside the buffer capacity ({})", offset, length, buf.Capacity());
+    }
+    // An empty buffer has no memory but XXH3 accepts a null pointer with zero length
+    return {buf ? buf.Get< uint8_t >() + offset : nullptr, static_cast< size_t >(length)};
+}
+
+// ------------------------------------------------------------------------------------------------
+SqXXH3Hasher::SqXXH3Hasher(bool wide, SQInteger seed)
+    : mState(XXH3_createState()), mSeed(static_cast< XXH64_hash_t >(seed)), mWide(wide)
+{
+    if (mState == nullptr)
+    {
+        STHROWF("Unable to allocate hash state");
+    }
+    Reset();
+}
+
+// ------------------------------------------------------------------------------------------------
+SqXXH3Hasher::~SqXXH3Hasher()
+{
+    XXH3_freeState(mState);
+}
+
+// ------------------------------------------------------------------------------------------------
+SqXXH3Hasher & SqXXH3Hasher::Reset()
+{
+    if (mWide)
+    {
+        XXH3_128bits_reset_withSeed(mState, mSeed);
+    }
+    else
+    {
+        XXH3_64bits_reset_withSeed(mState, mSeed);
+    }
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+SqXXH3Hasher & SqXXH3Hasher::Feed(const void * data, size_t size)
+{
+    if (mWide)
+    {
+        XXH3_128bits_update(mState, data, size);
+    }
+    else
+    {
+        XXH3_64bits_update(mState, data, size);
+    }
+    return *this;
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger SqXXH3Hasher::GetDigest64() const
+{
+    if (mWide)
+    {
+        STHROWF("128-bit hashes can only be retrieved as hexadecimal strings");
+    }
+    return static_cast< SQInteger >(XXH3_64bits_digest(mState));
+}
+
+// ------------------------------------------------------------------------------------------------
+String SqXXH3Hasher::GetHex() const
+{
+    if (mWide)
+    {
+        return XXH128ToHex(XXH3_128bits_digest(mState));
+    }
+    return fmt::format("{:016x}", XXH3_64bits_digest(mState));
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqXXH3_64(HSQUIRRELVM vm)
+{
+    // Attempt to retrieve the value from the stack as a string
+    StackStrF val(vm, 2);
+    // Have we failed to retrieve the string?
+    if (SQ_FAILED(val.Proc(false)))
+    {
+        return val.mRes; // Propagate the error!
+    }
+    // Was a seed specified?
+    SQInteger seed = 0;
+    if (sq_gettop(vm) > 2 && SQ_FAILED(sq_getinteger(vm, 3, &seed)))
+    {
+        return sq_throwerror(vm, _SC("Invalid hash seed"));
+    }
+    // Push the result on the stack
+    sq_pushinteger(vm, static_cast< SQInteger >(XXH3_64bits_withSeed(val.mPtr, static_cast< size_t >(val.mLen),
+                                                                     static_cast< XXH64_hash_t >(seed))));
+    return 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqXXH3_128(HSQUIRRELVM vm)
+{
+    // Attempt to retrieve the value from the stack as a string
+    StackStrF val(vm, 2);
+    // Have we failed to retrieve the string?
+    if (SQ_FAILED(val.Proc(false)))
+    {
+        return val.mRes; // Propagate the error!
+    }
+    // Was a seed specified?
+    SQInteger seed = 0;
+    if (sq_gettop(vm) > 2 && SQ_FAILED(sq_getinteger(vm, 3, &seed)))
+    {
+        return sq_throwerror(vm, _SC("Invalid hash seed"));
+    }
+    // Push the result on the stack
+    Var< String >::push(vm, XXH128ToHex(XXH3_128bits_withSeed(val.mPtr, static_cast< size_t >(val.mLen),
+                                                              static_cast< XXH64_hash_t >(seed))));
+    return 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+static SQInteger SqXXH3_64Buffer(const SqBuffer & b, SQInteger offset, SQInteger length)
+{
+    auto r = XXH3BufferRange(b, offset, length);
+    return static_cast< SQInteger >(XXH3_64bits(r.first, r.second));
+}
+
+// ------------------------------------------------------------------------------------------------
+static String SqXXH3_128Buffer(const SqBuffer & b, SQInteger offset, SQInteger length)
+{
+    auto r = XXH3BufferRange(b, offset, length);
+    return XXH128ToHex(XXH3_128bits(r.first, r.second));
+}
+
+// ================================================================================================
+void Register_Hash(HSQUIRRELVM vm, Table & ns)
+{
+    // --------------------------------------------------------------------------------------------
+    ns.Bind(_SC("XXH3Hasher"),
+        Class< SqXXH3Hasher, NoCopy< SqXXH3Hasher > >(vm, SqXXH3HasherTn::Str)
+        // Constructors
+        .Ctor()
+        .Ctor< bool >()
+        .Ctor< bool, SQInteger >()
+        // Meta-methods
+        .SquirrelFunc(_SC("_typename"), &SqXXH3HasherTn::Fn)
+        // Properties
+        .Prop(_SC("Wide"), &SqXXH3Hasher::IsWide)
+        .Prop(_SC("Seed"), &SqXXH3Hasher::GetSeed)
+        .Prop(_SC("Digest"), &SqXXH3Hasher::GetDigest64)
+        .Prop(_SC("Hex"), &SqXXH3Hasher::GetHex)
+        // Member Methods
+        .Func(_SC("Reset"), &SqXXH3Hasher::Reset)
+        .Func(_SC("ResetWithSeed"), &SqXXH3Hasher::ResetWithSeed)
+        .Func(_SC("Update"), &SqXXH3Hasher::Update)
+        .Func(_SC("UpdateBuffer"), &SqXXH3Hasher::UpdateBuffer)
+        .Func(_SC("UpdateBufferRange"), &SqXXH3Hasher::UpdateBufferRange)
+    );
+    // --------------------------------------------------------------------------------------------
+    ns.SquirrelFunc(_SC("XXH3_64"), &SqXXH3_64);
+    ns.SquirrelFunc(_SC("XXH3_128"), &SqXXH3_128);
+    ns.Func(_SC("XXH3_64Buffer"), &SqXXH3_64Buffer);
+    ns.Func(_SC("XXH3_128Buffer"), &SqXXH3_128Buffer);
+}
+
+} // Namespace:: SqMod
@@ -0,0 +1,152 @@
+#pragma once
+
+// ------------------------------------------------------------------------------------------------
+#include "Core/Utility.hpp"
+#include "Library/IO/Buffer.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <xxhash.h>
+
+// ------------------------------------------------------------------------------------------------
+namespace SqMod {
+
+/* ------------------------------------------------------------------------------------------------
+ * Format a 128-bit XXH3 hash as a hexadecimal string in canonical (big endian) order.
+*/
+SQMOD_NODISCARD String XXH128ToHex(const XXH128_hash_t & h);
+
+/* ------------------------------------------------------------------------------------------------
+ * Retrieve the specified range of a memory buffer. Negative length means until the cursor position.
+*/
+SQMOD_NODISCARD std::pair< const void *, size_t > XXH3BufferRange(const SqBuffer & b, SQInteger offset, SQInteger length);
+
+/* ------------------------------------------------------------------------------------------------
+ * Streaming XXH3 hash computation over strings and memory buffers.
+*/
+struct SqXXH3Hasher
+{
+    /* --------------------------------------------------------------------------------------------
+     * Default constructor. Computes 64-bit hashes without a seed.
+    */
+    SqXXH3Hasher()
+        : SqXXH3Hasher(false, 0)
+    {
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Construct a hasher that computes either 64-bit or 128-bit hashes without a seed.
+    */
+    explicit SqXXH3Hasher(bool wide)
+        : SqXXH3Hasher(wide, 0)
+    {
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Construct a hasher that computes either 64-bit or 128-bit hashes with the specified seed.
+    */
+    SqXXH3Hasher(bool wide, SQInteger seed);
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy constructor (disabled).
+    */
+    SqXXH3Hasher(const SqXXH3Hasher & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move constructor (disabled).
+    */
+    SqXXH3Hasher(SqXXH3Hasher && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Destructor.
+    */
+    ~SqXXH3Hasher();
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy assignment operator (disabled).
+    */
+    SqXXH3Hasher & operator = (const SqXXH3Hasher & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move assignment operator (disabled).
+    */
+    SqXXH3Hasher & operator = (SqXXH3Hasher && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * See whether this hasher computes 128-bit hashes.
+    */
+    SQMOD_NODISCARD bool IsWide() const
+    {
+        return mWide;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the seed used by this hasher.
+    */
+    SQMOD_NODISCARD SQInteger GetSeed() const
+    {
+        return static_cast< SQInteger >(mSeed);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Discard the data hashed so far.
+    */
+    SqXXH3Hasher & Reset();
+
+    /* --------------------------------------------------------------------------------------------
+     * Discard the data hashed so far and use a different seed.
+    */
+    SqXXH3Hasher & ResetWithSeed(SQInteger seed)
+    {
+        mSeed = static_cast< XXH64_hash_t >(seed);
+        return Reset();
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Hash the specified string.
+    */
+    SqXXH3Hasher & Update(StackStrF & str)
+    {
+        return Feed(str.mPtr, static_cast< size_t >(ClampMin(str.mLen, SQInteger(0))));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Hash the data from a memory buffer up to the cursor position.
+    */
+    SqXXH3Hasher & UpdateBuffer(const SqBuffer & b)
+    {
+        return UpdateBufferRange(b, 0, -1);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Hash the specified range of a memory buffer.
+    */
+    SqXXH3Hasher & UpdateBufferRange(const SqBuffer & b, SQInteger offset, SQInteger length)
+    {
+        auto r = XXH3BufferRange(b, offset, length);
+        return Feed(r.first, r.second);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the 64-bit hash of the data so far. Only available to 64-bit hashers.
+    */
+    SQMOD_NODISCARD SQInteger GetDigest64() const;
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the hash of the data so far as a hexadecimal string.
+    */
+    SQMOD_NODISCARD String GetHex() const;
+
+private:
+
+    /* --------------------------------------------------------------------------------------------
+     * Feed raw data to the hash state.
+    */
+    SqXXH3Hasher & Feed(const void * data, size_t size);
+
+    // --------------------------------------------------------------------------------------------
+    XXH3_state_t *  mState{nullptr}; // Hash state.
+    XXH64_hash_t    mSeed{0}; // Seed used when resetting the state.
+    bool            mWide{false}; // Whether this computes 128-bit hashes.
+};
+
+} // Namespace:: SqMod
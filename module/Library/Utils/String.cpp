@@ -79,6 +79,7 @@ void Register_Native_String(HSQUIRRELVM vm, Table & ns)
         .Prop(_SC("Upper"), &SqString::GetUpper)
         .Prop(_SC("Fnv1a32"), &SqString::GetFnv1a32)
         .Prop(_SC("Fnv1a64"), &SqString::GetFnv1a64)
+        .Prop(_SC("XXH3"), &SqString::GetXXH3)
         // Member Methods
         .Func(_SC("Get"), &SqString::Get)
         .Func(_SC("Set"), &SqString::Set)
@@ -913,6 +913,14 @@ struct SqString
         return static_cast< SQInteger >(FnvHash64(reinterpret_cast< FnvHashData >(mS.data()), mS.size()));
     }
 
+    /* --------------------------------------------------------------------------------------------
+     * Generate a hash of the string using the 64-bit XXH3 algorithm.
+    */
+    SQMOD_NODISCARD SQInteger GetXXH3() const
+    {
+        return static_cast< SQInteger >(HashName(mS));
+    }
+
     /* --------------------------------------------------------------------------------------------
      * Compute the Levenshtein distance between two strings.
     */
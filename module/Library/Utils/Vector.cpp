@@ -11,14 +11,47 @@ SQMOD_DECL_TYPENAME(SqVectorFloat, _SC("SqVectorFloat"))
 SQMOD_DECL_TYPENAME(SqVectorByte, _SC("SqVectorByte"))
 SQMOD_DECL_TYPENAME(SqVectorBool, _SC("SqVectorBool"))
 
+// ------------------------------------------------------------------------------------------------
+template < class T, class C > static void Register_VectorNumeric(C &, std::false_type) { }
+
+// ------------------------------------------------------------------------------------------------
+template < class T, class C > static void Register_VectorNumeric(C & cls, std::true_type)
+{
+    using Container = SqVector< T >;
+    // --------------------------------------------------------------------------------------------
+    cls
+        // Properties
+        .Prop(_SC("Sum"), &Container::Sum)
+        .Prop(_SC("Min"), &Container::Min)
+        .Prop(_SC("Max"), &Container::Max)
+        .Prop(_SC("Mean"), &Container::Mean)
+        .Prop(_SC("StdDev"), &Container::StdDev)
+        // Member Methods
+        .Func(_SC("Histogram"), &Container::Histogram)
+        .Func(_SC("AddScalar"), &Container::AddScalar)
+        .Func(_SC("SubScalar"), &Container::SubScalar)
+        .Func(_SC("MulScalar"), &Container::MulScalar)
+        .Func(_SC("DivScalar"), &Container::DivScalar)
+        .Func(_SC("AddVec"), &Container::AddVec)
+        .Func(_SC("SubVec"), &Container::SubVec)
+        .Func(_SC("MulVec"), &Container::MulVec)
+        .Func(_SC("DivVec"), &Container::DivVec)
+        .Func(_SC("Clamp"), &Container::ClampValues)
+        .Func(_SC("Partition"), &Container::Partition)
+        .Func(_SC("NthElement"), &Container::NthElement)
+        .Func(_SC("TopK"), &Container::TopK)
+        .Func(_SC("ParallelSort"), &Container::ParallelSort);
+}
+
 // ------------------------------------------------------------------------------------------------
 template < class T, class U >
 static void Register_Vector(HSQUIRRELVM vm, Table & ns, const SQChar * name)
 {
 	using Container = SqVector< T >;
     // --------------------------------------------------------------------------------------------
-    ns.Bind(name,
-        Class< Container, NoCopy< Container > >(vm, U::Str)
+    Class< Container, NoCopy< Container > > cls(vm, U::Str);
+    // --------------------------------------------------------------------------------------------
+    cls
         // Constructors
         .Ctor()
         .template Ctor< SQInteger >()
@@ -65,8 +98,12 @@ static void Register_Vector(HSQUIRRELVM vm, Table & ns, const SQChar * name)
         .Func(_SC("GenerateFrom"), &Container::GenerateFrom)
         .Func(_SC("GenerateBetween"), &Container::GenerateBetween)
         .Func(_SC("Sort"), &Container::Sort)
-        .Func(_SC("Shuffle"), &Container::Shuffle)
-    );
+        .Func(_SC("Shuffle"), &Container::Shuffle);
+    // Numeric kernels are only available to arithmetic element types
+    Register_VectorNumeric< T >(cls, std::integral_constant< bool,
+                                std::is_arithmetic< T >::value && !std::is_same< T, bool >::value >{});
+    // --------------------------------------------------------------------------------------------
+    ns.Bind(name, cls);
 }
 
 // ================================================================================================
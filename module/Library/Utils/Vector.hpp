@@ -11,6 +11,11 @@
 #include <random>
 #include <iterator>
 #include <algorithm>
+#include <numeric>
+#include <thread>
+#include <limits>
+#include <system_error>
+#include <cmath>
 
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
@@ -117,6 +122,21 @@ template < class T > struct SqVector
     */
     using ReturnType = typename std::conditional< std::is_same< T, bool >::value, T, T & >::type;
 
+    /* --------------------------------------------------------------------------------------------
+     * Type used to accumulate values from numeric containers.
+    */
+    using Accumulator = typename std::conditional< std::is_floating_point< T >::value, SQFloat, SQInteger >::type;
+
+    /* --------------------------------------------------------------------------------------------
+     * Number of elements below which sorting in parallel is not worth it.
+    */
+    static constexpr size_t PARALLEL_SORT_MIN = 65536;
+
+    /* --------------------------------------------------------------------------------------------
+     * Whether the elements are signed integers (and can overflow when divided by -1).
+    */
+    static constexpr bool SIGNED_INTEGER = std::is_integral< T >::value && std::is_signed< T >::value;
+
     /* --------------------------------------------------------------------------------------------
      * Reference to the container instance.
     */
@@ -707,6 +727,342 @@ template < class T > struct SqVector
         std::shuffle(mC->begin(), mC->end(), g);
         return *this;
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Sort the elements from the container using multiple threads. Small containers are sorted normally.
+    */
+    SqVector & ParallelSort(SQInteger threads)
+    {
+        Container & c = Valid();
+        // Use the hardware concurrency when not specified
+        auto n = static_cast< size_t >(threads > 0 ? threads : std::thread::hardware_concurrency());
+        // Is it worth it?
+        if (n < 2 || c.size() < PARALLEL_SORT_MIN)
+        {
+            std::sort(c.begin(), c.end());
+            return *this;
+        }
+        // Don't create chunks smaller than the threshold
+        n = std::min(n, c.size() / (PARALLEL_SORT_MIN / 2));
+        const size_t chunk = c.size() / n;
+        // Chunk boundaries (the last chunk takes the remainder)
+        std::vector< size_t > bounds;
+        bounds.reserve(n + 1);
+        for (size_t i = 0; i < n; ++i)
+        {
+            bounds.push_back(i * chunk);
+        }
+        bounds.push_back(c.size());
+        // Sort each chunk on its own thread (the last one on this thread)
+        std::vector< std::thread > workers;
+        workers.reserve(n - 1);
+        try
+        {
+            for (size_t i = 0; i + 1 < n; ++i)
+            {
+                workers.emplace_back([&c, &bounds, i]() {
+                    std::sort(c.begin() + bounds[i], c.begin() + bounds[i + 1]);
+                });
+            }
+        }
+        catch (const std::system_error &)
+        {
+            // Could not start another thread. Sort the chunks nobody picked up on this thread
+            for (size_t i = workers.size(); i + 1 < n; ++i)
+            {
+                std::sort(c.begin() + bounds[i], c.begin() + bounds[i + 1]);
+            }
+        }
+        std::sort(c.begin() + bounds[n - 1], c.end());
+        for (auto & w : workers)
+        {
+            w.join();
+        }
+        // Merge adjacent chunks pairwise until a single one remains
+        while (bounds.size() > 2)
+        {
+            std::vector< size_t > merged;
+            merged.reserve(bounds.size() / 2 + 2);
+            size_t i = 0;
+            for (; i + 2 < bounds.size(); i += 2)
+            {
+                std::inplace_merge(c.begin() + bounds[i], c.begin() + bounds[i + 1], c.begin() + bounds[i + 2]);
+                merged.push_back(bounds[i]);
+            }
+            // Carry over an odd chunk
+            for (; i < bounds.size(); ++i)
+            {
+                merged.push_back(bounds[i]);
+            }
+            bounds.swap(merged);
+        }
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Compute the sum of the elements from the container.
+    */
+    SQMOD_NODISCARD Accumulator Sum() const
+    {
+        return SumOf(Valid(), std::is_integral< T >{});
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the smallest element from the container.
+    */
+    SQMOD_NODISCARD T Min() const
+    {
+        const Container & c = ValidPop();
+        return *std::min_element(c.begin(), c.end());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the largest element from the container.
+    */
+    SQMOD_NODISCARD T Max() const
+    {
+        const Container & c = ValidPop();
+        return *std::max_element(c.begin(), c.end());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Compute the arithmetic mean of the elements from the container.
+    */
+    SQMOD_NODISCARD SQFloat Mean() const
+    {
+        const Container & c = ValidPop();
+        return static_cast< SQFloat >(std::accumulate(c.begin(), c.end(), SQFloat(0))) / static_cast< SQFloat >(c.size());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Compute the population standard deviation of the elements from the container.
+    */
+    SQMOD_NODISCARD SQFloat StdDev() const
+    {
+        const SQFloat mean = Mean();
+        SQFloat sum = 0;
+        for (const T & v : *mC)
+        {
+            const SQFloat d = static_cast< SQFloat >(v) - mean;
+            sum += d * d;
+        }
+        return std::sqrt(sum / static_cast< SQFloat >(mC->size()));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Count the elements that fall in each of the equal width bins between lo and hi.
+     * Counts are stored in the given integer container. Elements outside the range are ignored.
+    */
+    void Histogram(SqVector< SQInteger > & out, SQFloat lo, SQFloat hi, SQInteger bins) const
+    {
+        const Container & c = Valid();
+        if (bins <= 0)
+        {
+            STHROWF("Invalid number of histogram bins ({})", bins);
+        }
+        else if (!(hi > lo))
+        {
+            STHROWF("Invalid histogram range ({} .. {})", lo, hi);
+        }
+        auto & h = out.Valid();
+        h.assign(static_cast< size_t >(bins), 0);
+        const SQFloat scale = static_cast< SQFloat >(bins) / (hi - lo);
+        for (const T & v : c)
+        {
+            const auto f = static_cast< SQFloat >(v);
+            // Is the value within range? The upper bound goes in the last bin
+            if (f >= lo && f <= hi)
+            {
+                h[std::min(static_cast< size_t >((f - lo) * scale), h.size() - 1)] += 1;
+            }
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Add a value to each element from the container.
+    */
+    SqVector & AddScalar(T v)
+    {
+        for (T & e : Valid()) e += v;
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Subtract a value from each element from the container.
+    */
+    SqVector & SubScalar(T v)
+    {
+        for (T & e : Valid()) e -= v;
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Multiply each element from the container by a value.
+    */
+    SqVector & MulScalar(T v)
+    {
+        for (T & e : Valid()) e *= v;
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Divide each element from the container by a value.
+    */
+    SqVector & DivScalar(T v)
+    {
+        if (std::is_integral< T >::value && v == T(0))
+        {
+            STHROWF("Division by zero");
+        }
+        // The smallest signed value has no positive counterpart
+        else if (SIGNED_INTEGER && v == T(-1) && std::find(Valid().begin(), Valid().end(), std::numeric_limits< T >::min()) != Valid().end())
+        {
+            STHROWF("Division overflow ({} / -1)", std::numeric_limits< T >::min());
+        }
+        for (T & e : Valid()) e /= v;
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Limit each element from the container to the specified range.
+    */
+    SqVector & ClampValues(T lo, T hi)
+    {
+        for (T & e : Valid()) e = std::min(std::max(e, lo), hi);
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Add the elements from another container of the same size to the elements from this container.
+    */
+    SqVector & AddVec(SqVector & o)
+    {
+        return Combine(o, [](T & a, T b) { a += b; });
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Subtract the elements from another container of the same size from the elements from this container.
+    */
+    SqVector & SubVec(SqVector & o)
+    {
+        return Combine(o, [](T & a, T b) { a -= b; });
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Multiply the elements from this container by the elements from another container of the same size.
+    */
+    SqVector & MulVec(SqVector & o)
+    {
+        return Combine(o, [](T & a, T b) { a *= b; });
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Divide the elements from this container by the elements from another container of the same size.
+    */
+    SqVector & DivVec(SqVector & o)
+    {
+        if (std::is_integral< T >::value && std::find(o.Valid().begin(), o.Valid().end(), T(0)) != o.Valid().end())
+        {
+            STHROWF("Division by zero");
+        }
+        else if (SIGNED_INTEGER)
+        {
+            const Container & a = Valid();
+            const Container & b = o.Valid();
+            // The smallest signed value has no positive counterpart
+            for (size_t i = 0, n = std::min(a.size(), b.size()); i < n; ++i)
+            {
+                if (b[i] == T(-1) && a[i] == std::numeric_limits< T >::min())
+                {
+                    STHROWF("Division overflow ({} / -1) at index {}", a[i], i);
+                }
+            }
+        }
+        return Combine(o, [](T & a, T b) { a /= b; });
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Move the elements smaller than the pivot to the front. Returns the number of such elements.
+    */
+    SQInteger Partition(T pivot)
+    {
+        Container & c = Valid();
+        return static_cast< SQInteger >(std::partition(c.begin(), c.end(), [pivot](const T & v) { return v < pivot; }) - c.begin());
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Place the element that would be at position n in a sorted container there and return it.
+     * Elements before it are not greater and elements after it are not smaller.
+    */
+    T NthElement(SQInteger n)
+    {
+        Container & c = ValidIdx(n);
+        std::nth_element(c.begin(), c.begin() + n, c.end());
+        return c[static_cast< size_t >(n)];
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Move the k largest elements to the front, in descending order. Returns the number of moved elements.
+    */
+    SQInteger TopK(SQInteger k)
+    {
+        Container & c = Valid();
+        const auto n = std::min(static_cast< size_t >(ClampMin(k, SQInteger(0))), c.size());
+        std::partial_sort(c.begin(), c.begin() + static_cast< std::ptrdiff_t >(n), c.end(), std::greater< T >());
+        return static_cast< SQInteger >(n);
+    }
+
+private:
+
+    /* --------------------------------------------------------------------------------------------
+     * Compute the sum of the floating point elements from the container.
+    */
+    static Accumulator SumOf(const Container & c, std::false_type)
+    {
+        return std::accumulate(c.begin(), c.end(), Accumulator(0));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Compute the sum of the integer elements from the container. Throws instead of overflowing.
+    */
+    static Accumulator SumOf(const Container & c, std::true_type)
+    {
+        Accumulator s = 0;
+        for (const T & v : c)
+        {
+            const auto x = static_cast< Accumulator >(v);
+            if ((x > 0 && s > std::numeric_limits< Accumulator >::max() - x) ||
+                (x < 0 && s < std::numeric_limits< Accumulator >::min() - x))
+            {
+                STHROWF("Sum overflows the integer range");
+            }
+            s += x;
+        }
+        return s;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Combine the elements from another container of the same size with the elements from this container.
+    */
+    template < class F > SqVector & Combine(SqVector & o, F f)
+    {
+        Container & a = Valid();
+        const Container & b = o.Valid();
+        if (a.size() != b.size())
+        {
+            STHROWF("Vector container size mismatch ({} != {})", a.size(), b.size());
+        }
+        // Plain indexed loop so the compiler can vectorize it
+        for (size_t i = 0, n = a.size(); i < n; ++i)
+        {
+            f(a[i], b[i]);
+        }
+        return *this;
+    }
 };
 
+// ------------------------------------------------------------------------------------------------
+template < class T > constexpr size_t SqVector< T >::PARALLEL_SORT_MIN;
+template < class T > constexpr bool SqVector< T >::SIGNED_INTEGER;
+
 } // Namespace:: SqMod
@@ -22,6 +22,14 @@ extern void InitializeNet();
 extern void InitializePocoDataConnectors();
 extern void ProcessRoutines();
 extern void ProcessTasks();
+extern void ProcessLoot();
+extern void ProcessProfiler();
+extern void FrameTimingBegin();
+extern void FrameTimingStage(FrameStage stage);
+extern void FrameTimingEnd();
+extern void SpatialNewFrame();
+extern void EntitySnapshotNewFrame();
+extern void EntityFlushDeferred();
 extern void ProcessThreads();
 extern void ProcessNet();
 #ifdef VCMP_ENABLE_DISCORD
@@ -160,6 +168,10 @@ static void OnServerShutdown()
 // ------------------------------------------------------------------------------------------------
 static void OnServerFrame(float elapsed_time)
 {
+    // Time each stage of the frame
+    FrameTimingBegin();
+    // Entities may have moved since the last frame
+    SpatialNewFrame();
     // Attempt to forward the event
     try
     {
@@ -168,19 +180,47 @@ static void OnServerFrame(float elapsed_time)
         //SQMOD_SV_EV_TRACEBACK("[TRACE>] OnServerFrame")
     }
     SQMOD_CATCH_EVENT_EXCEPTION(OnServerFrame)
+    FrameTimingStage(FS_EVENT);
     // Process routines and tasks, if any
     ProcessRoutines();
+    FrameTimingStage(FS_ROUTINES);
     ProcessTasks();
+    FrameTimingStage(FS_TASKS);
+    // Process loot managers
+    ProcessLoot();
+    FrameTimingStage(FS_LOOT);
     // Process threads
     ProcessThreads();
+    FrameTimingStage(FS_THREADS);
     // Process network
     ProcessNet();
+    FrameTimingStage(FS_NET);
     // Process DPP
 #ifdef VCMP_ENABLE_DISCORD
     ProcessDPP();
+    FrameTimingStage(FS_DPP);
 #endif
     // Process log messages from other threads
     Logger::Get().ProcessQueue();
+    FrameTimingStage(FS_LOGGER);
+    // Hot reload scripts, unless a full reload was requested
+    if (!g_Reload)
+    {
+        try
+        {
+            Core::Get().ProcessHotReload();
+        }
+        SQMOD_CATCH_EVENT_EXCEPTION(OnServerFrame)
+    }
+    FrameTimingStage(FS_RELOAD);
+    // Send the entity setter writes deferred during this frame
+    EntityFlushDeferred();
+    // Entity state cached during this frame expires once the next updates arrive
+    EntitySnapshotNewFrame();
+    FrameTimingStage(FS_ENTITIES);
+    FrameTimingEnd();
+    // Write the periodic profiler dump, if any (not part of the frame timings)
+    ProcessProfiler();
     // See if a reload was requested
     SQMOD_RELOAD_CHECK(g_Reload)
 }
@@ -560,6 +560,50 @@ static inline uint32_t Player_CountWhereNameMatches(bool neg, bool cs, const SQC
     return cnt;
 }
 
+// ------------------------------------------------------------------------------------------------
+uint32_t g_SpatialFrame = 0;
+float g_SpatialCell = 50.0f;
+
+// ------------------------------------------------------------------------------------------------
+static SQFloat Spatial_GetCellSize()
+{
+    return static_cast< SQFloat >(g_SpatialCell);
+}
+
+// ------------------------------------------------------------------------------------------------
+static void Spatial_SetCellSize(SQFloat size)
+{
+    if (!(size >= 1.0) || !std::isfinite(size))
+    {
+        STHROWF("Spatial cell size must be at least 1: {}", size);
+    }
+    g_SpatialCell = static_cast< float >(size);
+}
+
+// ------------------------------------------------------------------------------------------------
+static void Spatial_Invalidate()
+{
+    ++g_SpatialFrame;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Bind the spatial queries of a certain entity type.
+*/
+template < typename T > static void Spatial_Bind(HSQUIRRELVM vm, Table & ns, const SQChar * name)
+{
+    ns.Bind(name, Table(vm)
+        .Func(_SC("InRadius"), &Spatial< T >::InRadius)
+        .Func(_SC("InRadiusWorld"), &Spatial< T >::InRadiusWorld)
+        .Func(_SC("InBox"), &Spatial< T >::InBox)
+        .Func(_SC("InBoxWorld"), &Spatial< T >::InBoxWorld)
+        .Func(_SC("Nearest"), &Spatial< T >::Nearest)
+        .Func(_SC("NearestWorld"), &Spatial< T >::NearestWorld)
+        .Func(_SC("ForeachInRadius"), &Spatial< T >::ForeachInRadius)
+        .Func(_SC("ForeachInRadiusWorld"), &Spatial< T >::ForeachInRadiusWorld)
+        .Func(_SC("CountInRadius"), &Spatial< T >::CountInRadius)
+    );
+}
+
 // ================================================================================================
 void Register(HSQUIRRELVM vm)
 {
@@ -923,6 +967,19 @@ void Register(HSQUIRRELVM vm)
     );
 
     RootTable(vm).Bind(_SC("SqCount"), count_ns);
+
+    Table spatial_ns(vm);
+
+    Spatial_Bind< CCheckpoint >(vm, spatial_ns, _SC("Checkpoint"));
+    Spatial_Bind< CObject >(vm, spatial_ns, _SC("Object"));
+    Spatial_Bind< CPickup >(vm, spatial_ns, _SC("Pickup"));
+    Spatial_Bind< CPlayer >(vm, spatial_ns, _SC("Player"));
+    Spatial_Bind< CVehicle >(vm, spatial_ns, _SC("Vehicle"));
+    spatial_ns.Func(_SC("GetCellSize"), &Spatial_GetCellSize);
+    spatial_ns.Func(_SC("SetCellSize"), &Spatial_SetCellSize);
+    spatial_ns.Func(_SC("Invalidate"), &Spatial_Invalidate);
+
+    RootTable(vm).Bind(_SC("SqSpatial"), spatial_ns);
 }
 
 } // Namespace:: Algo
@@ -933,4 +990,11 @@ void Register_Algo(HSQUIRRELVM vm)
     Algo::Register(vm);
 }
 
+// ------------------------------------------------------------------------------------------------
+void SpatialNewFrame()
+{
+    // Entities may have moved so the spatial indexes must be rebuilt on the next query
+    ++Algo::g_SpatialFrame;
+}
+
 } // Namespace:: SqMod
@@ -2,11 +2,15 @@
 
 // ------------------------------------------------------------------------------------------------
 #include "Core.hpp"
+#include "Base/Vector3.hpp"
 
 // ------------------------------------------------------------------------------------------------
+#include <cmath>
 #include <cstring>
 #include <vector>
 #include <functional>
+#include <algorithm>
+#include <unordered_map>
 
 // ------------------------------------------------------------------------------------------------
 #define SQMOD_VALID_TAG_STR(t) if (!(t)) { STHROWF("The specified tag is invalid"); }
@@ -151,6 +155,63 @@ inline bool ApplyStrFilter(const SQChar * name, const SQChar * filter, bool cs)
     return cs ? NameFilterCheck(filter, name) : NameFilterCheckInsensitive(filter, name);
 }
 
+/* ------------------------------------------------------------------------------------------------
+ * Wild-card filter prepared once and then checked against many names. Case insensitive filters
+ * are converted to lower case up front instead of once for every name.
+*/
+struct StrFilter
+{
+    /* --------------------------------------------------------------------------------------------
+     * Prepare the specified filter.
+    */
+    StrFilter(const SQChar * filter, bool cs)
+        : mFilter(filter), mLower(), mCs(cs)
+    {
+        if (!cs && filter != nullptr)
+        {
+            mLower.assign(filter);
+            std::transform(mLower.begin(), mLower.end(), mLower.begin(),
+                            [](SQChar c) { return static_cast< SQChar >(std::tolower(c)); });
+            mFilter = mLower.c_str();
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy constructor (disabled). The filter may point into the lower case copy.
+    */
+    StrFilter(const StrFilter & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move constructor (disabled).
+    */
+    StrFilter(StrFilter && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy assignment operator (disabled).
+    */
+    StrFilter & operator = (const StrFilter & o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move assignment operator (disabled).
+    */
+    StrFilter & operator = (StrFilter && o) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * See whether the specified name satisfies the filter.
+    */
+    bool operator () (const SQChar * name) const
+    {
+        return mCs ? NameFilterCheck(mFilter, name) : NameFilterCheckLowered(mFilter, name);
+    }
+
+private:
+
+    // --------------------------------------------------------------------------------------------
+    const SQChar *  mFilter; // The filter to check against.
+    String          mLower; // Lower case copy of the filter, if case insensitive.
+    bool            mCs; // Whether the filter is case sensitive.
+};
+
 /* ------------------------------------------------------------------------------------------------
  * Collect all elements within the specified range that the inspector deems worthy.
 */
@@ -409,9 +470,10 @@ void EachMatches(Iterator first, Iterator last,
                         Inspector inspect, Retriever retrieve, Collector collect,
                         const SQChar * str, bool neg, bool cs)
 {
+    const StrFilter filter(str, cs);
     for (; first != last; ++first)
     {
-        if (inspect(*first) && ApplyStrFilter(retrieve(*first).c_str(), str, cs) == neg)
+        if (inspect(*first) && filter(retrieve(*first).c_str()) == neg)
         {
             collect(*first);
         }
@@ -427,9 +489,10 @@ void EachMatchesWhile(Iterator first, Iterator last,
                         Inspector inspect, Retriever retrieve, Collector collect,
                         const SQChar * str, bool neg, bool cs)
 {
+    const StrFilter filter(str, cs);
     for (; first != last; ++first)
     {
-        if (inspect(*first) && ApplyStrFilter(retrieve(*first).c_str(), str, cs) == neg)
+        if (inspect(*first) && filter(retrieve(*first).c_str()) == neg)
         {
             if (!collect(*first))
             {
@@ -553,9 +616,10 @@ void FirstMatches(Iterator first, Iterator last,
                         Inspector inspect, Retriever retrieve, Receiver receive,
                         const SQChar * str, bool neg, bool cs)
 {
+    const StrFilter filter(str, cs);
     for (; first != last; ++first)
     {
-        if (inspect(*first) && ApplyStrFilter(retrieve(*first).c_str(), str, cs) == neg)
+        if (inspect(*first) && filter(retrieve(*first).c_str()) == neg)
         {
             receive(*first);
             break;
@@ -648,6 +712,15 @@ template <> struct InstSpec< CCheckpoint >
     {
         return Core::Get().GetNullCheckpoint();
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the position and world of an entity.
+    */
+    static inline int32_t Locate(int32_t id, Vector3 & pos)
+    {
+        _Func->GetCheckPointPosition(id, &pos.x, &pos.y, &pos.z);
+        return _Func->GetCheckPointWorld(id);
+    }
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -730,6 +803,15 @@ template <> struct InstSpec< CObject >
     {
         return Core::Get().GetNullObject();
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the position and world of an entity.
+    */
+    static inline int32_t Locate(int32_t id, Vector3 & pos)
+    {
+        _Func->GetObjectPosition(id, &pos.x, &pos.y, &pos.z);
+        return _Func->GetObjectWorld(id);
+    }
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -771,6 +853,15 @@ template <> struct InstSpec< CPickup >
     {
         return Core::Get().GetNullPickup();
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the position and world of an entity.
+    */
+    static inline int32_t Locate(int32_t id, Vector3 & pos)
+    {
+        _Func->GetPickupPosition(id, &pos.x, &pos.y, &pos.z);
+        return _Func->GetPickupWorld(id);
+    }
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -812,6 +903,15 @@ template <> struct InstSpec< CPlayer >
     {
         return Core::Get().GetNullPlayer();
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the position and world of an entity.
+    */
+    static inline int32_t Locate(int32_t id, Vector3 & pos)
+    {
+        _Func->GetPlayerPosition(id, &pos.x, &pos.y, &pos.z);
+        return _Func->GetPlayerWorld(id);
+    }
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -853,6 +953,15 @@ template <> struct InstSpec< CVehicle >
     {
         return Core::Get().GetNullVehicle();
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the position and world of an entity.
+    */
+    static inline int32_t Locate(int32_t id, Vector3 & pos)
+    {
+        _Func->GetVehiclePosition(id, &pos.x, &pos.y, &pos.z);
+        return _Func->GetVehicleWorld(id);
+    }
 };
 
 /* ------------------------------------------------------------------------------------------------
@@ -1642,5 +1751,428 @@ public:
     }
 };
 
+/* ------------------------------------------------------------------------------------------------
+ * Incremented once per server frame to let the spatial indexes know they are out of date.
+*/
+extern uint32_t g_SpatialFrame;
+
+/* ------------------------------------------------------------------------------------------------
+ * Size of the cells used by the spatial indexes.
+*/
+extern float g_SpatialCell;
+
+/* ------------------------------------------------------------------------------------------------
+ * Spatial hash of the entities of a certain type. Entities are bucketed into square cells on the
+ * horizontal plane and the index is rebuilt lazily, at most once per frame, on the first query.
+*/
+template < typename T > struct Spatial
+{
+    // --------------------------------------------------------------------------------------------
+    typedef InstSpec< T > Inst; // The type of entity instance to work with.
+
+    /* --------------------------------------------------------------------------------------------
+     * Indexed entity.
+    */
+    struct Entry
+    {
+        uint64_t    mCell; // Cell that contains the entity.
+        int32_t     mID; // Entity identifier.
+        int32_t     mWorld; // Entity world.
+        Vector3     mPos; // Entity position.
+    };
+
+    // --------------------------------------------------------------------------------------------
+    typedef std::unordered_map< uint64_t, std::pair< uint32_t, uint32_t > > Cells;
+
+    // --------------------------------------------------------------------------------------------
+    static std::vector< Entry >                         s_Entries; // Entities sorted by cell.
+    static Cells                                        s_Cells; // Range of entries in each cell.
+    static std::vector< std::pair< float, uint32_t > >  s_Found; // Scratch space for sorted queries.
+    static uint32_t                                     s_Frame; // Frame of the last rebuild.
+    static float                                        s_Cell; // Cell size of the last rebuild.
+    static bool                                         s_Built; // Whether the index was ever built.
+    static int32_t                                      s_X0, s_Y0, s_X1, s_Y1; // Range of occupied cells.
+
+    /* --------------------------------------------------------------------------------------------
+     * Compute the cell coordinate of a position component. Must be finite. Far away positions share
+     * the cells on the edge of the coordinate range.
+    */
+    static inline int32_t Coord(float v)
+    {
+        const double c = std::floor(static_cast< double >(v) / s_Cell);
+        return c <= INT32_MIN ? INT32_MIN : (c >= INT32_MAX ? INT32_MAX : static_cast< int32_t >(c));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * See if a position has a cell.
+    */
+    static inline bool Finite(const Vector3 & pos)
+    {
+        return std::isfinite(pos.x) && std::isfinite(pos.y);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Throw an error if a position can't be used in a query.
+    */
+    static void Check(const Vector3 & pos)
+    {
+        if (!Finite(pos) || !std::isfinite(pos.z))
+        {
+            STHROWF("Invalid {} query position: {}, {}, {}", Inst::LcName, pos.x, pos.y, pos.z);
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * See if the entity of an entry still exists. The index may be older than the last destroy.
+    */
+    static inline bool Alive(const Entry & e)
+    {
+        return VALID_ENTITY((Inst::CBegin() + e.mID)->mID);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Compute the key of a cell.
+    */
+    static inline uint64_t Key(int32_t cx, int32_t cy)
+    {
+        return (static_cast< uint64_t >(static_cast< uint32_t >(cx)) << 32u) | static_cast< uint32_t >(cy);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Rebuild the index if it's out of date.
+    */
+    static void Update()
+    {
+        // Is the index up to date?
+        if (s_Built && s_Frame == g_SpatialFrame && s_Cell == g_SpatialCell)
+        {
+            return;
+        }
+        s_Entries.clear();
+        s_Cells.clear();
+        s_Frame = g_SpatialFrame;
+        s_Cell = g_SpatialCell;
+        s_Built = true;
+        s_X0 = s_Y0 = INT32_MAX;
+        s_X1 = s_Y1 = INT32_MIN;
+        // Gather the active entities
+        for (auto itr = Inst::CBegin(), end = Inst::CEnd(); itr != end; ++itr)
+        {
+            if (VALID_ENTITY(itr->mID))
+            {
+                Entry e{0, itr->mID, 0, Vector3()};
+                e.mWorld = Inst::Locate(e.mID, e.mPos);
+                // Entities without a valid position can't be found anyway
+                if (!Finite(e.mPos))
+                {
+                    continue;
+                }
+                const int32_t cx = Coord(e.mPos.x), cy = Coord(e.mPos.y);
+                e.mCell = Key(cx, cy);
+                // Remember the range of occupied cells
+                s_X0 = std::min(s_X0, cx);
+                s_Y0 = std::min(s_Y0, cy);
+                s_X1 = std::max(s_X1, cx);
+                s_Y1 = std::max(s_Y1, cy);
+                s_Entries.push_back(e);
+            }
+        }
+        // Group the entities by cell
+        std::sort(s_Entries.begin(), s_Entries.end(), [](const Entry & a, const Entry & b) { return a.mCell < b.mCell; });
+        // Remember where each cell begins and ends
+        for (uint32_t i = 0, n = static_cast< uint32_t >(s_Entries.size()); i < n;)
+        {
+            uint32_t j = i + 1;
+            while (j < n && s_Entries[j].mCell == s_Entries[i].mCell) ++j;
+            s_Cells.emplace(s_Entries[i].mCell, std::make_pair(i, j));
+            i = j;
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Visit the entities from a range of entries that still exist.
+    */
+    template < typename F > static inline void VisitEntries(uint32_t begin, uint32_t end, F & f)
+    {
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            if (Alive(s_Entries[i])) f(s_Entries[i]);
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Visit the entities from a single cell. Coordinates outside the cell range have no entities.
+    */
+    template < typename F > static inline void VisitCell(int64_t cx, int64_t cy, F & f)
+    {
+        if (cx < INT32_MIN || cx > INT32_MAX || cy < INT32_MIN || cy > INT32_MAX)
+        {
+            return;
+        }
+        auto itr = s_Cells.find(Key(static_cast< int32_t >(cx), static_cast< int32_t >(cy)));
+        if (itr != s_Cells.end())
+        {
+            VisitEntries(itr->second.first, itr->second.second, f);
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Visit the entities from the cells that overlap an area on the horizontal plane.
+    */
+    template < typename F > static void VisitCells(float x0, float y0, float x1, float y1, F f)
+    {
+        const int64_t cx0 = Coord(x0), cy0 = Coord(y0), cx1 = Coord(x1), cy1 = Coord(y1);
+        // Is the area empty?
+        if (cx1 < cx0 || cy1 < cy0)
+        {
+            return;
+        }
+        // Is the area larger than the number of occupied cells? Just scan the cells then
+        if ((static_cast< uint64_t >(cx1 - cx0) + 1) * (static_cast< uint64_t >(cy1 - cy0) + 1) > s_Cells.size())
+        {
+            for (const auto & c : s_Cells)
+            {
+                const auto cx = static_cast< int32_t >(c.first >> 32u), cy = static_cast< int32_t >(c.first & 0xFFFFFFFFu);
+                if (cx >= cx0 && cx <= cx1 && cy >= cy0 && cy <= cy1)
+                {
+                    VisitEntries(c.second.first, c.second.second, f);
+                }
+            }
+            return;
+        }
+        // Look up each cell in the area
+        for (int64_t cx = cx0; cx <= cx1; ++cx)
+        {
+            for (int64_t cy = cy0; cy <= cy1; ++cy)
+            {
+                VisitCell(cx, cy, f);
+            }
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Visit the entities from the cells on the edge of a square ring around a cell.
+    */
+    template < typename F > static void VisitRing(int64_t cx, int64_t cy, int64_t ring, F f)
+    {
+        // The first ring is just the center cell
+        if (ring == 0)
+        {
+            VisitCell(cx, cy, f);
+            return;
+        }
+        // Top and bottom rows
+        for (int64_t x = cx - ring; x <= cx + ring; ++x)
+        {
+            VisitCell(x, cy - ring, f);
+            VisitCell(x, cy + ring, f);
+        }
+        // Left and right columns, without the corners
+        for (int64_t y = cy - ring + 1; y <= cy + ring - 1; ++y)
+        {
+            VisitCell(cx - ring, y, f);
+            VisitCell(cx + ring, y, f);
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Visit the entities within a radius from a position.
+    */
+    template < typename F > static void VisitRadius(const Vector3 & pos, float radius, int32_t world, F f)
+    {
+        Check(pos);
+        // Is the radius usable?
+        if (!std::isfinite(radius))
+        {
+            STHROWF("Invalid {} query radius: {}", Inst::LcName, radius);
+        }
+        Update();
+        const float r2 = radius * radius;
+        VisitCells(pos.x - radius, pos.y - radius, pos.x + radius, pos.y + radius, [&](const Entry & e) {
+            if ((world < 0 || e.mWorld == world) && e.mPos.GetSquaredDistanceTo(pos) <= r2) f(e);
+        });
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the script object of an indexed entity.
+    */
+    static inline const LightObj & ObjectOf(const Entry & e)
+    {
+        return (Inst::CBegin() + e.mID)->mObj;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Collect the entities within a radius from a position into an array.
+    */
+    static Array InRadiusWorld(int32_t world, const Vector3 & pos, SQFloat radius)
+    {
+        const StackGuard sg;
+        // Allocate an empty array on the stack
+        sq_newarray(SqVM(), 0);
+        // Append each entity in range
+        VisitRadius(pos, static_cast< float >(radius), world, [](const Entry & e) {
+            sq_pushobject(SqVM(), ObjectOf(e).GetObj());
+            sq_arrayappend(SqVM(), -2);
+        });
+        // Return the array at the top of the stack
+        return Var< Array >(SqVM(), -1).value;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Collect the entities within a radius from a position into an array.
+    */
+    static Array InRadius(const Vector3 & pos, SQFloat radius)
+    {
+        return InRadiusWorld(-1, pos, radius);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Collect the entities inside a box into an array.
+    */
+    static Array InBoxWorld(int32_t world, const Vector3 & lo, const Vector3 & hi)
+    {
+        Check(lo);
+        Check(hi);
+        Update();
+        const StackGuard sg;
+        // Allocate an empty array on the stack
+        sq_newarray(SqVM(), 0);
+        // Append each entity inside the box
+        VisitCells(lo.x, lo.y, hi.x, hi.y, [&](const Entry & e) {
+            if ((world < 0 || e.mWorld == world) &&
+                e.mPos.x >= lo.x && e.mPos.y >= lo.y && e.mPos.z >= lo.z &&
+                e.mPos.x <= hi.x && e.mPos.y <= hi.y && e.mPos.z <= hi.z)
+            {
+                sq_pushobject(SqVM(), ObjectOf(e).GetObj());
+                sq_arrayappend(SqVM(), -2);
+            }
+        });
+        // Return the array at the top of the stack
+        return Var< Array >(SqVM(), -1).value;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Collect the entities inside a box into an array.
+    */
+    static Array InBox(const Vector3 & lo, const Vector3 & hi)
+    {
+        return InBoxWorld(-1, lo, hi);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Collect the closest entities to a position into an array, sorted by distance.
+    */
+    static Array NearestWorld(int32_t world, const Vector3 & pos, SQInteger k)
+    {
+        Check(pos);
+        Update();
+        s_Found.clear();
+        const auto n = static_cast< size_t >(ClampMin(k, SQInteger(0)));
+        // Remember the entities that could be among the closest
+        auto found = [&](const Entry & e) {
+            if (world < 0 || e.mWorld == world)
+            {
+                s_Found.emplace_back(e.mPos.GetSquaredDistanceTo(pos), static_cast< uint32_t >(&e - s_Entries.data()));
+            }
+        };
+        // Search in growing rings of cells until the closest entities are known
+        const int64_t cx = Coord(pos.x), cy = Coord(pos.y);
+        // Rings beyond this one contain no entities
+        const int64_t last = s_Entries.empty() ? -1 : std::max(std::max(cx - s_X0, s_X1 - cx),
+                                                               std::max(cy - s_Y0, s_Y1 - cy));
+        for (int64_t ring = 0; n > 0 && ring <= last; ++ring)
+        {
+            // Would the cells searched so far outnumber the entities? Just scan the entities then
+            if ((2 * ring + 1) * (2 * ring + 1) > static_cast< int64_t >(s_Entries.size()) + 1)
+            {
+                s_Found.clear();
+                VisitEntries(0, static_cast< uint32_t >(s_Entries.size()), found);
+                break;
+            }
+            VisitRing(cx, cy, ring, found);
+            // Anything beyond this ring is at least this far away
+            const float reach = static_cast< float >(ring) * s_Cell;
+            if (s_Found.size() >= n)
+            {
+                std::nth_element(s_Found.begin(), s_Found.begin() + static_cast< std::ptrdiff_t >(n - 1), s_Found.end());
+                if (s_Found[n - 1].first <= reach * reach) break;
+            }
+        }
+        // Keep only the closest ones, sorted by distance
+        const size_t m = std::min(n, s_Found.size());
+        std::partial_sort(s_Found.begin(), s_Found.begin() + static_cast< std::ptrdiff_t >(m), s_Found.end());
+        const StackGuard sg;
+        // Allocate an empty array on the stack
+        sq_newarray(SqVM(), 0);
+        for (size_t i = 0; i < m; ++i)
+        {
+            sq_pushobject(SqVM(), ObjectOf(s_Entries[s_Found[i].second]).GetObj());
+            sq_arrayappend(SqVM(), -2);
+        }
+        // Return the array at the top of the stack
+        return Var< Array >(SqVM(), -1).value;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Collect the closest entities to a position into an array, sorted by distance.
+    */
+    static Array Nearest(const Vector3 & pos, SQInteger k)
+    {
+        return NearestWorld(-1, pos, k);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Forward the entities within a radius from a position to a callback. Returns the forwarded count.
+    */
+    static SQInteger ForeachInRadiusWorld(int32_t world, const Vector3 & pos, SQFloat radius, Function & func)
+    {
+        ForwardElemFunc< T > fwd(func);
+        bool proceed = true;
+        // The callback may create or destroy entities so work on a copy of the matches
+        std::vector< int32_t > ids;
+        VisitRadius(pos, static_cast< float >(radius), world, [&](const Entry & e) { ids.push_back(e.mID); });
+        for (const int32_t id : ids)
+        {
+            const auto itr = Inst::CBegin() + id;
+            // The entity may have been destroyed by a previous callback
+            if (proceed && VALID_ENTITY(itr->mID))
+            {
+                proceed = fwd(*itr);
+            }
+        }
+        return static_cast< SQInteger >(fwd.mCount);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Forward the entities within a radius from a position to a callback. Returns the forwarded count.
+    */
+    static SQInteger ForeachInRadius(const Vector3 & pos, SQFloat radius, Function & func)
+    {
+        return ForeachInRadiusWorld(-1, pos, radius, func);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Count the entities within a radius from a position.
+    */
+    static SQInteger CountInRadius(const Vector3 & pos, SQFloat radius)
+    {
+        SQInteger n = 0;
+        VisitRadius(pos, static_cast< float >(radius), -1, [&n](const Entry &) { ++n; });
+        return n;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+template < typename T > std::vector< typename Spatial< T >::Entry > Spatial< T >::s_Entries{};
+template < typename T > typename Spatial< T >::Cells Spatial< T >::s_Cells{};
+template < typename T > std::vector< std::pair< float, uint32_t > > Spatial< T >::s_Found{};
+template < typename T > uint32_t Spatial< T >::s_Frame = 0;
+template < typename T > float Spatial< T >::s_Cell = 0;
+template < typename T > bool Spatial< T >::s_Built = false;
+template < typename T > int32_t Spatial< T >::s_X0 = 0;
+template < typename T > int32_t Spatial< T >::s_Y0 = 0;
+template < typename T > int32_t Spatial< T >::s_X1 = 0;
+template < typename T > int32_t Spatial< T >::s_Y1 = 0;
+
 } // Namespace:: Algo
 } // Namespace:: SqMod
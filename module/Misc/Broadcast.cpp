@@ -1,8 +1,15 @@
 // ------------------------------------------------------------------------------------------------
 #include "Core.hpp"
 #include "Base/Color3.hpp"
+#include "Base/Vector3.hpp"
 #include "Entity/Player.hpp"
 
+// ------------------------------------------------------------------------------------------------
+#include <bitset>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
@@ -230,6 +237,348 @@ SQRESULT SqGrabPlayerMessageColor(HSQUIRRELVM vm, int32_t idx, uint32_t & color,
     return SQ_OK;
 }
 
+// ------------------------------------------------------------------------------------------------
+SQMOD_DECL_TYPENAME(SqBroadcastGroup, _SC("SqBroadcastGroup"))
+
+/* ------------------------------------------------------------------------------------------------
+ * Precomputed set of players that can receive broadcasts. Instances are chained so that players can
+ * be removed from every group when they are destroyed.
+*/
+struct BroadcastGroup : public SqChainedInstances< BroadcastGroup >
+{
+    /* --------------------------------------------------------------------------------------------
+     * Players that are part of this group.
+    */
+    std::bitset< SQMOD_PLAYER_POOL > mPlayers{};
+
+    /* --------------------------------------------------------------------------------------------
+     * Default constructor.
+    */
+    BroadcastGroup()
+    {
+        ChainInstance(); // Remember this instance
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Copy constructor (disabled).
+    */
+    BroadcastGroup(const BroadcastGroup &) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move constructor (disabled).
+    */
+    BroadcastGroup(BroadcastGroup &&) noexcept = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Destructor.
+    */
+    ~BroadcastGroup()
+    {
+        UnchainInstance(); // Forget about this instance
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Assignment operator (disabled).
+    */
+    BroadcastGroup & operator = (const BroadcastGroup &) = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Move assignment (disabled).
+    */
+    BroadcastGroup & operator = (BroadcastGroup &&) noexcept = delete;
+
+    /* --------------------------------------------------------------------------------------------
+     * Include a player in the group.
+    */
+    BroadcastGroup & Add(CPlayer & player)
+    {
+        mPlayers.set(static_cast< size_t >(player.GetID()));
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Exclude a player from the group.
+    */
+    BroadcastGroup & Remove(CPlayer & player)
+    {
+        mPlayers.reset(static_cast< size_t >(player.GetID()));
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * See if a player is part of the group.
+    */
+    SQMOD_NODISCARD bool Has(CPlayer & player) const
+    {
+        return mPlayers.test(static_cast< size_t >(player.GetID()));
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Exclude all players from the group.
+    */
+    BroadcastGroup & Clear()
+    {
+        mPlayers.reset();
+        return *this;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of players in the group.
+    */
+    SQMOD_NODISCARD SQInteger Count() const
+    {
+        return static_cast< SQInteger >(mPlayers.count());
+    }
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Selection of players that should receive a broadcast.
+*/
+struct BroadcastFilter
+{
+    // --------------------------------------------------------------------------------------------
+    enum { All = 0, Team, World, Radius, Group };
+    // --------------------------------------------------------------------------------------------
+    int                     mType{All}; // Type of selection.
+    int32_t                 mValue{0}; // Team or world identifier.
+    Vector3                 mOrigin{}; // Center of the radius selection.
+    float                   mRadius{0}; // Squared radius of the radius selection.
+    const BroadcastGroup *  mGroup{nullptr}; // Group of the group selection.
+
+    /* --------------------------------------------------------------------------------------------
+     * See if the player with the specified identifier should receive the broadcast.
+    */
+    SQMOD_NODISCARD bool operator () (int32_t id) const
+    {
+        switch (mType)
+        {
+            case Team: return (_Func->GetPlayerTeam(id) == mValue);
+            case World: return (_Func->GetPlayerWorld(id) == mValue);
+            case Radius:
+            {
+                Vector3 pos;
+                _Func->GetPlayerPosition(id, &pos.x, &pos.y, &pos.z);
+                return (pos.GetSquaredDistanceTo(mOrigin) <= mRadius);
+            }
+            case Group: return mGroup->mPlayers.test(static_cast< size_t >(id));
+            default: return true;
+        }
+    }
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Formats the broadcast text once for every distinct prefix/postfix combination.
+*/
+struct BroadcastText
+{
+    /* --------------------------------------------------------------------------------------------
+     * Previously formatted variant of the text.
+    */
+    struct Variant
+    {
+        const String *  mPrefix; // Prefix used by the variant.
+        const String *  mMiddle; // Secondary prefix used by the variant.
+        const String *  mPostfix; // Postfix used by the variant.
+        String          mText; // The resulted text.
+    };
+
+    // --------------------------------------------------------------------------------------------
+    const SQChar *                          mMsg; // The message shared by all variants.
+    size_t                                  mLen; // The length of the shared message.
+    std::vector< Variant >                  mVariants; // Variants formatted so far.
+    std::unordered_multimap< size_t, size_t > mIndex; // Variants by the hash of their affixes.
+
+    /* --------------------------------------------------------------------------------------------
+     * Base constructor.
+    */
+    BroadcastText(const SQChar * msg, SQInteger len)
+        : mMsg(msg), mLen(static_cast< size_t >(len)), mVariants(), mIndex()
+    {
+        mVariants.reserve(4);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the text surrounded by the specified strings. Formats it only the first time.
+    */
+    const SQChar * Get(const String & prefix, const String & middle, const String & postfix)
+    {
+        const std::hash< String > hash;
+        // Combine the hashes of the affixes
+        size_t h = hash(prefix);
+        h ^= hash(middle) + 0x9E3779B9u + (h << 6) + (h >> 2);
+        h ^= hash(postfix) + 0x9E3779B9u + (h << 6) + (h >> 2);
+        // Was this combination formatted already? Players usually share the same values
+        for (auto range = mIndex.equal_range(h); range.first != range.second; ++range.first)
+        {
+            const Variant & v = mVariants[range.first->second];
+            if (*v.mPrefix == prefix && *v.mMiddle == middle && *v.mPostfix == postfix)
+            {
+                return v.mText.c_str();
+            }
+        }
+        // Format the new combination
+        String text;
+        text.reserve(prefix.size() + middle.size() + mLen + postfix.size());
+        text.append(prefix).append(middle).append(mMsg, mLen).append(postfix);
+        // Remember it for the remaining players
+        mIndex.emplace(h, mVariants.size());
+        mVariants.push_back(Variant{&prefix, &middle, &postfix, std::move(text)});
+        // Return the formatted text
+        return mVariants.back().mText.c_str();
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+void CleanupBroadcastGroups(int32_t id)
+{
+    for (BroadcastGroup * inst = BroadcastGroup::sHead; inst && inst->mNext != BroadcastGroup::sHead; inst = inst->mNext)
+    {
+        inst->mPlayers.reset(static_cast< size_t >(id));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+static const String s_EmptyAffix{}; // Used when a message has no prefix or postfix.
+
+/* ------------------------------------------------------------------------------------------------
+ * Outcome of a single broadcast.
+*/
+struct BroadcastOutcome
+{
+    // --------------------------------------------------------------------------------------------
+    typedef std::vector< std::pair< int32_t, vcmpError > > Failures;
+    // --------------------------------------------------------------------------------------------
+    uint32_t    mCount{0}; // Players that received the broadcast.
+    Failures    mFailures{}; // Players that did not receive the broadcast and the reason.
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Send a broadcast to each selected player. Failures are recorded without interrupting the loop.
+*/
+template < class F > static BroadcastOutcome BroadcastEach(const BroadcastFilter & filter, F && send)
+{
+    BroadcastOutcome out;
+    // Process each entity in the pool
+    for (const auto & p : Core::Get().GetPlayers())
+    {
+        // Is this player instance valid and selected?
+        if (VALID_ENTITYEX(p.mID, SQMOD_PLAYER_POOL) && p.mInst != nullptr && filter(p.mID))
+        {
+            const vcmpError result = send(p.mID, *p.mInst);
+            // Check the result
+            if (result != vcmpErrorNone)
+            {
+                out.mFailures.emplace_back(p.mID, result);
+            }
+            else
+            {
+                ++out.mCount; // Add this player to the count
+            }
+        }
+    }
+    // Return the number of players that received the broadcast and the failures
+    return out;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Push a table with the number of players that received a broadcast and the ones that did not.
+ * The result has the form {Sent = count, Failed = [{Id = player, Error = code}, ...]}.
+*/
+static SQRESULT BroadcastResult(HSQUIRRELVM vm, const BroadcastOutcome & out)
+{
+    sq_newtableex(vm, 2);
+    // Number of players that received the broadcast
+    sq_pushstring(vm, _SC("Sent"), 4);
+    sq_pushinteger(vm, static_cast< SQInteger >(out.mCount));
+    sq_newslot(vm, -3, SQFalse);
+    // Players that did not receive the broadcast
+    sq_pushstring(vm, _SC("Failed"), 6);
+    sq_newarrayex(vm, static_cast< SQInteger >(out.mFailures.size()));
+    for (const auto & f : out.mFailures)
+    {
+        sq_newtableex(vm, 2);
+        sq_pushstring(vm, _SC("Id"), 2);
+        sq_pushinteger(vm, f.first);
+        sq_newslot(vm, -3, SQFalse);
+        sq_pushstring(vm, _SC("Error"), 5);
+        sq_pushinteger(vm, static_cast< SQInteger >(f.second));
+        sq_newslot(vm, -3, SQFalse);
+        sq_arrayappend(vm, -2);
+    }
+    sq_newslot(vm, -3, SQFalse);
+    // Specify that this function returned a value
+    return 1;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Kind of broadcast performed by SqBroadcastTo().
+*/
+enum BroadcastKind
+{
+    BroadcastMsg = 0, // Message with explicit color.
+    BroadcastMessage, // Message with the color of each player.
+    BroadcastAnnounce // Announcement with the style of each player.
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Send a broadcast to the selected players. The color (if any) and message start at idx.
+*/
+template < int K > static SQInteger SqBroadcastTo(HSQUIRRELVM vm, int32_t idx, const BroadcastFilter & filter)
+{
+    const auto top = static_cast< int32_t >(sq_gettop(vm));
+    // The index where the message should start
+    int32_t msg_idx = idx;
+    // The message color
+    uint32_t color = 0;
+    // Do we need to extract a color?
+    if (K == BroadcastMsg)
+    {
+        // Was the message color specified?
+        if (top < idx)
+        {
+            return sq_throwerror(vm, "Missing message color");
+        }
+        // Was the message value specified?
+        else if (top <= idx)
+        {
+            return sq_throwerror(vm, "Missing message value");
+        }
+        // Attempt to identify and extract the color
+        const SQRESULT res = SqGrabPlayerMessageColor(vm, idx, color, msg_idx);
+        // Did we fail to identify a color?
+        if (SQ_FAILED(res))
+        {
+            return res; // Propagate the error!
+        }
+    }
+    // Was the message value specified?
+    else if (top < idx)
+    {
+        return sq_throwerror(vm, K == BroadcastAnnounce ? "Missing announcement value" : "Missing message value");
+    }
+    // Attempt to generate the string value
+    StackStrF val(vm, msg_idx);
+    // Have we failed to retrieve the string?
+    if (SQ_FAILED(val.Proc(true)))
+    {
+        return val.mRes; // Propagate the error!
+    }
+    // Format each variant of the text only once
+    BroadcastText text(val.mPtr, val.mLen);
+    // Send the resulted text to each selected player
+    const BroadcastOutcome out = BroadcastEach(filter, [&](int32_t id, const CPlayer & player) {
+        if (K == BroadcastAnnounce)
+        {
+            return _Func->SendGameMessage(id, player.mAnnounceStyle, "%s",
+                                        text.Get(player.mAnnouncePrefix, s_EmptyAffix, player.mAnnouncePostfix));
+        }
+        return _Func->SendClientMessage(id, K == BroadcastMsg ? color : player.mMessageColor, "%s",
+                                        text.Get(player.mMessagePrefix, s_EmptyAffix, player.mMessagePostfix));
+    });
+    // Report the count and the failures
+    return BroadcastResult(vm, out);
+}
+
 // ------------------------------------------------------------------------------------------------
 static SQInteger SqBroadcastMsg(HSQUIRRELVM vm)
 {
@@ -266,42 +615,33 @@ static SQInteger SqBroadcastMsg(HSQUIRRELVM vm)
         return val.mRes; // Propagate the error!
     }
 
-    // Obtain the ends of the entity pool
-    auto itr = Core::Get().GetPlayers().cbegin();
-    auto end = Core::Get().GetPlayers().cend();
-    // The number of players that the message was sent to
-    uint32_t count = 0;
-    // Currently processed player
-    CPlayer * player;
+    // Format each variant of the message only once
+    BroadcastText text(val.mPtr, val.mLen);
+    // Send the resulted message to each player
+    const BroadcastOutcome out = BroadcastEach(BroadcastFilter{}, [&](int32_t id, const CPlayer & player) {
+        return _Func->SendClientMessage(id, color, "%s",
+                                        text.Get(player.mMessagePrefix, s_EmptyAffix, player.mMessagePostfix));
+    });
+    // Report the count and the failures
+    return BroadcastResult(vm, out);
+}
 
-    // Process each entity in the pool
-    for (; itr != end; ++itr)
-    {
-        // Grab the player instance
-        player = itr->mInst;
-        // Is this player instance valid?
-        if (VALID_ENTITYEX(itr->mID, SQMOD_PLAYER_POOL) && player != nullptr)
+/* ------------------------------------------------------------------------------------------------
+ * Send a message with a prefix from the player prefix list to each player.
+*/
+static BroadcastOutcome BroadcastPrefixed(BroadcastText & text, uint32_t index, const uint32_t * color)
+{
+    return BroadcastEach(BroadcastFilter{}, [&](int32_t id, const CPlayer & player) {
+        // Send the resulted message string
+        if (player.mLimitPrefixPostfixMessage)
         {
-            // Send the resulted message string
-            const vcmpError result = _Func->SendClientMessage(itr->mID, color,
-                                                        "%s%s%s",
-                                                        player->mMessagePrefix.c_str(),
-                                                        val.mPtr,
-                                                        player->mMessagePostfix.c_str());
-            // Check the result
-            if (result == vcmpErrorTooLargeInput)
-            {
-                return sq_throwerrorf(vm, "Client message too big [%s]", player->GetTag().c_str());
-            }
-            // Add this player to the count
-            ++count;
+            return _Func->SendClientMessage(id, color ? *color : player.mMessageColor, "%s",
+                                            text.Get(s_EmptyAffix, player.mMessagePrefixes[index], s_EmptyAffix));
         }
-    }
-
-    // Push the count count on the stack
-    sq_pushinteger(vm, count);
-    // Specify that this function returned a value
-    return 1;
+        return _Func->SendClientMessage(id, color ? *color : player.mMessageColor, "%s",
+                                        text.Get(player.mMessagePrefix, player.mMessagePrefixes[index],
+                                                 player.mMessagePostfix));
+    });
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -346,50 +686,12 @@ static SQInteger SqBroadcastMsgP(HSQUIRRELVM vm)
         return val.mRes; // Propagate the error!
     }
 
-    vcmpError result;
-    // Obtain the ends of the entity pool
-    auto itr = Core::Get().GetPlayers().cbegin();
-    auto end = Core::Get().GetPlayers().cend();
-    // The number of players that the message was sent to
-    uint32_t count = 0;
-    // Currently processed player
-    CPlayer * player;
-
-    // Process each entity in the pool
-    for (; itr != end; ++itr)
-    {
-        // Grab the player instance
-        player = itr->mInst;
-        // Is this player instance valid?
-        if (VALID_ENTITYEX(itr->mID, SQMOD_PLAYER_POOL) && player != nullptr)
-        {
-            // Send the resulted message string
-            if (player->mLimitPrefixPostfixMessage)
-            {
-                result = _Func->SendClientMessage(itr->mID, player->mMessageColor, "%s%s",
-                                                    player->mMessagePrefixes[index].c_str(), val.mPtr);
-            }
-            else
-            {
-                result = _Func->SendClientMessage(itr->mID, player->mMessageColor, "%s%s%s%s",
-                                                    player->mMessagePrefix.c_str(),
-                                                    player->mMessagePrefixes[index].c_str(), val.mPtr,
-                                                    player->mMessagePostfix.c_str());
-            }
-            // Check the result
-            if (result == vcmpErrorTooLargeInput)
-            {
-                return sq_throwerrorf(vm, "Client message too big [%s]", player->GetTag().c_str());
-            }
-            // Add this player to the count
-            ++count;
-        }
-    }
-
-    // Push the count count on the stack
-    sq_pushinteger(vm, count);
-    // Specify that this function returned a value
-    return 1;
+    // Format each variant of the message only once
+    BroadcastText text(val.mPtr, val.mLen);
+    // Send the resulted message to each player
+    const BroadcastOutcome out = BroadcastPrefixed(text, index, nullptr);
+    // Report the count and the failures
+    return BroadcastResult(vm, out);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -451,50 +753,12 @@ static SQInteger SqBroadcastMsgEx(HSQUIRRELVM vm)
         return val.mRes; // Propagate the error!
     }
 
-    vcmpError result;
-    // Obtain the ends of the entity pool
-    auto itr = Core::Get().GetPlayers().cbegin();
-    auto end = Core::Get().GetPlayers().cend();
-    // The number of players that the message was sent to
-    uint32_t count = 0;
-    // Currently processed player
-    CPlayer * player;
-
-    // Process each entity in the pool
-    for (; itr != end; ++itr)
-    {
-        // Grab the player instance
-        player = itr->mInst;
-        // Is this player instance valid?
-        if (VALID_ENTITYEX(itr->mID, SQMOD_PLAYER_POOL) && player != nullptr)
-        {
-            // Send the resulted message string
-            if (player->mLimitPrefixPostfixMessage)
-            {
-                result = _Func->SendClientMessage(itr->mID, color, "%s%s",
-                                                    player->mMessagePrefixes[index].c_str(), val.mPtr);
-            }
-            else
-            {
-                result = _Func->SendClientMessage(itr->mID, color, "%s%s%s%s",
-                                                    player->mMessagePrefix.c_str(),
-                                                    player->mMessagePrefixes[index].c_str(), val.mPtr,
-                                                    player->mMessagePostfix.c_str());
-            }
-            // Check the result
-            if (result == vcmpErrorTooLargeInput)
-            {
-                return sq_throwerrorf(vm, "Client message too big [%s]", player->GetTag().c_str());
-            }
-            // Add this player to the count
-            ++count;
-        }
-    }
-
-    // Push the count count on the stack
-    sq_pushinteger(vm, count);
-    // Specify that this function returned a value
-    return 1;
+    // Format each variant of the message only once
+    BroadcastText text(val.mPtr, val.mLen);
+    // Send the resulted message to each player
+    const BroadcastOutcome out = BroadcastPrefixed(text, index, &color);
+    // Report the count and the failures
+    return BroadcastResult(vm, out);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -515,42 +779,15 @@ static SQInteger SqBroadcastMessage(HSQUIRRELVM vm)
         return val.mRes; // Propagate the error!
     }
 
-    // Obtain the ends of the entity pool
-    auto itr = Core::Get().GetPlayers().cbegin();
-    auto end = Core::Get().GetPlayers().cend();
-    // The number of players that the message was sent to
-    uint32_t count = 0;
-    // Currently processed player
-    CPlayer * player;
-
-    // Process each entity in the pool
-    for (; itr != end; ++itr)
-    {
-        // Grab the player instance
-        player = itr->mInst;
-        // Is this player instance valid?
-        if (VALID_ENTITYEX(itr->mID, SQMOD_PLAYER_POOL) && player != nullptr)
-        {
-            // Send the resulted message string
-            const vcmpError result = _Func->SendClientMessage(itr->mID, player->mMessageColor,
-                                                                "%s%s%s",
-                                                                player->mMessagePrefix.c_str(),
-                                                                val.mPtr,
-                                                                player->mMessagePostfix.c_str());
-            // Check the result
-            if (result == vcmpErrorTooLargeInput)
-            {
-                return sq_throwerrorf(vm, "Client message too big [%s]", player->GetTag().c_str());
-            }
-            // Add this player to the count
-            ++count;
-        }
-    }
-
-    // Push the count count on the stack
-    sq_pushinteger(vm, count);
-    // Specify that this function returned a value
-    return 1;
+    // Format each variant of the message only once
+    BroadcastText text(val.mPtr, val.mLen);
+    // Send the resulted message to each player
+    const BroadcastOutcome out = BroadcastEach(BroadcastFilter{}, [&](int32_t id, const CPlayer & player) {
+        return _Func->SendClientMessage(id, player.mMessageColor, "%s",
+                                        text.Get(player.mMessagePrefix, s_EmptyAffix, player.mMessagePostfix));
+    });
+    // Report the count and the failures
+    return BroadcastResult(vm, out);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -571,47 +808,15 @@ static SQInteger SqBroadcastAnnounce(HSQUIRRELVM vm)
         return val.mRes; // Propagate the error!
     }
 
-    // Obtain the ends of the entity pool
-    auto itr = Core::Get().GetPlayers().cbegin();
-    auto end = Core::Get().GetPlayers().cend();
-    // The number of players that the message was sent to
-    uint32_t count = 0;
-    // Currently processed player
-    CPlayer * player;
-
-    // Process each entity in the pool
-    for (; itr != end; ++itr)
-    {
-        // Grab the player instance
-        player = itr->mInst;
-        // Is this player instance valid?
-        if (VALID_ENTITYEX(itr->mID, SQMOD_PLAYER_POOL) && player != nullptr)
-        {
-            // Send the resulted announcement string
-            const vcmpError result = _Func->SendGameMessage(itr->mID, player->mAnnounceStyle,
-                                                            "%s%s%s",
-                                                            player->mAnnouncePrefix.c_str(),
-                                                            val.mPtr,
-                                                            player->mAnnouncePostfix.c_str());
-            // Validate the result
-            if (result == vcmpErrorArgumentOutOfBounds)
-            {
-                return sq_throwerrorf(vm, "Invalid announcement style %d [%s]",
-                                                player->mAnnounceStyle, player->GetTag().c_str());
-            }
-            else if (result == vcmpErrorTooLargeInput)
-            {
-                return sq_throwerrorf(vm, "Game message too big [%s]", player->GetTag().c_str());
-            }
-            // Add this player to the count
-            ++count;
-        }
-    }
-
-    // Push the count count on the stack
-    sq_pushinteger(vm, count);
-    // Specify that this function returned a value
-    return 1;
+    // Format each variant of the announcement only once
+    BroadcastText text(val.mPtr, val.mLen);
+    // Send the resulted announcement to each player
+    const BroadcastOutcome out = BroadcastEach(BroadcastFilter{}, [&](int32_t id, const CPlayer & player) {
+        return _Func->SendGameMessage(id, player.mAnnounceStyle, "%s",
+                                        text.Get(player.mAnnouncePrefix, s_EmptyAffix, player.mAnnouncePostfix));
+    });
+    // Report the count and the failures
+    return BroadcastResult(vm, out);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -648,47 +853,116 @@ static SQInteger SqBroadcastAnnounceEx(HSQUIRRELVM vm)
         return val.mRes; // Propagate the error!
     }
 
-    // Obtain the ends of the entity pool
-    auto itr = Core::Get().GetPlayers().cbegin();
-    auto end = Core::Get().GetPlayers().cend();
-    // The number of players that the message was sent to
-    uint32_t count = 0;
-    // Currently processed player
-    CPlayer * player;
+    // Format each variant of the announcement only once
+    BroadcastText text(val.mPtr, val.mLen);
+    // Send the resulted announcement to each player
+    const BroadcastOutcome out = BroadcastEach(BroadcastFilter{}, [&](int32_t id, const CPlayer & player) {
+        return _Func->SendGameMessage(id, style, "%s",
+                                        text.Get(player.mAnnouncePrefix, s_EmptyAffix, player.mAnnouncePostfix));
+    });
+    // Report the count and the failures
+    return BroadcastResult(vm, out);
+}
 
-    // Process each entity in the pool
-    for (; itr != end; ++itr)
+// ------------------------------------------------------------------------------------------------
+template < int K > static SQInteger SqBroadcastTeam(HSQUIRRELVM vm)
+{
+    // Was the team identifier specified?
+    if (sq_gettop(vm) <= 1)
     {
-        // Grab the player instance
-        player = itr->mInst;
-        // Is this player instance valid?
-        if (VALID_ENTITYEX(itr->mID, SQMOD_PLAYER_POOL) && player != nullptr)
-        {
-            // Send the resulted announcement string
-            const vcmpError result = _Func->SendGameMessage(itr->mID, style,
-                                                            "%s%s%s",
-                                                            player->mAnnouncePrefix.c_str(),
-                                                            val.mPtr,
-                                                            player->mAnnouncePostfix.c_str());
-            // Validate the result
-            if (result == vcmpErrorArgumentOutOfBounds)
-            {
-                return sq_throwerrorf(vm, "Invalid announcement style %d [%s]",
-                                                style, player->GetTag().c_str());
-            }
-            else if (result == vcmpErrorTooLargeInput)
-            {
-                return sq_throwerrorf(vm, "Game message too big [%s]", player->GetTag().c_str());
-            }
-            // Add this player to the count
-            ++count;
-        }
+        return sq_throwerror(vm, "Missing team identifier");
+    }
+    BroadcastFilter filter;
+    filter.mType = BroadcastFilter::Team;
+    // Attempt to extract the argument values
+    try
+    {
+        filter.mValue = Var< int32_t >(vm, 2).value;
     }
+    catch (const std::exception & e)
+    {
+        return sq_throwerror(vm, e.what());
+    }
+    // Forward the call to the actual implementation
+    return SqBroadcastTo< K >(vm, 3, filter);
+}
 
-    // Push the count count on the stack
-    sq_pushinteger(vm, count);
-    // Specify that this function returned a value
-    return 1;
+// ------------------------------------------------------------------------------------------------
+template < int K > static SQInteger SqBroadcastWorld(HSQUIRRELVM vm)
+{
+    // Was the world identifier specified?
+    if (sq_gettop(vm) <= 1)
+    {
+        return sq_throwerror(vm, "Missing world identifier");
+    }
+    BroadcastFilter filter;
+    filter.mType = BroadcastFilter::World;
+    // Attempt to extract the argument values
+    try
+    {
+        filter.mValue = Var< int32_t >(vm, 2).value;
+    }
+    catch (const std::exception & e)
+    {
+        return sq_throwerror(vm, e.what());
+    }
+    // Forward the call to the actual implementation
+    return SqBroadcastTo< K >(vm, 3, filter);
+}
+
+// ------------------------------------------------------------------------------------------------
+template < int K > static SQInteger SqBroadcastRadius(HSQUIRRELVM vm)
+{
+    const auto top = static_cast< int32_t >(sq_gettop(vm));
+    // Was the origin specified?
+    if (top <= 1)
+    {
+        return sq_throwerror(vm, "Missing origin position");
+    }
+    // Was the radius specified?
+    else if (top <= 2)
+    {
+        return sq_throwerror(vm, "Missing radius value");
+    }
+    BroadcastFilter filter;
+    filter.mType = BroadcastFilter::Radius;
+    // Attempt to extract the argument values
+    try
+    {
+        filter.mOrigin = Var< const Vector3 & >(vm, 2).value;
+        filter.mRadius = Var< float >(vm, 3).value;
+    }
+    catch (const std::exception & e)
+    {
+        return sq_throwerror(vm, e.what());
+    }
+    // Compare against the squared distance
+    filter.mRadius *= filter.mRadius;
+    // Forward the call to the actual implementation
+    return SqBroadcastTo< K >(vm, 4, filter);
+}
+
+// ------------------------------------------------------------------------------------------------
+template < int K > static SQInteger SqBroadcastGroupTo(HSQUIRRELVM vm)
+{
+    BroadcastFilter filter;
+    filter.mType = BroadcastFilter::Group;
+    // Attempt to extract the group instance
+    try
+    {
+        filter.mGroup = Var< const BroadcastGroup * >(vm, 1).value;
+    }
+    catch (const std::exception & e)
+    {
+        return sq_throwerror(vm, e.what());
+    }
+    // Do we have a valid group?
+    if (filter.mGroup == nullptr)
+    {
+        return sq_throwerror(vm, "Invalid broadcast group instance");
+    }
+    // Forward the call to the actual implementation
+    return SqBroadcastTo< K >(vm, 2, filter);
 }
 
 // ================================================================================================
@@ -696,6 +970,24 @@ void Register_Broadcast(HSQUIRRELVM vm)
 {
     Table bns(vm);
 
+    bns.Bind(_SC("Group"),
+        Class< BroadcastGroup, NoCopy< BroadcastGroup > >(vm, SqBroadcastGroup::Str)
+        // Constructors
+        .Ctor()
+        // Meta-methods
+        .SquirrelFunc(_SC("_typename"), &SqBroadcastGroup::Fn)
+        // Properties
+        .Prop(_SC("Count"), &BroadcastGroup::Count)
+        // Member Methods
+        .Func(_SC("Add"), &BroadcastGroup::Add)
+        .Func(_SC("Remove"), &BroadcastGroup::Remove)
+        .Func(_SC("Has"), &BroadcastGroup::Has)
+        .Func(_SC("Clear"), &BroadcastGroup::Clear)
+        .SquirrelFunc(_SC("Msg"), &SqBroadcastGroupTo< BroadcastMsg >)
+        .SquirrelFunc(_SC("Message"), &SqBroadcastGroupTo< BroadcastMessage >)
+        .SquirrelFunc(_SC("Announce"), &SqBroadcastGroupTo< BroadcastAnnounce >)
+    );
+
     bns
     .SquirrelFunc(_SC("Msg"), &SqBroadcastMsg)
     .SquirrelFunc(_SC("MsgP"), &SqBroadcastMsgP)
@@ -704,7 +996,16 @@ void Register_Broadcast(HSQUIRRELVM vm)
     .SquirrelFunc(_SC("Announce"), &SqBroadcastAnnounce)
     .SquirrelFunc(_SC("AnnounceEx"), &SqBroadcastAnnounceEx)
     .SquirrelFunc(_SC("Text"), &SqBroadcastAnnounce)
-    .SquirrelFunc(_SC("TextEx"), &SqBroadcastAnnounceEx);
+    .SquirrelFunc(_SC("TextEx"), &SqBroadcastAnnounceEx)
+    .SquirrelFunc(_SC("MsgTeam"), &SqBroadcastTeam< BroadcastMsg >)
+    .SquirrelFunc(_SC("MessageTeam"), &SqBroadcastTeam< BroadcastMessage >)
+    .SquirrelFunc(_SC("AnnounceTeam"), &SqBroadcastTeam< BroadcastAnnounce >)
+    .SquirrelFunc(_SC("MsgWorld"), &SqBroadcastWorld< BroadcastMsg >)
+    .SquirrelFunc(_SC("MessageWorld"), &SqBroadcastWorld< BroadcastMessage >)
+    .SquirrelFunc(_SC("AnnounceWorld"), &SqBroadcastWorld< BroadcastAnnounce >)
+    .SquirrelFunc(_SC("MsgRadius"), &SqBroadcastRadius< BroadcastMsg >)
+    .SquirrelFunc(_SC("MessageRadius"), &SqBroadcastRadius< BroadcastMessage >)
+    .SquirrelFunc(_SC("AnnounceRadius"), &SqBroadcastRadius< BroadcastAnnounce >);
 
     RootTable(vm).Bind(_SC("SqBroadcast"), bns);
 }
@@ -262,6 +262,21 @@ static const EnumElement g_EntityPoolEnum[] = {
     {_SC("Max"),            vcmpEntityPoolCheckPoint}
 };
 
+// ------------------------------------------------------------------------------------------------
+static const EnumElement g_FrameStageEnum[] = {
+    {_SC("Event"),          FS_EVENT},
+    {_SC("Routines"),       FS_ROUTINES},
+    {_SC("Tasks"),          FS_TASKS},
+    {_SC("Loot"),           FS_LOOT},
+    {_SC("Threads"),        FS_THREADS},
+    {_SC("Net"),            FS_NET},
+    {_SC("DPP"),            FS_DPP},
+    {_SC("Logger"),         FS_LOGGER},
+    {_SC("Reload"),         FS_RELOAD},
+    {_SC("Entities"),       FS_ENTITIES},
+    {_SC("Frame"),          FS_FRAME}
+};
+
 // ------------------------------------------------------------------------------------------------
 static const EnumElement g_PlayerUpdateEnum[] = {
     {_SC("Unknown"),        SQMOD_UNKNOWN},
@@ -1242,6 +1257,7 @@ static const EnumElements g_EnumList[] = {
     {_SC("SqDestroy"),                  g_DestroyEnum},
     {_SC("SqServerError"),              g_ServerErrorEnum},
     {_SC("SqEntityPool"),               g_EntityPoolEnum},
+    {_SC("SqFrameStage"),               g_FrameStageEnum},
     {_SC("SqPlayerUpdate"),             g_PlayerUpdateEnum},
     {_SC("SqVehicleUpdate"),            g_VehicleUpdateEnum},
     {_SC("SqPlayerVehicle"),            g_PlayerVehicleEnum},
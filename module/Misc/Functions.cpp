@@ -5,6 +5,9 @@
 #include "Base/Vector2.hpp"
 #include "Entity/Player.hpp"
 
+// ------------------------------------------------------------------------------------------------
+#include <cmath>
+
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
@@ -44,6 +47,105 @@ static const District g_Districts[] = {
     {-1208.21f,     -241.467f,  -578.289f,  412.66f,    _SC("Little Haiti")}
 };
 
+/* ------------------------------------------------------------------------------------------------
+ * Uniform grid over the district boundaries. Each cell knows which districts overlap it.
+*/
+struct DistrictIndex
+{
+    // --------------------------------------------------------------------------------------------
+    static constexpr size_t COUNT = sizeof(g_Districts) / sizeof(District); // Number of districts.
+    static constexpr int32_t CELLS = 32; // Number of cells on each axis.
+    // --------------------------------------------------------------------------------------------
+    static_assert(COUNT <= 16, "District mask cannot hold all districts");
+    // --------------------------------------------------------------------------------------------
+    SQFloat     mMinX, mMinY, mMaxX, mMaxY; // Boundaries of all districts combined.
+    SQFloat     mCellW, mCellH; // Size of a single cell.
+    uint16_t    mMask[CELLS][CELLS]; // Districts overlapping each cell, in the order they are checked.
+
+    /* --------------------------------------------------------------------------------------------
+     * Build the index from the known districts.
+    */
+    DistrictIndex() noexcept
+        : mMinX(g_Districts[0].mMinX), mMinY(g_Districts[0].mMinY)
+        , mMaxX(g_Districts[0].mMaxX), mMaxY(g_Districts[0].mMaxY)
+        , mCellW(0), mCellH(0), mMask{}
+    {
+        // Find the boundaries of all districts combined
+        for (const District & d : g_Districts)
+        {
+            mMinX = std::min(mMinX, static_cast< SQFloat >(d.mMinX));
+            mMinY = std::min(mMinY, static_cast< SQFloat >(d.mMinY));
+            mMaxX = std::max(mMaxX, static_cast< SQFloat >(d.mMaxX));
+            mMaxY = std::max(mMaxY, static_cast< SQFloat >(d.mMaxY));
+        }
+        // Compute the size of a cell
+        mCellW = (mMaxX - mMinX) / CELLS;
+        mCellH = (mMaxY - mMinY) / CELLS;
+        // Mark the cells covered by each district
+        for (size_t n = 0; n < COUNT; ++n)
+        {
+            const District & d = g_Districts[n];
+            // Cells are computed the same way as for a point so that inner points always land in them
+            for (int32_t x = CellX(d.mMinX), x1 = CellX(d.mMaxX); x <= x1; ++x)
+            {
+                for (int32_t y = CellY(d.mMinY), y1 = CellY(d.mMaxY); y <= y1; ++y)
+                {
+                    mMask[x][y] |= static_cast< uint16_t >(1u << n);
+                }
+            }
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the column of the cell containing the specified coordinate.
+    */
+    SQMOD_NODISCARD int32_t CellX(SQFloat x) const noexcept
+    {
+        return Clamp(static_cast< int32_t >((x - mMinX) / mCellW), 0, CELLS - 1);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the row of the cell containing the specified coordinate.
+    */
+    SQMOD_NODISCARD int32_t CellY(SQFloat y) const noexcept
+    {
+        return Clamp(static_cast< int32_t >((y - mMinY) / mCellH), 0, CELLS - 1);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Find the first district that contains the specified point.
+    */
+    SQMOD_NODISCARD const District * Find(SQFloat x, SQFloat y) const noexcept
+    {
+        // Not a point on the map? (NaN fails every comparison below and must not reach the cell lookup)
+        if (!std::isfinite(x) || !std::isfinite(y))
+        {
+            return nullptr;
+        }
+        // Is the point outside of every district?
+        else if (x < mMinX || y < mMinY || x > mMaxX || y > mMaxY)
+        {
+            return nullptr;
+        }
+        // Only look at the districts that overlap the cell containing the point
+        for (uint32_t m = mMask[CellX(x)][CellY(y)], n = 0; m != 0; m >>= 1u, ++n)
+        {
+            // Grab the district
+            const District & d = g_Districts[n];
+            // Check for point intersection taking into account floating point comparison issues
+            if ((m & 1u) && EpsGt(x, d.mMinX) && EpsGt(y, d.mMinY) && EpsLt(x, d.mMaxX) && EpsLt(y, d.mMaxY))
+            {
+                return &d; // The specified point is within the bounds of this district
+            }
+        }
+        // Not a particular district!
+        return nullptr;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+static const DistrictIndex g_DistrictIndex{};
+
 // ------------------------------------------------------------------------------------------------
 static String CS_Keycode_Names[] = {"", /* index 0 is not used */ // NOLINT(cert-err58-cpp)
 "Left Button **",    "Right Button **",   "Break",             "Middle Button **",  "X Button 1 **",
@@ -817,18 +919,9 @@ const SQChar * GetDistrictName(const Vector2 & point)
 const SQChar * GetDistrictNameEx(SQFloat x, SQFloat y)
 {
     // Attempt to see if the specified point is within one of the known districts
-    for (uint32_t n = 0; n < (sizeof(g_Districts) / sizeof(District)); ++n) // NOLINT(modernize-loop-convert)
-    {
-        // Grab the district
-        const District & d = g_Districts[n];
-        // Check for point intersection taking into account floating point comparison issues
-        if (EpsGt(x, d.mMinX) && EpsGt(y, d.mMinY) && EpsLt(x, d.mMaxX) && EpsLt(y, d.mMaxY))
-        {
-            return d.mName; // The specified point is within the bounds of this district
-        }
-    }
-    // Not a particular district!
-    return _SC("Vice City");
+    const District * d = g_DistrictIndex.Find(x, y);
+    // Return the district name or fall back to the city name
+    return d != nullptr ? d->mName : _SC("Vice City");
 }
 
 // ------------------------------------------------------------------------------------------------
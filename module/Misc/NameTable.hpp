@@ -0,0 +1,223 @@
+#pragma once
+
+// ------------------------------------------------------------------------------------------------
+#include "SqBase.hpp"
+
+// ------------------------------------------------------------------------------------------------
+#include <cctype>
+#include <cstring>
+
+// ------------------------------------------------------------------------------------------------
+namespace SqMod {
+
+/* ------------------------------------------------------------------------------------------------
+ * Maximum number of characters from a normalized name that take part in a lookup.
+*/
+static constexpr size_t NAME_TABLE_KEY_MAX = 64;
+
+/* ------------------------------------------------------------------------------------------------
+ * Buffer used to hold a normalized name.
+*/
+using NameTableKey = char[NAME_TABLE_KEY_MAX];
+
+/* ------------------------------------------------------------------------------------------------
+ * Strip non alphanumeric characters from a name and convert it to lowercase. Returns the length of
+ * the whole normalized name, which can exceed the buffer. Characters that don't fit are dropped,
+ * except for the last one, which takes the place of the last character in the buffer.
+*/
+inline size_t NormalizeName(const SQChar * str, SQInteger len, NameTableKey & out) noexcept
+{
+    size_t n = 0;
+    // Process each character in the name
+    for (SQInteger i = 0; i < len; ++i)
+    {
+        const auto c = static_cast< unsigned char >(str[i]);
+        // Only keep alphanumeric characters
+        if (std::isalnum(c) != 0)
+        {
+            out[n < NAME_TABLE_KEY_MAX - 1 ? n : NAME_TABLE_KEY_MAX - 2] = static_cast< char >(std::tolower(c));
+            ++n;
+        }
+    }
+    // Terminate the name
+    out[n < NAME_TABLE_KEY_MAX - 1 ? n : NAME_TABLE_KEY_MAX - 1] = '\0';
+    // Return the length of the normalized name
+    return n;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Retrieve the last character of a normalized name with the specified length.
+*/
+SQMOD_NODISCARD inline char NameTableBack(const NameTableKey & str, size_t len) noexcept
+{
+    return str[(len < NAME_TABLE_KEY_MAX - 1 ? len : NAME_TABLE_KEY_MAX - 1) - 1];
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Compute the length of a name at compile time.
+*/
+SQMOD_NODISCARD constexpr size_t NameTableLength(const char * str) noexcept
+{
+    size_t n = 0;
+    while (str[n] != '\0') ++n;
+    return n;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Compute the hash of a normalized name at compile time (FNV-1a).
+*/
+SQMOD_NODISCARD constexpr uint32_t NameTableHash(const char * str, size_t len) noexcept
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; ++i)
+    {
+        h ^= static_cast< uint8_t >(str[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Compute the number of slots used by a table with the specified amount of names.
+*/
+SQMOD_NODISCARD constexpr size_t NameTableCapacity(size_t n) noexcept
+{
+    size_t c = 16;
+    // Keep the table at most 25% full so that nearly every name lands in its own slot
+    while (c < n * 4) c <<= 1u;
+    return c;
+}
+
+/* ------------------------------------------------------------------------------------------------
+ * Normalized name and the identifier associated with it.
+*/
+struct NameTableEntry
+{
+    const char *    mName; // Normalized name. Must be lowercase alphanumeric.
+    int32_t         mID; // Associated identifier.
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Hash table of normalized names built at compile time. Duplicate names fail to compile.
+*/
+template < size_t N > struct NameTable
+{
+    // --------------------------------------------------------------------------------------------
+    static constexpr size_t CAPACITY = NameTableCapacity(N);
+
+    /* --------------------------------------------------------------------------------------------
+     * Table slot.
+    */
+    struct Slot
+    {
+        const char *    mName; // Normalized name or null if the slot is empty.
+        uint32_t        mHash; // Hash of the normalized name.
+        uint32_t        mLen; // Length of the normalized name.
+        int32_t         mID; // Associated identifier.
+    };
+
+    // --------------------------------------------------------------------------------------------
+    Slot    mSlots[CAPACITY]; // Table slots.
+    size_t  mProbe; // Longest distance between a name and its ideal slot.
+    size_t  mLongest; // Length of the longest name.
+
+    /* --------------------------------------------------------------------------------------------
+     * Build the table from a list of entries.
+    */
+    constexpr explicit NameTable(const NameTableEntry (&entries)[N])
+        : mSlots{}, mProbe(0), mLongest(0)
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            Insert(entries[i]);
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Look for the identifier associated with a normalized name.
+    */
+    SQMOD_NODISCARD int32_t Find(const char * str, size_t len) const noexcept
+    {
+        // Names longer than every known name can't be in the table
+        if (len > mLongest)
+        {
+            return SQMOD_UNKNOWN;
+        }
+        const uint32_t h = NameTableHash(str, len);
+        // Look through the slots that could contain the name
+        for (size_t i = (h & (CAPACITY - 1)), d = 0; d <= mProbe; i = ((i + 1) & (CAPACITY - 1)), ++d)
+        {
+            const Slot & s = mSlots[i];
+            // Did we reach an empty slot?
+            if (s.mName == nullptr)
+            {
+                break;
+            }
+            // Is this the name we're looking for?
+            else if (s.mHash == h && s.mLen == len && std::memcmp(s.mName, str, len) == 0)
+            {
+                return s.mID;
+            }
+        }
+        // Unknown name
+        return SQMOD_UNKNOWN;
+    }
+
+private:
+
+    /* --------------------------------------------------------------------------------------------
+     * See if two names are equal at compile time.
+    */
+    SQMOD_NODISCARD static constexpr bool Equal(const char * a, const char * b, size_t len) noexcept
+    {
+        for (size_t i = 0; i < len; ++i)
+        {
+            if (a[i] != b[i]) return false;
+        }
+        return true;
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Insert an entry into the first free slot.
+    */
+    constexpr void Insert(const NameTableEntry & e)
+    {
+        const size_t len = NameTableLength(e.mName);
+        const uint32_t h = NameTableHash(e.mName, len);
+        // Find a free slot starting with the ideal one
+        for (size_t i = (h & (CAPACITY - 1)), d = 0; d < CAPACITY; i = ((i + 1) & (CAPACITY - 1)), ++d)
+        {
+            Slot & s = mSlots[i];
+            // Is the slot free?
+            if (s.mName == nullptr)
+            {
+                s.mName = e.mName;
+                s.mHash = h;
+                s.mLen = static_cast< uint32_t >(len);
+                s.mID = e.mID;
+                // Remember the longest distance and name
+                mProbe = d > mProbe ? d : mProbe;
+                mLongest = len > mLongest ? len : mLongest;
+                return;
+            }
+            // Is this a duplicate name?
+            else if (s.mHash == h && s.mLen == len && Equal(s.mName, e.mName, len))
+            {
+                throw "duplicate name in table"; // Not a constant expression, so the build fails
+            }
+        }
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+template < size_t N > constexpr size_t NameTable< N >::CAPACITY;
+
+/* ------------------------------------------------------------------------------------------------
+ * Build a name table from a list of entries.
+*/
+template < size_t N > SQMOD_NODISCARD constexpr NameTable< N > MakeNameTable(const NameTableEntry (&entries)[N])
+{
+    return NameTable< N >(entries);
+}
+
+} // Namespace:: SqMod
@@ -176,6 +176,44 @@ static SQInteger QuaternionToString(HSQUIRRELVM vm)
     SQ_UNREACHABLE
 }
 
+/* ------------------------------------------------------------------------------------------------
+ * Send the deferred writes of a field before it's written directly and discard its cached value.
+*/
+template < class T > static void LgBeforeWrite(T & inst, uint32_t field)
+{
+    // Pending writes must reach the server first to keep the order of the writes
+    inst.FlushPending(field);
+    // The snapshot no longer matches the server
+    inst.mSnapshot.Invalidate(field);
+}
+
+// ------------------------------------------------------------------------------------------------
+static void LgPlayerWrite(int32_t id, uint32_t field)
+{
+    if (VALID_ENTITYEX(id, SQMOD_PLAYER_POOL))
+    {
+        LgBeforeWrite(Core::Get().GetPlayer(id), field);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+static void LgVehicleWrite(int32_t id, uint32_t field)
+{
+    if (VALID_ENTITYEX(id, SQMOD_VEHICLE_POOL))
+    {
+        LgBeforeWrite(Core::Get().GetVehicle(id), field);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+static void LgObjectWrite(int32_t id, uint32_t field)
+{
+    if (VALID_ENTITYEX(id, SQMOD_OBJECT_POOL))
+    {
+        LgBeforeWrite(Core::Get().GetObj(id), field);
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void LgEntityVector::Set()
 {
@@ -185,9 +223,11 @@ void LgEntityVector::Set()
             switch (mFlag)
             {
                 case LgPlayerVectorFlag::Pos:
+                    LgPlayerWrite(mID, ESF_POSITION);
                     _Func->SetPlayerPosition(mID, x, y, z);
                 break;
                 case LgPlayerVectorFlag::Speed:
+                    LgPlayerWrite(mID, ESF_SPEED);
                     _Func->SetPlayerSpeed(mID, x, y, z);
                 break;
                 default: break;
@@ -196,21 +236,25 @@ void LgEntityVector::Set()
             switch (mFlag)
             {
                 case LgVehicleVectorFlag::Pos:
+                    LgVehicleWrite(mID, ESF_POSITION);
                     _Func->SetVehiclePosition(mID, x, y, z, 0);
                 break;
                 case LgVehicleVectorFlag::SpawnPos:
                     _Func->SetVehicleSpawnPosition(mID, x, y, z);
                 break;
                 case LgVehicleVectorFlag::Angle:
+                    LgVehicleWrite(mID, ESF_ROTATION);
                     _Func->SetVehicleRotationEuler(mID, x, y, z);
                 break;
                 case LgVehicleVectorFlag::SpawnAngle:
                     _Func->SetVehicleSpawnRotationEuler(mID, x, y, z);
                 break;
                 case LgVehicleVectorFlag::Speed:
+                    LgVehicleWrite(mID, ESF_SPEED);
                     _Func->SetVehicleSpeed(mID, x, y, z, static_cast< uint8_t >(false), static_cast< uint8_t >(false));
                 break;
                 case LgVehicleVectorFlag::RelSpeed:
+                    LgVehicleWrite(mID, ESF_SPEED);
                     _Func->SetVehicleSpeed(mID, x, y, z, static_cast< uint8_t >(false), static_cast< uint8_t >(true));
                 break;
                 case LgVehicleVectorFlag::TurnSpeed:
@@ -228,6 +272,7 @@ void LgEntityVector::Set()
             switch (mFlag)
             {
                 case LgObjectVectorFlag::Pos:
+                    LgObjectWrite(mID, ESF_POSITION);
                     _Func->SetObjectPosition(mID, x, y, z);
                 break;
                 case LgObjectVectorFlag::Rotation:
@@ -251,6 +296,7 @@ void LgEntityQuaternion::Set()
             switch (mFlag)
             {
                 case LgVehicleVectorFlag::Angle:
+                    LgVehicleWrite(mID, ESF_ROTATION);
                     _Func->SetVehicleRotation(mID, x, y, z, w);
                 break;
                 case LgVehicleVectorFlag::SpawnAngle:
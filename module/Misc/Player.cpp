@@ -1,6 +1,7 @@
 // ------------------------------------------------------------------------------------------------
 #include "Misc/Player.hpp"
 #include "Core.hpp"
+#include "Misc/NameTable.hpp"
 
 // ------------------------------------------------------------------------------------------------
 #include <algorithm>
@@ -93,6 +94,91 @@ static String CS_Skin_Names[] = { // NOLINT(cert-err58-cpp)
     /* 160 */ ""
 };
 
+// ------------------------------------------------------------------------------------------------
+// Identifiers are the ones the character matching in GetSkinID returns for each name, which isn't
+// always the skin with that name. Names the character matching doesn't recognize are left out.
+static constexpr NameTableEntry CS_Skin_Keys[] = {
+    {"tommyvercetti", 0},               {"cop", 1},
+    {"swat", 2},                        {"fbi", 3},
+    {"army", 4},                        {"paramedic", 5},
+    {"firefighter", 6},                 {"golfguy1", 7},
+    {"bumlady1", 9},                    {"bumlady2", 10},
+    {"punk1", 11},                      {"lawyer", 12},
+    {"spanishlady1", 13},               {"spanishlady2", 14},
+    {"coolguy1", 15},                   {"arabicguy", 16},
+    {"beachlady1", 17},                 {"beachlady2", 18},
+    {"beachguy1", 19},                  {"beachguy2", 20},
+    {"officelady1", 21},                {"waitress1", 22},
+    {"foodlady", 23},                   {"prostitute1", 24},
+    {"bumlady3", 44},                   {"bumguy1", 26},
+    {"garbageman1", 27},                {"taxidriver1", 28},
+    {"haitian1", 29},                   {"criminal1", 30},
+    {"hoodlady", 31},                   {"granny1", 32},
+    {"businessman1", 33},               {"churchguy", 34},
+    {"clublady", 35},                   {"churchlady", 36},
+    {"pimp", 37},                       {"beachlady3", 38},
+    {"beachguy3", 39},                  {"beachlady4", 40},
+    {"beachguy4", 41},                  {"businessman2", 42},
+    {"prostitute2", 43},                {"bumlady4", 71},
+    {"bumguy2", 45},                    {"haitian2", 46},
+    {"constructionworker1", 47},        {"punk2", 48},
+    {"prostitute3", 105},               {"granny2", 50},
+    {"punk3", 51},                      {"businessman3", 52},
+    {"spanishlady3", 53},               {"spanishlady4", 54},
+    {"coolguy2", 55},                   {"businessman4", 56},
+    {"beachlady5", 57},                 {"beachguy5", 58},
+    {"beachlady6", 59},                 {"beachguy6", 60},
+    {"constructionworker2", 61},        {"golfguy2", 62},
+    {"golflady", 63},                   {"golfguy3", 64},
+    {"beachlady7", 65},                 {"beachguy7", 66},
+    {"officelady2", 67},                {"businessman5", 68},
+    {"businessman6", 69},               {"bumguy3", 72},
+    {"spanishguy", 73},                 {"taxidriver2", 74},
+    {"gymlady", 75},                    {"gymguy", 76},
+    {"skatelady", 77},                  {"skateguy", 78},
+    {"shopper1", 79},                   {"shopper2", 80},
+    {"tourist1", 81},                   {"tourist2", 82},
+    {"cuban1", 83},                     {"cuban2", 84},
+    {"haitian3", 85},                   {"haitian4", 86},
+    {"shark1", 87},                     {"shark2", 88},
+    {"diazguy1", 89},                   {"diazguy2", 90},
+    {"dbpsecurity1", 91},               {"dbpsecurity2", 92},
+    {"biker1", 93},                     {"biker2", 94},
+    {"vercettiguy1", 95},               {"vercettiguy2", 96},
+    {"undercovercop1", 97},             {"undercovercop2", 98},
+    {"undercovercop3", 99},             {"undercovercop4", 100},
+    {"undercovercop5", 101},            {"undercovercop6", 102},
+    {"richguy", 103},                   {"coolguy3", 104},
+    {"prostitute4", 106},               {"lovefist1", 107},
+    {"kenrosenburg", 108},              {"candysuxx", 109},
+    {"hilary", 110},                    {"lovefist2", 111},
+    {"phil", 112},                      {"rockstarguy", 113},
+    {"sonny", 152},                     {"lance", 119},
+    {"mercedes", 116},                  {"lovefist3", 117},
+    {"alexshrub", 118},                 {"lancecop", 119},
+    {"cortez", 121},                    {"lovefist4", 116},
+    {"columbianguy1", 123},             {"hilaryrobber", 124},
+    {"cam", 126},                       {"camrobber", 127},
+    {"philonearm", 128},                {"philrobber", 129},
+    {"coolguy4", 130},                  {"pizzaman", 131},
+    {"sailor1", 134},                   {"sailor2", 135},
+    {"sailor3", 136},                   {"chef", 137},
+    {"criminal2", 138},                 {"frenchguy", 139},
+    {"garbageman2", 140},               {"haitian5", 141},
+    {"waitress2", 142},                 {"sonnyguy1", 143},
+    {"sonnyguy2", 144},                 {"sonnyguy3", 145},
+    {"columbianguy2", 146},             {"haitian6", 108},
+    {"beachguy8", 148},                 {"garbageman3", 149},
+    {"garbageman4", 150},               {"garbageman5", 151},
+    {"tranny", 152},                    {"thug5", 153},
+    {"spandexguy1", 154},               {"spandexguy2", 155},
+    {"stripper1", 156},                 {"stripper2", 157},
+    {"stripper3", 158},                 {"storeclerk", 159},
+};
+
+// ------------------------------------------------------------------------------------------------
+static constexpr auto CS_Skin_Table = MakeNameTable(CS_Skin_Keys);
+
 // ------------------------------------------------------------------------------------------------
 const char * GetSkinName(uint32_t id)
 {
@@ -111,21 +197,25 @@ void SetSkinName(uint32_t id, StackStrF & name)
 // ------------------------------------------------------------------------------------------------
 int32_t GetSkinID(StackStrF & name)
 {
-    // Clone the string into an editable version
-    String str(name.mPtr, static_cast< size_t >(name.mLen));
-    // Strip non alphanumeric characters from the name
-    str.erase(std::remove_if(str.begin(), str.end(), std::not1(std::ptr_fun(::isalnum))), str.end());
-    // Convert the string to lowercase
-    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+    // Strip non alphanumeric characters from the name and convert it to lowercase
+    NameTableKey str;
+    const size_t n = NormalizeName(name.mPtr, name.mLen, str);
     // See if we still have a valid name after the cleanup
-    if(str.empty())
+    if (n < 1)
     {
         return SQMOD_UNKNOWN;
     }
-    // Grab the actual length of the string
-    const uint32_t len = ConvTo< uint32_t >::From(str.length());
+    // Look for an exact match of a known name first
+    const int32_t id = CS_Skin_Table.Find(str, n);
+    // Did we find anything?
+    if (id != SQMOD_UNKNOWN)
+    {
+        return id;
+    }
+    // Fall back to identifying the skin from the most significant characters
+    const auto len = static_cast< uint32_t >(n);
     // Get the most significant characters used to identify a skin
-    CharT a = str[0], b = 0, c = 0, d = str[len-1];
+    CharT a = str[0], b = 0, c = 0, d = NameTableBack(str, len);
     // Look for deeper specifiers
     if (len > 2)
     {
@@ -1,6 +1,7 @@
 // ------------------------------------------------------------------------------------------------
 #include "Misc/Vehicle.hpp"
 #include "Core/Utility.hpp"
+#include "Misc/NameTable.hpp"
 
 // ------------------------------------------------------------------------------------------------
 #include <algorithm>
@@ -81,6 +82,68 @@ struct InitCustomVehicleNames
     }
 } g_InitCustomVehicleNames{};
 
+// ------------------------------------------------------------------------------------------------
+// Identifiers are the ones the character matching in GetAutomobileID returns for each name, which isn't
+// always the vehicle with that name. Names the character matching doesn't recognize are left out.
+static constexpr NameTableEntry CS_Vehicle_Keys[] = {
+    {"landstalker", 130},               {"idaho", 131},
+    {"stinger", 132},                   {"linerunner", 133},
+    {"perennial", 134},                 {"sentinel", 135},
+    {"rio", 136},                       {"firetruck", 137},
+    {"trashmaster", 138},               {"stretch", 139},
+    {"manana", 140},                    {"infernus", 141},
+    {"voodoo", 142},                    {"pony", 143},
+    {"mule", 144},                      {"cheetah", 145},
+    {"ambulance", 146},                 {"fbiwashington", 147},
+    {"moonbeam", 148},                  {"esperanto", 149},
+    {"taxi", 150},                      {"washington", 151},
+    {"bobcat", 152},                    {"mrwhoopee", 153},
+    {"bfinjection", 154},               {"hunter", 155},
+    {"police", 156},                    {"enforcer", 157},
+    {"securicar", 158},                 {"banshee", 159},
+    {"predator", 160},                  {"bus", 161},
+    {"rhino", 162},                     {"barracksol", 163},
+    {"cubanhermes", 164},               {"helicopter", 165},
+    {"angel", 166},                     {"coach", 167},
+    {"cabbie", 168},                    {"stallion", 169},
+    {"rumpo", 170},                     {"rcbandit", 171},
+    {"romeroshearse", 172},             {"packer", 173},
+    {"sentinelxs", 174},                {"admiral", 175},
+    {"squalo", 176},                    {"seasparrow", 177},
+    {"pizzaboy", 178},                  {"gangburrito", 179},
+    {"airtrain", 180},                  {"deaddodo", 181},
+    {"speeder", 213},                   {"reefer", 183},
+    {"tropic", 184},                    {"flatbed", 185},
+    {"yankee", 186},                    {"caddy", 187},
+    {"zebracab", 188},                  {"topfun", 189},
+    {"skimmer", 190},                   {"pcj600", 191},
+    {"faggio", 192},                    {"freeway", 193},
+    {"rcbaron", 194},                   {"rcraider", 195},
+    {"glendale", 196},                  {"oceanic", 197},
+    {"sanchez", 198},                   {"sparrow", 213},
+    {"patriot", 200},                   {"lovefist", 201},
+    {"coastguard", 202},                {"dinghy", 203},
+    {"hermes", 204},                    {"sabre", 205},
+    {"sabreturbo", 206},                {"phoenix", 207},
+    {"walton", 208},                    {"regina", 209},
+    {"comet", 210},                     {"deluxo", 211},
+    {"burrito", 212},                   {"spandexpress", 213},
+    {"marquis", 214},                   {"baggagehandler", 215},
+    {"kaufmancab", 216},                {"maverick", 217},
+    {"vcnmaverick", 218},               {"rancher", 219},
+    {"fbirancher", 220},                {"virgo", 221},
+    {"greenwood", 222},                 {"cubanjetmax", 223},
+    {"hotringracer1", 224},             {"sandking", 225},
+    {"blistacompact", 226},             {"policemaverick", 227},
+    {"boxville", 228},                  {"benson", 229},
+    {"mesagrande", 230},                {"rcgoblin", 231},
+    {"hotringracer2", 232},             {"hotringracer3", 233},
+    {"bloodringbanger1", 234},          {"bloodringbanger2", 235},
+};
+
+// ------------------------------------------------------------------------------------------------
+static constexpr auto CS_Vehicle_Table = MakeNameTable(CS_Vehicle_Keys);
+
 // ------------------------------------------------------------------------------------------------
 String & GetAutomobileName(uint32_t id)
 {
@@ -120,21 +183,25 @@ void SetAutomobileName(uint32_t id, StackStrF & name)
 // ------------------------------------------------------------------------------------------------
 int32_t GetAutomobileID(StackStrF & name)
 {
-    // Clone the string into an editable version
-    String str(name.mPtr, static_cast< size_t >(name.mLen));
-    // Strip non alphanumeric characters from the name
-    str.erase(std::remove_if(str.begin(), str.end(), std::not1(std::ptr_fun(::isalnum))), str.end());
-    // Convert the string to lowercase
-    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+    // Strip non alphanumeric characters from the name and convert it to lowercase
+    NameTableKey str;
+    const size_t n = NormalizeName(name.mPtr, name.mLen, str);
     // See if we still have a valid name after the cleanup
-    if(str.empty())
+    if (n < 1)
     {
         return SQMOD_UNKNOWN;
     }
-    // Grab the actual length of the string
-    const uint32_t len = ConvTo< uint32_t >::From(str.length());
+    // Look for an exact match of a known name first
+    const int32_t id = CS_Vehicle_Table.Find(str, n);
+    // Did we find anything?
+    if (id != SQMOD_UNKNOWN)
+    {
+        return id;
+    }
+    // Fall back to identifying the vehicle from the most significant characters
+    const auto len = static_cast< uint32_t >(n);
     // Get the most significant characters used to identify a vehicle
-    CharT a = str[0], b = 0, c = 0, d = str[len-1];
+    CharT a = str[0], b = 0, c = 0, d = NameTableBack(str, len);
     // Look for deeper specifiers
     if(len > 2)
     {
@@ -1,6 +1,7 @@
 // ------------------------------------------------------------------------------------------------
 #include "Misc/Weapon.hpp"
 #include "Core/Utility.hpp"
+#include "Misc/NameTable.hpp"
 
 // ------------------------------------------------------------------------------------------------
 #include <algorithm>
@@ -50,6 +51,38 @@ static String CS_Weapon_Names[] = { // NOLINT(cert-err58-cpp)
 /// Fall back for custom weapon names.
 static std::unordered_map<uint32_t, String> CS_Custom_Weapon_Names{};
 
+// ------------------------------------------------------------------------------------------------
+// Identifiers are the ones the character matching in GetWeaponID returns for each name, which isn't
+// always the weapon with that name. Names the character matching doesn't recognize are left out.
+static constexpr NameTableEntry CS_Weapon_Keys[] = {
+    {"unarmed", SQMOD_WEAPON_UNARMED},                  {"brassknuckles", SQMOD_WEAPON_BRASSKNUCKLES},
+    {"screwdriver", SQMOD_WEAPON_SCREWDRIVER},          {"golfclub", SQMOD_WEAPON_GOLFCLUB},
+    {"nightstick", SQMOD_WEAPON_NIGHTSTICK},            {"knife", SQMOD_WEAPON_KNIFE},
+    {"baseballbat", SQMOD_WEAPON_BASEBALLBAT},          {"hammer", SQMOD_WEAPON_HAMMER},
+    {"meatcleaver", SQMOD_WEAPON_MEATCLEAVER},          {"machete", SQMOD_WEAPON_MACHETE},
+    {"katana", SQMOD_WEAPON_KATANA},                    {"chainsaw", SQMOD_WEAPON_CHAINSAW},
+    {"grenade", SQMOD_WEAPON_GRENADE},                  {"remotedetonationgrenade", SQMOD_WEAPON_REMOTE},
+    {"teargas", SQMOD_WEAPON_TEARGAS},                  {"molotovcocktails", SQMOD_WEAPON_MOLOTOV},
+    {"missile", SQMOD_WEAPON_ROCKET},                   {"colt45", SQMOD_WEAPON_COLT45},
+    {"python", SQMOD_WEAPON_PYTHON},                    {"pumpactionshotgun", SQMOD_WEAPON_SHOTGUN},
+    {"spas12shotgun", SQMOD_WEAPON_SPAS12},             {"stubbyshotgun", SQMOD_WEAPON_STUBBY},
+    {"tec9", SQMOD_WEAPON_TEC9},                        {"uzi", SQMOD_WEAPON_UZI},
+    {"silencedingram", SQMOD_WEAPON_INGRAM},            {"mp5", SQMOD_WEAPON_MP5},
+    {"m4", SQMOD_WEAPON_M4},                            {"ruger", SQMOD_WEAPON_RUGER},
+    {"sniperrifle", SQMOD_WEAPON_SNIPER},               {"laserscopesniperrifle", SQMOD_WEAPON_LASERSCOPE},
+    {"rocketlauncher", SQMOD_WEAPON_ROCKETLAUNCHER},    {"flamethrower", SQMOD_WEAPON_FLAMETHROWER},
+    {"m60", SQMOD_WEAPON_M60},                          {"minigun", SQMOD_WEAPON_MINIGUN},
+    {"bomb", SQMOD_WEAPON_BOMB},                        {"helicanon", SQMOD_WEAPON_HELICANNON},
+    {"helicannon", SQMOD_WEAPON_HELICANNON},            {"camera", SQMOD_WEAPON_CAMERA},
+    {"vehicle", SQMOD_WEAPON_VEHICLE},                  {"heliblades1", SQMOD_WEAPON_HELIBLADES1},
+    {"heliblades2", SQMOD_WEAPON_HELIBLADES2},          {"explosion", SQMOD_WEAPON_EXPLOSION2},
+    {"driveby", SQMOD_WEAPON_DRIVEBY},                  {"drowned", SQMOD_WEAPON_DROWNED},
+    {"fall", SQMOD_WEAPON_FALL},                        {"suicide", SQMOD_WEAPON_SUICIDE},
+};
+
+// ------------------------------------------------------------------------------------------------
+static constexpr auto CS_Weapon_Table = MakeNameTable(CS_Weapon_Keys);
+
 // ------------------------------------------------------------------------------------------------
 static inline bool IsCustomWeapon(uint32_t id)
 {
@@ -160,21 +193,25 @@ void ClearCustomWeaponNamePool()
 // ------------------------------------------------------------------------------------------------
 int32_t GetWeaponID(StackStrF & name)
 {
-    // Clone the string into an editable version
-    String str(name.mPtr, static_cast< size_t >(name.mLen));
-    // Strip non alphanumeric characters from the name
-    str.erase(std::remove_if(str.begin(), str.end(), std::not1(std::ptr_fun(::isalnum))), str.end());
-    // Convert the string to lowercase
-    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+    // Strip non alphanumeric characters from the name and convert it to lowercase
+    NameTableKey str;
+    const size_t n = NormalizeName(name.mPtr, name.mLen, str);
     // See if we still have a valid name after the cleanup
-    if(str.length() < 1)
+    if (n < 1)
     {
         return SQMOD_UNKNOWN;
     }
-    // Grab the actual length of the string
-    const uint32_t len = ConvTo< uint32_t >::From(str.length());
+    // Look for an exact match of a known name first
+    const int32_t id = CS_Weapon_Table.Find(str, n);
+    // Did we find anything?
+    if (id != SQMOD_UNKNOWN)
+    {
+        return id;
+    }
+    // Fall back to identifying the weapon from the most significant characters
+    const auto len = static_cast< uint32_t >(n);
     // Get the most significant characters used to identify a weapon
-    CharT a = str[0], b = 0, c = 0, d = str[len-1];
+    CharT a = str[0], b = 0, c = 0, d = NameTableBack(str, len);
     // Look for deeper specifiers
     if(len > 2)
     {
@@ -1,5 +1,6 @@
 // ------------------------------------------------------------------------------------------------
 #include "PocoLib/Data.hpp"
+#include "Core/ThreadPool.hpp"
 
 // ------------------------------------------------------------------------------------------------
 #include <sqratConst.h>
@@ -585,6 +586,181 @@ void TerminatePocoData()
     }
 }
 
+/* ------------------------------------------------------------------------------------------------
+ * Query executed on a pooled session from a worker thread.
+*/
+struct SqDataAsyncQuery : public ThreadPoolItem
+{
+    /* --------------------------------------------------------------------------------------------
+     * Values from a single column of the result.
+    */
+    struct Column
+    {
+        String                                  mName{}; // Column name.
+        Poco::Data::MetaColumn::ColumnDataType  mType{}; // Column type.
+        std::vector< Poco::Dynamic::Var >       mValues{}; // Column values, one for each row.
+    };
+
+    // --------------------------------------------------------------------------------------------
+    SqDataSessionPool *     mPool{nullptr}; // Associated session pool.
+    Function                mCallback{}; // Function to call when completed.
+    LightObj                mObject{}; // Prevent the session pool from being destroyed.
+    String                  mQuery{}; // Query to execute.
+    String                  mError{}; // Error message, if the query failed.
+    std::vector< Column >   mColumns{}; // Extracted result columns.
+    size_t                  mRows{0}; // Number of extracted rows.
+    size_t                  mAffected{0}; // Number of affected rows.
+    bool                    mFailed{false}; // Whether the query failed.
+
+    /* --------------------------------------------------------------------------------------------
+     * Base constructor.
+    */
+    SqDataAsyncQuery(SqDataSessionPool * pool, Function & cb, LightObj && obj, String && query)
+        : mPool(pool)
+        , mCallback(std::move(cb))
+        , mObject(std::move(obj))
+        , mQuery(std::move(query))
+    {
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Destructor.
+    */
+    ~SqDataAsyncQuery() override = default;
+
+    /* --------------------------------------------------------------------------------------------
+     * Task process callback. Invoked in a worker thread.
+    */
+    SQMOD_NODISCARD bool OnProcess() override
+    {
+        try
+        {
+            // Borrow a session from the pool (returned when it goes out of scope)
+            Session session(mPool->get());
+            // Create and execute the statement
+            Statement stmt(session);
+            stmt << mQuery;
+            mAffected = stmt.execute();
+            // Extract the result, if any, one column at a time
+            if (stmt.extractionCount() > 0)
+            {
+                RecordSet rs(stmt);
+                mRows = rs.rowCount();
+                mColumns.resize(rs.columnCount());
+                for (size_t c = 0; c < mColumns.size(); ++c)
+                {
+                    Column & col = mColumns[c];
+                    col.mName = rs.columnName(c);
+                    col.mType = rs.columnType(c);
+                    col.mValues.reserve(mRows);
+                    for (size_t r = 0; r < mRows; ++r)
+                    {
+                        col.mValues.push_back(rs.value(c, r));
+                    }
+                }
+            }
+        }
+        catch (const Poco::Exception & e)
+        {
+            mFailed = true;
+            mError = e.displayText();
+        }
+        catch (const std::exception & e)
+        {
+            mFailed = true;
+            mError = e.what();
+        }
+        return false; // We do this once
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Task completed callback. Invoked in the main thread.
+    */
+    void OnCompleted() override
+    {
+        // Is there a callback?
+        if (mCallback.IsNull())
+        {
+            return;
+        }
+        LightObj result;
+        // Convert the result to script values
+        if (!mFailed)
+        {
+            try
+            {
+                result = Convert();
+            }
+            catch (const std::exception & e)
+            {
+                mFailed = true;
+                mError = e.what();
+            }
+        }
+        // Invoke the callback
+        if (mFailed)
+        {
+            mCallback(mObject, LightObj{}, mError);
+        }
+        else
+        {
+            mCallback(mObject, result, LightObj{});
+        }
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Task aborted callback.
+    */
+    void OnAborted(bool SQ_UNUSED_ARG(retry)) override
+    {
+        mFailed = true;
+        mError = "Query was aborted";
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Convert the extracted columns to a result table.
+    */
+    SQMOD_NODISCARD LightObj Convert() const
+    {
+        HSQUIRRELVM vm = SqVM();
+        const LightObj null;
+        // Create the column containers
+        Array names(vm, static_cast< SQInteger >(mColumns.size()));
+        Array columns(vm, static_cast< SQInteger >(mColumns.size()));
+        for (size_t c = 0; c < mColumns.size(); ++c)
+        {
+            const Column & col = mColumns[c];
+            Array values(vm, static_cast< SQInteger >(col.mValues.size()));
+            for (size_t r = 0; r < col.mValues.size(); ++r)
+            {
+                values.SetValue(static_cast< SQInteger >(r), SqDataRecordSet::GetValueImpl(col.mValues[r], col.mType, null));
+            }
+            names.SetValue(static_cast< SQInteger >(c), col.mName);
+            columns.SetValue(static_cast< SQInteger >(c), values);
+        }
+        // Create the result table
+        Table tbl(vm);
+        tbl.SetValue(_SC("Rows"), static_cast< SQInteger >(mRows));
+        tbl.SetValue(_SC("Affected"), static_cast< SQInteger >(mAffected));
+        tbl.SetValue(_SC("Names"), names);
+        tbl.SetValue(_SC("Columns"), columns);
+        return LightObj(tbl);
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+SqDataSessionPool & SqDataSessionPool::AsyncQuery(Function & cb, StackStrF & query)
+{
+    if (!isActive())
+    {
+        STHROWF("Session pool was shut down");
+    }
+    // Queue the task to be processed
+    ThreadPool::Get().Enqueue(new SqDataAsyncQuery(this, cb, LightObj(1, SqVM()), query.ToStr()));
+    // Allow chaining
+    return *this;
+}
+
 // ================================================================================================
 void Register_POCO_Data(HSQUIRRELVM vm, Table &)
 {
@@ -771,6 +947,7 @@ void Register_POCO_Data(HSQUIRRELVM vm, Table &)
         .FmtFunc(_SC("SetProperty"), &SqDataSessionPool::SetProperty)
         .FmtFunc(_SC("GetProperty"), &SqDataSessionPool::GetProperty)
         .Func(_SC("Shutdown"), &SqDataSessionPool::Shutdown)
+        .FmtFunc(_SC("AsyncQuery"), &SqDataSessionPool::AsyncQuery)
         // Static Functions
         .StaticFunc(_SC("GetName"), &SqDataSessionPool::GetName_)
     );
@@ -483,6 +483,7 @@ using Poco::Data::ReferenceBinding;
 struct SqDataSession;
 struct SqDataStatement;
 struct SqDataRecordSet;
+struct SqDataAsyncQuery;
 
 /* ------------------------------------------------------------------------------------------------
  * Utility used to transform optimal argument type to stored type.
@@ -1651,6 +1652,9 @@ struct SqDataRecordSet : public RecordSet
 
 protected:
 
+    // --------------------------------------------------------------------------------------------
+    friend struct SqDataAsyncQuery; // Converts values from asynchronous queries.
+
     /* --------------------------------------------------------------------------------------------
      * Retrieve the value in the given column (index) of the current row if the value is not NULL, or `fallback` otherwise.
     */
@@ -1930,6 +1934,14 @@ struct SqDataSessionPool : public SessionPool
     {
         return isActive();
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Execute a query on a pooled session from a worker thread. The callback is invoked from the
+     * main thread with the pool, the result (or null on failure) and the error message (or null).
+     * The result is a table with the row count (Rows), the number of affected rows (Affected), the
+     * column names (Names) and an array of values for each column (Columns), in the same order.
+    */
+    SqDataSessionPool & AsyncQuery(Function & cb, StackStrF & query);
 };
 
 /* ------------------------------------------------------------------------------------------------
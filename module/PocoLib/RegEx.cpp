@@ -4,6 +4,10 @@
 // ------------------------------------------------------------------------------------------------
 #include <sqratConst.h>
 
+// ------------------------------------------------------------------------------------------------
+#include <list>
+#include <unordered_map>
+
 // ------------------------------------------------------------------------------------------------
 namespace SqMod {
 
@@ -12,7 +16,100 @@ SQMOD_DECL_TYPENAME(SqRegEx, _SC("SqRegEx"))
 SQMOD_DECL_TYPENAME(SqRegExMatch, _SC("SqRegExMatch"))
 SQMOD_DECL_TYPENAME(SqRegExMatches, _SC("SqRegExMatches"))
 
+/* ------------------------------------------------------------------------------------------------
+ * Least recently used cache of compiled expressions keyed by pattern and options.
+*/
+struct RegExCache
+{
+    // --------------------------------------------------------------------------------------------
+    typedef std::pair< String, PcRegEx::Pointer >                       Entry;
+    typedef std::list< Entry >                                          List;
+    typedef std::unordered_map< String, List::iterator >                Index;
+
+    // --------------------------------------------------------------------------------------------
+    List    mList{}; // Cached expressions, most recently used first.
+    Index   mIndex{}; // Cached expressions by key.
+    size_t  mCapacity{64}; // Maximum number of cached expressions.
+
+    /* --------------------------------------------------------------------------------------------
+     * Drop the least recently used expressions until the cache fits within its capacity.
+    */
+    void Trim()
+    {
+        while (mList.size() > mCapacity)
+        {
+            mIndex.erase(mList.back().first);
+            mList.pop_back();
+        }
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+static RegExCache & GetRegExCache()
+{
+    static RegExCache c;
+    return c;
+}
+
+// ------------------------------------------------------------------------------------------------
+PcRegEx::Pointer PcRegEx::Acquire(const String & pattern, int options)
+{
+    RegExCache & c = GetRegExCache();
+    // Options are part of the key since they affect compilation
+    String key(fmt::format("{}:{}", options, pattern));
+    // Is this expression already compiled?
+    auto itr = c.mIndex.find(key);
+    if (itr != c.mIndex.end())
+    {
+        // Move it to the front of the list
+        c.mList.splice(c.mList.begin(), c.mList, itr->second);
+        return itr->second->second;
+    }
+    // Compile the expression (throws on failure so nothing is cached)
+    auto rx = std::make_shared< Poco::RegularExpression >(pattern, options);
+    // A capacity of zero disables caching
+    if (c.mCapacity > 0)
+    {
+        c.mList.emplace_front(key, rx);
+        c.mIndex.emplace(std::move(key), c.mList.begin());
+        c.Trim();
+    }
+    return rx;
+}
+
+// ------------------------------------------------------------------------------------------------
+LightObj PcRegEx::CachedEx(int options, StackStrF & str)
+{
+    return LightObj(SqTypeIdentity< PcRegEx >{}, SqVM(), Acquire(str.ToStr(), options));
+}
+
 // ------------------------------------------------------------------------------------------------
+SQInteger PcRegEx::GetCacheCapacity()
+{
+    return static_cast< SQInteger >(GetRegExCache().mCapacity);
+}
+
+// ------------------------------------------------------------------------------------------------
+void PcRegEx::SetCacheCapacity(SQInteger n)
+{
+    RegExCache & c = GetRegExCache();
+    c.mCapacity = static_cast< size_t >(ClampMin(n, SQInteger(0)));
+    c.Trim();
+}
+
+// ------------------------------------------------------------------------------------------------
+SQInteger PcRegEx::GetCacheSize()
+{
+    return static_cast< SQInteger >(GetRegExCache().mList.size());
+}
+
+// ------------------------------------------------------------------------------------------------
+void PcRegEx::ClearCache()
+{
+    RegExCache & c = GetRegExCache();
+    c.mIndex.clear();
+    c.mList.clear();
+}
 
 
 // ================================================================================================
@@ -68,6 +165,13 @@ void Register_POCO_RegEx(HSQUIRRELVM vm, Table & ns)
         .SquirrelFunc(_SC("_typename"), &SqRegEx::Fn)
         // Member Methods
         //.Func(_SC("Assign"), &PcRegEx::assign)
+        // Static Functions
+        .StaticFunc(_SC("Cached"), &PcRegEx::Cached)
+        .StaticFunc(_SC("CachedEx"), &PcRegEx::CachedEx)
+        .StaticFunc(_SC("GetCacheCapacity"), &PcRegEx::GetCacheCapacity)
+        .StaticFunc(_SC("SetCacheCapacity"), &PcRegEx::SetCacheCapacity)
+        .StaticFunc(_SC("GetCacheSize"), &PcRegEx::GetCacheSize)
+        .StaticFunc(_SC("ClearCache"), &PcRegEx::ClearCache)
         // Overloaded Member Methods
         .Overload(_SC("MatchFirst"), &PcRegEx::MatchFirst)
         .Overload(_SC("MatchFirst"), &PcRegEx::MatchFirst_)
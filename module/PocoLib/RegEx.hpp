@@ -4,6 +4,7 @@
 #include "Core/Utility.hpp"
 
 // ------------------------------------------------------------------------------------------------
+#include <memory>
 #include <algorithm>
 
 // ------------------------------------------------------------------------------------------------
@@ -348,16 +349,21 @@ struct PcRegExMatches
 */
 struct PcRegEx
 {
+    /* --------------------------------------------------------------------------------------------
+     * Compiled expressions can be shared between instances when they come from the cache.
+    */
+    typedef std::shared_ptr< Poco::RegularExpression > Pointer;
+
     /* --------------------------------------------------------------------------------------------
      * Internal RegularExpression instance.
     */
-    Poco::RegularExpression m_Rx;
+    Pointer m_Rx;
 
     /* --------------------------------------------------------------------------------------------
      * Base constructor.
     */
     explicit PcRegEx(StackStrF & str)
-        : m_Rx(str.ToStr())
+        : m_Rx(std::make_shared< Poco::RegularExpression >(str.ToStr()))
     {
     }
 
@@ -365,7 +371,7 @@ struct PcRegEx
      * Explicit constructor.
     */
     PcRegEx(int options, StackStrF & str)
-        : m_Rx(str.ToStr(), options)
+        : m_Rx(std::make_shared< Poco::RegularExpression >(str.ToStr(), options))
     {
     }
 
@@ -373,7 +379,15 @@ struct PcRegEx
      * Explicit constructor.
     */
     PcRegEx(int options, bool study, StackStrF & str)
-        : m_Rx(str.ToStr(), options, study)
+        : m_Rx(std::make_shared< Poco::RegularExpression >(str.ToStr(), options, study))
+    {
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Construct from an already compiled expression.
+    */
+    explicit PcRegEx(Pointer rx)
+        : m_Rx(std::move(rx))
     {
     }
 
@@ -405,11 +419,11 @@ struct PcRegEx
     */
     SQMOD_NODISCARD int MatchFirst(PcRegExMatch & m, StackStrF & s) const
     {
-        return m_Rx.match(s.ToStr(), m);
+        return m_Rx->match(s.ToStr(), m);
     }
     SQMOD_NODISCARD int MatchFirst_(int f, PcRegExMatch & m, StackStrF & s) const
     {
-        return m_Rx.match(s.ToStr(), m, f);
+        return m_Rx->match(s.ToStr(), m, f);
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -420,11 +434,11 @@ struct PcRegEx
     */
     SQMOD_NODISCARD int MatchFirstFrom(SQInteger o, PcRegExMatch & m, StackStrF & s) const
     {
-        return m_Rx.match(s.ToStr(), static_cast< std::string::size_type >(o), m);
+        return m_Rx->match(s.ToStr(), static_cast< std::string::size_type >(o), m);
     }
     SQMOD_NODISCARD int MatchFirstFrom_(int f, SQInteger o, PcRegExMatch & m, StackStrF & s) const
     {
-        return m_Rx.match(s.ToStr(), static_cast< std::string::size_type >(o), m, f);
+        return m_Rx->match(s.ToStr(), static_cast< std::string::size_type >(o), m, f);
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -436,11 +450,11 @@ struct PcRegEx
     */
     SQMOD_NODISCARD int Match(PcRegExMatches & m, StackStrF & s) const
     {
-        return m_Rx.match(s.ToStr(), 0, m.m_List);
+        return m_Rx->match(s.ToStr(), 0, m.m_List);
     }
     SQMOD_NODISCARD int Match_(int f, PcRegExMatches & m, StackStrF & s) const
     {
-        return m_Rx.match(s.ToStr(), 0, m.m_List, f);
+        return m_Rx->match(s.ToStr(), 0, m.m_List, f);
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -452,11 +466,11 @@ struct PcRegEx
     */
     SQMOD_NODISCARD int MatchFrom(SQInteger o, PcRegExMatches & m, StackStrF & s) const
     {
-        return m_Rx.match(s.ToStr(), static_cast< std::string::size_type >(o), m.m_List);
+        return m_Rx->match(s.ToStr(), static_cast< std::string::size_type >(o), m.m_List);
     }
     SQMOD_NODISCARD int MatchFrom_(int f, SQInteger o, PcRegExMatches & m, StackStrF & s) const
     {
-        return m_Rx.match(s.ToStr(), static_cast< std::string::size_type >(o), m.m_List, f);
+        return m_Rx->match(s.ToStr(), static_cast< std::string::size_type >(o), m.m_List, f);
     }
 
     /* --------------------------------------------------------------------------------------------
@@ -466,16 +480,56 @@ struct PcRegEx
     */
     SQMOD_NODISCARD bool Matches(StackStrF & s) const
     {
-        return m_Rx.match(s.ToStr());
+        return m_Rx->match(s.ToStr());
     }
     SQMOD_NODISCARD bool Matches_(SQInteger o, StackStrF & s) const
     {
-        return m_Rx.match(s.ToStr(), static_cast< std::string::size_type >(o));
+        return m_Rx->match(s.ToStr(), static_cast< std::string::size_type >(o));
     }
     SQMOD_NODISCARD bool MatchesEx(int f, SQInteger o, StackStrF & s) const
     {
-        return m_Rx.match(s.ToStr(), static_cast< std::string::size_type >(o), f);
+        return m_Rx->match(s.ToStr(), static_cast< std::string::size_type >(o), f);
     }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve an instance that shares a compiled expression from the cache.
+     * The expression is compiled and added to the cache if it wasn't already there.
+    */
+    SQMOD_NODISCARD static LightObj Cached(StackStrF & str)
+    {
+        return CachedEx(0, str);
+    }
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve an instance that shares a compiled expression from the cache.
+     * The expression is compiled and added to the cache if it wasn't already there.
+    */
+    SQMOD_NODISCARD static LightObj CachedEx(int options, StackStrF & str);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve a compiled expression from the cache. Compile it and add it if it wasn't there.
+    */
+    SQMOD_NODISCARD static Pointer Acquire(const String & pattern, int options);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the maximum number of compiled expressions kept in the cache.
+    */
+    SQMOD_NODISCARD static SQInteger GetCacheCapacity();
+
+    /* --------------------------------------------------------------------------------------------
+     * Modify the maximum number of compiled expressions kept in the cache.
+    */
+    static void SetCacheCapacity(SQInteger n);
+
+    /* --------------------------------------------------------------------------------------------
+     * Retrieve the number of compiled expressions currently in the cache.
+    */
+    SQMOD_NODISCARD static SQInteger GetCacheSize();
+
+    /* --------------------------------------------------------------------------------------------
+     * Discard all compiled expressions from the cache. Instances that use them are not affected.
+    */
+    static void ClearCache();
 };
 
 } // Namespace:: SqMod
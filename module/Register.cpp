@@ -17,6 +17,7 @@ extern void Register_Sphere(HSQUIRRELVM vm);
 extern void Register_Vector2(HSQUIRRELVM vm);
 extern void Register_Vector2i(HSQUIRRELVM vm);
 extern void Register_Vector3(HSQUIRRELVM vm);
+extern void Register_Vector3Array(HSQUIRRELVM vm);
 extern void Register_Vector4(HSQUIRRELVM vm);
 extern void Register_Base(HSQUIRRELVM vm);
 extern void Register_Algo(HSQUIRRELVM vm);
@@ -65,6 +66,7 @@ extern void Register_Command(HSQUIRRELVM vm);
 extern void Register_Inventory(HSQUIRRELVM vm);
 extern void Register_Loot(HSQUIRRELVM vm);
 extern void Register_Privilege(HSQUIRRELVM vm);
+extern void Register_Profiler(HSQUIRRELVM vm);
 extern void Register_Routine(HSQUIRRELVM vm);
 extern void Register_Tasks(HSQUIRRELVM vm);
 
@@ -88,6 +90,7 @@ bool RegisterAPI(HSQUIRRELVM vm)
     Register_Vector2(vm);
     Register_Vector2i(vm);
     Register_Vector3(vm);
+    Register_Vector3Array(vm);
     Register_Vector4(vm);
     Register_Base(vm);
     Register_Algo(vm);
@@ -132,6 +135,7 @@ bool RegisterAPI(HSQUIRRELVM vm)
     Register_Inventory(vm);
     Register_Loot(vm);
     Register_Privilege(vm);
+    Register_Profiler(vm);
     Register_Routine(vm);
     Register_Tasks(vm);
 
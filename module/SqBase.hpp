@@ -379,6 +379,41 @@ enum EntityFlags
     ENF_DIST_TRACK  = (1u << 4u)
 };
 
+/* ------------------------------------------------------------------------------------------------
+ * Entity fields that can be served from the per-frame state snapshot.
+*/
+enum EntitySnapshotField
+{
+    ESF_NONE        = (0),
+    ESF_POSITION    = (1u << 0u),
+    ESF_ROTATION    = (1u << 1u),
+    ESF_HEADING     = (1u << 2u),
+    ESF_HEALTH      = (1u << 3u),
+    ESF_ARMOUR      = (1u << 4u),
+    ESF_WEAPON      = (1u << 5u),
+    ESF_SPEED       = (1u << 6u),
+    ESF_ALL         = (0xFFFFFFFFu)
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Stages of a server frame that are timed by the frame watchdog.
+*/
+enum FrameStage
+{
+    FS_EVENT = 0,
+    FS_ROUTINES,
+    FS_TASKS,
+    FS_LOOT,
+    FS_THREADS,
+    FS_NET,
+    FS_DPP,
+    FS_LOGGER,
+    FS_RELOAD,
+    FS_ENTITIES,
+    FS_FRAME,
+    FS_MAX
+};
+
 /* ------------------------------------------------------------------------------------------------
  * Used to identify entity types.
 */
@@ -703,6 +738,9 @@ enum EntityType
 #define SQMOD_MAX_CMD_ARGS          12
 #define SQMOD_PLAYER_MSG_PREFIXES   16
 #define SQMOD_PLAYER_TMP_BUFFER     128
+#define SQMOD_SAMPLER_COMMAND       0x53515350 // Plug-in command that controls the script sampler.
+#define SQMOD_FRAME_WINDOW          512 // Number of recent frames used for frame stage percentiles.
+#define SQMOD_FRAME_BUCKETS         24 // Number of power of two (microsecond) frame stage histogram buckets.
 
 /* ------------------------------------------------------------------------------------------------
  * PLAYER ACTION IDENTIFIERS
@@ -30,6 +30,7 @@
 #include <squirrelex.h>
 
 #include <cstring>
+#include <new>
 
 #include "sqratObject.h"
 #include "sqratTypes.h"
@@ -547,4 +548,232 @@ public:
     }
 };
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Allocation counters of a PooledAllocator. Every pool links its counters into a global list.
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct PoolStats {
+
+    string              name{};         ///< Name of the class that uses the pool (known after the first allocation).
+    SQUnsignedInteger   allocated{0};   ///< Number of blocks that had to be allocated from the system.
+    SQUnsignedInteger   reused{0};      ///< Number of blocks that were taken from the free list.
+    SQUnsignedInteger   released{0};    ///< Number of blocks that were given back by instances.
+    SQUnsignedInteger   live{0};        ///< Number of blocks currently used by instances.
+    SQUnsignedInteger   cached{0};      ///< Number of blocks currently kept in the free list.
+    void             (* trim)(){nullptr}; ///< Function that releases the blocks in the free list.
+    PoolStats *         next{nullptr};  ///< Next pool in the list.
+
+    explicit PoolStats(void (*t)()) : trim(t), next(Head()) {
+        Head() = this;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Retrieve the first pool in the list of pools
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static PoolStats*& Head() {
+        static PoolStats* head = nullptr;
+        return head;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Release the blocks kept in the free lists of all pools
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static void TrimAll() {
+        for (PoolStats* p = Head(); p != nullptr; p = p->next) {
+            p->trim();
+        }
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// PooledAllocator is the allocator to use for small value types that are frequently created and destroyed
+///
+/// \tparam C         Type of class
+/// \tparam MaxCached Maximum number of released blocks kept for reuse
+///
+/// \remarks
+/// The instance data and the value itself are placed in a single block which is recycled through a free list
+///  instead of three separate allocations. Like the rest of Sqrat, this is not thread safe.
+///
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<class C, size_t MaxCached = 4096>
+class PooledAllocator {
+
+    typedef std::pair<C*, SharedPtr<std::unordered_map<C*, HSQOBJECT>> > Instance;
+
+    // The instance data must come first since the instance user pointer refers to the block
+    struct Block {
+        alignas(Instance) unsigned char inst[sizeof(Instance)];
+        alignas(C) unsigned char value[sizeof(C)];
+        Block* next;
+    };
+
+    static Block*& FreeList() {
+        static Block* head = nullptr;
+        return head;
+    }
+
+    static Block* Acquire() {
+        PoolStats& s = GetStats();
+        Block* b = FreeList();
+        if (b != nullptr) {
+            FreeList() = b->next;
+            --s.cached;
+            ++s.reused;
+        } else {
+            b = new Block;
+            ++s.allocated;
+        }
+        ++s.live;
+        return b;
+    }
+
+    static void Recycle(Block* b) {
+        PoolStats& s = GetStats();
+        --s.live;
+        ++s.released;
+        if (s.cached < MaxCached) {
+            b->next = FreeList();
+            FreeList() = b;
+            ++s.cached;
+        } else {
+            delete b;
+        }
+    }
+
+    static void Trim() {
+        PoolStats& s = GetStats();
+        while (FreeList() != nullptr) {
+            Block* b = FreeList();
+            FreeList() = b->next;
+            delete b;
+        }
+        s.cached = 0;
+    }
+
+    template <class F>
+    static void Emplace(HSQUIRRELVM vm, SQInteger idx, F f) {
+        Block* b = Acquire();
+        C* ptr;
+        try {
+            ptr = f(b->value);
+        } catch (...) {
+            Recycle(b);
+            throw;
+        }
+        SetInstance(vm, idx, b, ptr);
+    }
+
+    static void SetInstance(HSQUIRRELVM vm, SQInteger idx, Block* b, C* ptr)
+    {
+        ClassData<C>* cd = ClassType<C>::getClassData(vm);
+        sq_setinstanceup(vm, idx, new (b->inst) Instance(ptr, cd->instances));
+        sq_setreleasehook(vm, idx, &Delete);
+        sq_getstackobj(vm, idx, &((*cd->instances)[ptr]));
+        // Remember the class name for statistics
+        PoolStats& s = GetStats();
+        if (s.name.empty()) {
+            s.name = ClassType<C>::ClassName();
+        }
+    }
+
+public:
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Retrieve the allocation counters of this pool
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static PoolStats& GetStats() {
+        static PoolStats stats(&Trim);
+        return stats;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Associates a newly created instance with a copy of an existing value
+    ///
+    /// \param vm  VM that has an instance object of the correct type at idx
+    /// \param idx Index of the stack that the instance object is at
+    /// \param ptr Value to copy into the instance (ownership is not taken)
+    ///
+    /// \remarks
+    /// This function should only need to be used when custom constructors are bound with Class::SquirrelFunc.
+    ///
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static void SetInstance(HSQUIRRELVM vm, SQInteger idx, const C* ptr)
+    {
+        Emplace(vm, idx, [ptr](void* mem) { return new (mem) C(*ptr); });
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Called by Sqrat to set up an instance on the stack for the template class
+    ///
+    /// \param vm VM that has an instance object of the correct type at position 1 in its stack
+    ///
+    /// \return Squirrel error code
+    ///
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static SQInteger New(HSQUIRRELVM vm) {
+        Emplace(vm, 1, [](void* mem) { return new (mem) C(); });
+        return 0;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @cond DEV
+    /// following iNew functions are used only if constructors are bound via Ctor() in Sqrat::Class (safe to ignore)
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static SQInteger iNew(HSQUIRRELVM vm) {
+        return New(vm);
+    }
+
+    template <class... A>
+    static SQInteger iNew(HSQUIRRELVM vm) {
+        try {
+            ArgFwd<A...>{}.Call(vm, 2, [](HSQUIRRELVM vm, A... a) {
+                Emplace(vm, 1, [&](void* mem) { return new (mem) C(a...); });
+            });
+        } catch (const Poco::Exception& e) {
+            return sq_throwerror(vm, e.displayText().c_str());
+        } catch (const std::exception& e) {
+            return sq_throwerror(vm, e.what());
+        } catch (...) {
+            return sq_throwerror(vm, _SC("unknown exception occured"));
+        }
+        return 0;
+    }
+
+    /// @endcond
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Called by Sqrat to set up the instance at idx on the stack as a copy of a value of the same type
+    ///
+    /// \param vm    VM that has an instance object of the correct type at idx
+    /// \param idx   Index of the stack that the instance object is at
+    /// \param value A pointer to data of the same type as the instance object
+    ///
+    /// \return Squirrel error code
+    ///
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static SQInteger Copy(HSQUIRRELVM vm, SQInteger idx, const void* value) {
+        SetInstance(vm, idx, static_cast<const C*>(value));
+        return 0;
+    }
+
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Called by Sqrat to delete an instance's data
+    ///
+    /// \param ptr  Pointer to the data contained by the instance
+    /// \param size Size of the data contained by the instance
+    ///
+    /// \return Squirrel error code
+    ///
+    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static SQInteger Delete(SQUserPointer ptr, SQInteger size) {
+        SQUNUSED(size);
+        auto* instance = reinterpret_cast<Instance*>(ptr);
+        instance->second->erase(instance->first);
+        instance->first->~C();
+        instance->~Instance();
+        Recycle(reinterpret_cast<Block*>(ptr));
+        return 0;
+    }
+};
+
 }
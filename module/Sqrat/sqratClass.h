@@ -847,23 +847,12 @@ protected:
         // The containing environment is the root table??
         else sq_pushroottable(vm);
 
-        // Bind overload handler name
-        sq_pushstring(vm, name, -1);
-        // function name is passed as a free variable
-        //sq_pushstring(vm, name, -1);
-        sq_push(vm, -1); // <- Let's cheat(?) by pushing the same object
-        sq_newclosure(vm, &OverloadConstructionForwarder, 1);
-        // Set the closure name (for debug purposes)
-        sq_setnativeclosurename(vm, -1, name);
-        // Include it into the object
-        sq_newslot(vm, -3, false);
         // Bind overloaded function
-        sq_pushstring(vm, overloadName.c_str(), static_cast<SQInteger>(overloadName.size()));
         sq_newclosure(vm, constructor, 0);
         // Set the closure name (for debug purposes)
         sq_setnativeclosurename(vm, -1, overloadName.c_str());
-        // Include it into the object
-        sq_newslot(vm, -3, false);
+        // Include it into the overloads of the handler
+        BindOverloadForwarder(vm, name, &OverloadConstructionForwarder, nParams, false);
         // pop object/environment
         sq_pop(vm, 1);
 
@@ -112,13 +112,10 @@ struct LightObj {
     ///
     /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     explicit LightObj(const SQChar * s, SQInteger l=-1, HSQUIRRELVM v = SqVM()) {
-        sq_pushstring(v, s, l);
-        if (SQ_FAILED(sq_getstackobj(v, -1, &mObj))) {
+        // Intern and reference the string directly instead of going through the stack
+        if (s == nullptr || SQ_FAILED(sq_internstring(v, s, l, &mObj))) {
             sq_resetobject(&mObj);
-        } else {
-            sq_addref(v, &mObj);
         }
-        sq_pop(v, 1);
     }
 
     /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
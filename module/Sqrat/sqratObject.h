@@ -845,28 +845,14 @@ protected:
         SqOverloadName::Get(name, argCount, overloadName);
         // Push object/environment
         sq_pushobject(vm, GetObj());
-
-        // Bind overload handler
-        sq_pushstring(vm, name, -1);
-        // function name is passed as a free variable
-        //sq_pushstring(vm, name, -1);
-        sq_push(vm, -1); // <- Let's cheat(?) by pushing the same object
-        sq_newclosure(vm, overload, 1);
-        // Set the closure name (for debug purposes)
-        sq_setnativeclosurename(vm, -1, name);
-        // Include it into the object
-        sq_newslot(vm, -3, staticVar);
-
-        // Bind overloaded function
-        sq_pushstring(vm, overloadName.c_str(), static_cast<SQInteger>(overloadName.size()));
         // Push the native closure pointer as a free variable
         SQUserPointer methodPtr = sq_newuserdata(vm, static_cast<SQUnsignedInteger>(methodSize));
         memcpy(methodPtr, method, methodSize);
         sq_newclosure(vm, func, 1);
         // Set the closure name (for debug purposes)
         sq_setnativeclosurename(vm, -1, overloadName.c_str());
-        // Include it into the object
-        sq_newslot(vm, -3, staticVar);
+        // Include it into the overloads of the handler
+        BindOverloadForwarder(vm, name, overload, argCount, staticVar);
         // pop object/environment
         sq_pop(vm, 1);
     }
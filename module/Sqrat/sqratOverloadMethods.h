@@ -69,28 +69,17 @@ public:
 inline SQInteger OverloadExecutionForwarder(HSQUIRRELVM vm) {
     const SQInteger top = sq_gettop(vm);
     // Get the argument count
-    const int argCount = static_cast<int>(top - 2);
-    // Subtract environment and base name in free variable^
-    const SQChar* funcName;
-    SQInteger funcNameSize;
-    // Get the un-mangled function name (free variable)
-    sq_getstringandsize(vm, -1, &funcName, &funcNameSize);
-    // Generate the overload mangled name
-    string overloadName;
-    overloadName.reserve(static_cast< size_t >(funcNameSize)+5);
-    SqOverloadName::Get(funcName, argCount, overloadName);
-    // Pop the un-mangled closure name from the stack so we can replace it later
-    sq_poptop(vm); // `funcName` becomes invalid after this
-    // Push the overload mangled name on the stack
-    sq_pushstring(vm, overloadName.c_str(), static_cast<SQInteger>(overloadName.size()));
-    // Lookup the proper overload and get it on the stack
+    const SQInteger argCount = top - 2;
+    // Subtract environment and overloads in free variable^
+    // Lookup the proper overload by the number of arguments and get it on the stack
+    sq_pushinteger(vm, argCount);
 #if !defined (SCRAT_NO_ERROR_CHECKING)
-    if (SQ_FAILED(sq_get(vm, 1))) {
+    if (SQ_FAILED(sq_rawget(vm, -2)) || sq_gettype(vm, -1) != OT_NATIVECLOSURE) {
         sq_settop(vm, top); // keep the stack size intact
         return sq_throwerror(vm, _SC("wrong number of parameters"));
     }
 #else
-    sq_get(vm, 1);
+    sq_rawget(vm, -2);
 #endif
     SQFUNCTION f = nullptr;
     // Get the native closure pointer that we must invoke
@@ -105,8 +94,8 @@ inline SQInteger OverloadExecutionForwarder(HSQUIRRELVM vm) {
     sq_getonefreevariable(vm, 0);
     // This is simply a hack to implement a direct call and gain some performance
     // Since both closures expect a free variable we simply replace the free variable
-    //  containing closure name with the free variable containing the closure pointer
-    sq_settop(vm, top); // keep the stack size intact before invoking the overload
+    //  containing the overloads with the free variable containing the closure pointer
+    sq_remove(vm, -2); // keep the stack size intact before invoking the overload
     // Perform a direct call and return the result back to the caller
     return f(vm);
 }
@@ -118,26 +107,17 @@ inline SQInteger OverloadExecutionForwarder(HSQUIRRELVM vm) {
 inline SQInteger OverloadConstructionForwarder(HSQUIRRELVM vm) {
     const SQInteger top = sq_gettop(vm);
     // Get the argument count
-    const int argCount = static_cast<int>(top - 2);
-    // Subtract environment and base name in free variable^
-    const SQChar* funcName;
-    SQInteger funcNameSize;
-    // Get the un-mangled function name (free variable)
-    sq_getstringandsize(vm, -1, &funcName, &funcNameSize);
-    // Generate the overload mangled name
-    string overloadName;
-    overloadName.reserve(static_cast< size_t >(funcNameSize)+5);
-    SqOverloadName::Get(funcName, argCount, overloadName);
-    // Push the overload mangled name on the stack
-    sq_pushstring(vm, overloadName.c_str(), static_cast<SQInteger>(overloadName.size()));
-    // Lookup the proper overload and get it on the stack
+    const SQInteger argCount = top - 2;
+    // Subtract environment and overloads in free variable^
+    // Lookup the proper overload by the number of arguments and get it on the stack
+    sq_pushinteger(vm, argCount);
 #if !defined (SCRAT_NO_ERROR_CHECKING)
-    if (SQ_FAILED(sq_get(vm, 1))) {
+    if (SQ_FAILED(sq_rawget(vm, -2)) || sq_gettype(vm, -1) != OT_NATIVECLOSURE) {
         sq_settop(vm, top); // keep the stack size intact
-        return sq_throwerrorf(vm, _SC("wrong number of parameters. no such constructor overload: `%s`"), overloadName.data());
+        return sq_throwerrorf(vm, _SC("wrong number of parameters. no constructor overload takes %d arguments"), static_cast< int >(argCount));
     }
 #else
-    sq_get(vm, 1);
+    sq_rawget(vm, -2);
 #endif
     SQFUNCTION f = nullptr;
     // Get the native closure pointer that we must invoke
@@ -150,9 +130,7 @@ inline SQInteger OverloadConstructionForwarder(HSQUIRRELVM vm) {
     }
     // Restore the stack size by removing the overload closure object
     sq_poptop(vm);
-    // Pop the un-mangled closure name from the stack
     // The constructor doesn't expect any free variables
-    //sq_poptop(vm); // `funcName` becomes invalid after this
     // Perform a direct call and store the result
     SQRESULT r = f(vm);
     // Keep the stack size intact before leaving
@@ -161,6 +139,49 @@ inline SQInteger OverloadConstructionForwarder(HSQUIRRELVM vm) {
     return r;
 }
 
+//
+// Register an overload closure with the forwarder bound under the specified name. Expects the
+//  object/environment and the overload closure on the stack and leaves only the object/environment.
+//  The forwarder receives an array of overloads indexed by their number of arguments as free variable.
+//
+inline void BindOverloadForwarder(HSQUIRRELVM vm, const SQChar* name, SQFUNCTION forwarder, SQInteger argCount, bool staticVar) {
+    const SQInteger top = sq_gettop(vm);
+    // Look for the overloads that were already bound under this name
+    sq_pushstring(vm, name, -1);
+    if (SQ_SUCCEEDED(sq_rawget(vm, -3)) && sq_gettype(vm, -1) == OT_NATIVECLOSURE) {
+        sq_getonefreevariable(vm, 0); // replace the forwarder with its free variable
+    }
+    if (sq_gettop(vm) > top && sq_gettype(vm, -1) == OT_ARRAY) {
+        // Work on a copy since the forwarder could have been inherited from a base class
+        sq_clone(vm, -1);
+        sq_remove(vm, -2);
+    } else {
+        sq_settop(vm, top);
+        sq_newarray(vm, 0);
+    }
+    // Make room for this number of arguments
+    if (sq_getsize(vm, -1) <= argCount) {
+        sq_arrayresize(vm, -1, argCount + 1);
+    }
+    // Store the overload closure in the array
+    sq_pushinteger(vm, argCount);
+    sq_push(vm, -3);
+    sq_rawset(vm, -3);
+    // Remove the overload closure from the stack
+    sq_remove(vm, -2);
+    // Bind overload handler
+    sq_pushstring(vm, name, -1);
+    // overloads are passed as a free variable
+    sq_push(vm, -2);
+    sq_newclosure(vm, forwarder, 1);
+    // Set the closure name (for debug purposes)
+    sq_setnativeclosurename(vm, -1, name);
+    // Include it into the object
+    sq_newslot(vm, -4, staticVar);
+    // Pop the overloads
+    sq_poptop(vm);
+}
+
 //
 // Squirrel Overload Functions
 //